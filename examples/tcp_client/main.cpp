@@ -2,9 +2,9 @@
 #include <chrono>
 #include <appfw/appfw.h>
 #include <appfw/init.h>
-#include <appfw/network/tcp_client4.h>
+#include <appfw/network/tcp_client.h>
 
-appfw::TcpClient4 g_Client;
+appfw::TcpClient g_Client;
 std::string g_LastHost;
 std::string g_LastPort;
 
@@ -28,14 +28,14 @@ ConCommand cmd_connect("connect", "Connects to a host", [](const CmdString &args
         g_LastPort = args[2];
 
         printi("Resolving {}:{}...", args[1], args[2]);
-        auto list = appfw::resolveHostName(args[1], args[2]);
+        auto list = appfw::resolveHostName(std::string(args[1]), std::string(args[2]));
 
         if (list.empty()) {
             printe("Failed to resolve the hostname");
             return;
         }
 
-        appfw::SockAddr4 addr = *list.begin();
+        appfw::SockAddr addr = *list.begin();
         printi("Connecting to {}", addr.toString());
         g_Client.connect(addr, timeout.getValue());
 
@@ -78,24 +78,27 @@ ConCommand cmd_send("send", "Sends a message to a client", [](const CmdString &a
 });
 
 void onReadyRead() {
-    std::vector<uint8_t> buf(2048);
-    int size = 0;
     try {
-        size = g_Client.read(buf);
+        g_Client.receive();
     } catch (const appfw::NetworkErrorException &e) {
         printe("Failed to read message: {}", e.what());
         return;
     }
 
-    if (size == 0) {
+    appfw::RecvRingBuffer &buf = g_Client.getRecvBuffer();
+
+    if (!buf.empty()) {
+        appfw::RecvRingBuffer::ReadView view = buf.readable();
+        printn("Data received [size = {}]", view.size());
+        printi("{}{}", std::string_view((const char *)view.first.data(), view.first.size()),
+               std::string_view((const char *)view.second.data(), view.second.size()));
+        buf.consume(view.size());
+    }
+
+    if (g_Client.getStatus() == appfw::NetClientStatus::Closed) {
         // EOF
-        g_Client.close();
         printn("Connection closed from the other side");
-        return;
     }
-
-    printn("Data received [size = {}]", size);
-    printi("{}", std::string_view((char *)buf.data(), size));
 }
 
 int main(int argc, char **argv) {
@@ -2,7 +2,7 @@
 #include <chrono>
 #include <appfw/appfw.h>
 #include <appfw/init.h>
-#include <appfw/network/tcp_server4.h>
+#include <appfw/network/tcp_server.h>
 
 int g_iNextId = 1;
 
@@ -10,7 +10,7 @@ struct ClientData {
     int id = g_iNextId++;
 };
 
-appfw::TcpServer4 g_Server;
+appfw::TcpServer g_Server;
 
 ConVar<bool> run_app("run_app", true, "Whether or not the app should be running");
 ConCommand cmd_quit("quit", "Quits the app", []() { run_app.setValue(false); });
@@ -19,7 +19,7 @@ ConCommand cmd_clients("clients", "Lists connected clients", []() {
     size_t count = g_Server.getConnectedClients();
 
     for (size_t i = 0; i < count; i++) {
-        appfw::TcpClientSocket4Ptr socket = g_Server.getSocket(i);
+        appfw::TcpClientSocketPtr socket = g_Server.getSocket(i);
         auto *data = static_cast<ClientData *>(socket->getUserData());
         printi("{}. {}, id = {}", i + 1, socket->getRemoteAddress().toString(), data->id);
     }
@@ -36,13 +36,13 @@ ConCommand cmd_send("send", "Sends a message to a client", [](const CmdString &a
     }
 
     int id = 0;
-    if (!appfw::convertStringToVal(args[1], id)) {
+    if (!appfw::convertStringToVal(std::string(args[1]), id)) {
         printe("Invalid id");
         return;
     }
 
     for (size_t i = 0; i < count; i++) {
-        appfw::TcpClientSocket4Ptr socket = g_Server.getSocket(i);
+        appfw::TcpClientSocketPtr socket = g_Server.getSocket(i);
         auto *data = static_cast<ClientData *>(socket->getUserData());
         
         if (data->id == id) {
@@ -70,13 +70,13 @@ ConCommand cmd_kick("kick", "Kicks a client", [](const CmdString &args) {
     }
 
     int id = 0;
-    if (!appfw::convertStringToVal(args[1], id)) {
+    if (!appfw::convertStringToVal(std::string(args[1]), id)) {
         printe("Invalid id");
         return;
     }
 
     for (size_t i = 0; i < count; i++) {
-        appfw::TcpClientSocket4Ptr socket = g_Server.getSocket(i);
+        appfw::TcpClientSocketPtr socket = g_Server.getSocket(i);
         auto *data = static_cast<ClientData *>(socket->getUserData());
 
         if (data->id == id) {
@@ -88,13 +88,13 @@ ConCommand cmd_kick("kick", "Kicks a client", [](const CmdString &args) {
     printe("ID not found");
 });
 
-void onConnAccepted(size_t index, appfw::TcpClientSocket4Ptr socket) noexcept {
+void onConnAccepted(size_t index, appfw::TcpClientSocketPtr socket) noexcept {
     ClientData *data = new ClientData();
     socket->setUserData(data);
     printw("Client connected: {}, id {}", socket->getRemoteAddress().toString(), data->id);
 }
 
-void onConnClosed(size_t index, appfw::TcpClientSocket4Ptr socket,
+void onConnClosed(size_t index, appfw::TcpClientSocketPtr socket,
                   appfw::SocketCloseReason reason) noexcept {
     auto *data = static_cast<ClientData *>(socket->getUserData());
     printw("Client disconnected: {}, id {}", socket->getRemoteAddress().toString(), data->id);
@@ -115,6 +115,9 @@ void onConnClosed(size_t index, appfw::TcpClientSocket4Ptr socket,
     case appfw::SocketCloseReason::Shutdown:
         printw("Reason: server is going down");
         break;
+    case appfw::SocketCloseReason::InvalidData:
+        printw("Reason: invalid data");
+        break;
     default:
         printw("Reason: unknown {}", (int)reason);
     }
@@ -123,32 +126,34 @@ void onConnClosed(size_t index, appfw::TcpClientSocket4Ptr socket,
     socket->setUserData(nullptr);
 }
 
-void onReadyRead(size_t index, appfw::TcpClientSocket4Ptr socket) noexcept {
-    std::vector<uint8_t> buf(2048);
-    int size = 0;
-
+void onReadyRead(size_t index, appfw::TcpClientSocketPtr socket) noexcept {
     try {
-        size = socket->read(buf);
+        socket->receive();
     } catch (const appfw::NetworkErrorException &e) {
         printe("Failed to read message from client {}: {}",
                socket->getRemoteAddress().toString() , e.what());
         return;
     }
 
-    if (size == 0) {
-        // EOF
-        socket->close(appfw::SocketCloseReason::ConnAborted);
+    appfw::RecvRingBuffer &buf = socket->getRecvBuffer();
+
+    if (buf.empty()) {
+        // EOF, socket was closed by receive()
         return;
     }
 
     auto *data = static_cast<ClientData *>(socket->getUserData());
-    printn("{} [{}] [size = {}]", socket->getRemoteAddress().toString(), data->id, size);
-    std::string_view str = std::string_view((char *)buf.data(), size);
+    printn("{} [{}] [size = {}]", socket->getRemoteAddress().toString(), data->id, buf.size());
+
+    appfw::RecvRingBuffer::ReadView view = buf.readable();
+    std::string str = std::string((const char *)view.first.data(), view.first.size()) +
+                      std::string((const char *)view.second.data(), view.second.size());
+    buf.consume(view.size());
     printi("{}", str);
 
     try {
         // Echo back
-        std::string echo = "Echo: " + std::string(str);
+        std::string echo = "Echo: " + str;
         socket->writeAll(appfw::span((uint8_t *)echo.data(), echo.size()));
     } catch (const appfw::NetworkErrorException &e) {
         printe("Failed to send back response: {}", e.what());
@@ -160,14 +165,22 @@ int main(int argc, char **argv) {
     printn("TCP Server Example");
 
     if (getCommandLine().isFlagSet("--help")) {
-        printi("Usage: {} [--port port]", getCommandLine().getCommandName());
+        printi("Usage: {} [--port port] [--ipv6]", getCommandLine().getCommandName());
         return -1;
     }
 
     g_Server.setConnAcceptedCallback(onConnAccepted);
     g_Server.setConnClosedCallback(onConnClosed);
     g_Server.setReadyReadCallback(onReadyRead);
-    g_Server.startListening(appfw::ADDR4_ANY, getCommandLine().getArgInt("--port", 27015));
+    uint16_t port = (uint16_t)getCommandLine().getArgInt("--port", 27015);
+
+    if (getCommandLine().isFlagSet("--ipv6")) {
+        // Dual-stack, accepts IPv4 clients as well
+        g_Server.startListening(appfw::SockAddr(appfw::ADDR6_ANY, port));
+    } else {
+        g_Server.startListening(appfw::ADDR4_ANY, port);
+    }
+
     printi("Big Brother is listening at {}", g_Server.getListenAddress().toString());
 
     printi("Type 'clients' for the list of connected clients");
@@ -1,6 +1,7 @@
 #ifndef APPFW_APPFW_H
 #define APPFW_APPFW_H
 #include <fmt/format.h>
+#include <appfw/console/con_msg_filter.h>
 #include <appfw/console/console_system.h>
 #include <appfw/command_line.h>
 #include <appfw/compiler.h>
@@ -51,112 +52,149 @@ inline const appfw::ModuleInfo &getModuleInfo() {
 //----------------------------------------------------------------
 // Console output
 //----------------------------------------------------------------
+//! Filters messages of this module. Level is set with <module>_con_min_level cvar.
+inline appfw::ConMsgFilter s_ConMsgFilter(MODULE_NAME, MODULE_NAME "_con_min_level");
+
 inline void vConPrint(appfw::ConMsgInfo info, std::string_view format, fmt::format_args args) {
+    if (!s_ConMsgFilter.isEnabled(info.type)) {
+        return;
+    }
+
     info.setTag(MODULE_NAME);
     appfw::getConsole().print(info, fmt::vformat(format, args));
 }
 
+/**
+ * Prints a message. Filtered messages are dropped before anything else is done.
+ * Arithmetic arguments are captured instead of formatted if deferred formatting is enabled.
+ */
+template <typename... Args>
+inline void conPrint(ConMsgType type, ConMsgColor color, std::string_view format,
+                     const Args &...args) {
+    if (!s_ConMsgFilter.isEnabled(type)) {
+        return;
+    }
+
+    appfw::ConMsgInfo info;
+    info.setType(type).setColor(color).setTag(MODULE_NAME);
+    appfw::ConsoleSystem &con = appfw::getConsole();
+
+    if constexpr (appfw::ConDeferredMsg::canCapture<Args...>()) {
+        if (con.isDeferredFormatting()) {
+            appfw::ConDeferredMsg msg;
+
+            if (msg.capture(format, args...)) {
+                con.print(info, std::move(msg));
+                return;
+            }
+        }
+    }
+
+    con.print(info, fmt::vformat(format, fmt::make_format_args(args...)));
+}
+
+/**
+ * Prints a message of a type known at compile time.
+ * Removed if the type is less severe than APPFW_CON_MIN_LEVEL.
+ */
+template <ConMsgType type, typename... Args>
+inline void conPrintAs(ConMsgColor color, std::string_view format, const Args &...args) {
+    if constexpr (appfw::isConMsgTypeCompiled(type)) {
+        conPrint(type, color, format, args...);
+    }
+}
+
 // WTF
 template <typename... Args>
 inline void printwtf(std::string_view format, const Args &...args) {
-    vConPrint(appfw::ConMsgInfo().setType(ConMsgType::WTF), format, fmt::make_format_args(args...));
+    conPrintAs<ConMsgType::WTF>(ConMsgColor::Default, format, args...);
 }
 
 template <typename... Args>
 inline void printwtf(ConMsgColor color, std::string_view format, const Args &...args) {
-    vConPrint(appfw::ConMsgInfo().setType(ConMsgType::WTF).setColor(color), format,
-              fmt::make_format_args(args...));
+    conPrintAs<ConMsgType::WTF>(color, format, args...);
 }
 
 // Fatal
 template <typename... Args>
 inline void printfatal(std::string_view format, const Args &...args) {
-    vConPrint(appfw::ConMsgInfo().setType(ConMsgType::Fatal), format,
-              fmt::make_format_args(args...));
+    conPrintAs<ConMsgType::Fatal>(ConMsgColor::Default, format, args...);
 }
 
 template <typename... Args>
 inline void printfatal(ConMsgColor color, std::string_view format, const Args &...args) {
-    vConPrint(appfw::ConMsgInfo().setType(ConMsgType::Fatal).setColor(color), format,
-              fmt::make_format_args(args...));
+    conPrintAs<ConMsgType::Fatal>(color, format, args...);
 }
 
 // Error
 template <typename... Args>
 inline void printe(std::string_view format, const Args &...args) {
-    vConPrint(appfw::ConMsgInfo().setType(ConMsgType::Error), format,
-              fmt::make_format_args(args...));
+    conPrintAs<ConMsgType::Error>(ConMsgColor::Default, format, args...);
 }
 
 template <typename... Args>
 inline void printe(ConMsgColor color, std::string_view format, const Args &...args) {
-    vConPrint(appfw::ConMsgInfo().setType(ConMsgType::Error).setColor(color), format,
-              fmt::make_format_args(args...));
+    conPrintAs<ConMsgType::Error>(color, format, args...);
 }
 
 // Warning
 template <typename... Args>
 inline void printw(std::string_view format, const Args &...args) {
-    vConPrint(appfw::ConMsgInfo().setType(ConMsgType::Warn), format,
-              fmt::make_format_args(args...));
+    conPrintAs<ConMsgType::Warn>(ConMsgColor::Default, format, args...);
 }
 
 template <typename... Args>
 inline void printw(ConMsgColor color, std::string_view format, const Args &...args) {
-    vConPrint(appfw::ConMsgInfo().setType(ConMsgType::Warn).setColor(color), format,
-              fmt::make_format_args(args...));
+    conPrintAs<ConMsgType::Warn>(color, format, args...);
 }
 
 // Notice
 template <typename... Args>
 inline void printn(std::string_view format, const Args &...args) {
-    vConPrint(appfw::ConMsgInfo().setType(ConMsgType::Notice), format,
-              fmt::make_format_args(args...));
+    conPrintAs<ConMsgType::Notice>(ConMsgColor::Default, format, args...);
 }
 
 template <typename... Args>
 inline void printn(ConMsgColor color, std::string_view format, const Args &...args) {
-    vConPrint(appfw::ConMsgInfo().setType(ConMsgType::Notice).setColor(color), format,
-              fmt::make_format_args(args...));
+    conPrintAs<ConMsgType::Notice>(color, format, args...);
 }
 
 // Info
 template <typename... Args>
 inline void printi(std::string_view format, const Args &...args) {
-    vConPrint(appfw::ConMsgInfo().setType(ConMsgType::Info), format,
-              fmt::make_format_args(args...));
+    conPrintAs<ConMsgType::Info>(ConMsgColor::Default, format, args...);
 }
 
 template <typename... Args>
 inline void printi(ConMsgColor color, std::string_view format, const Args &...args) {
-    vConPrint(appfw::ConMsgInfo().setType(ConMsgType::Info).setColor(color), format,
-              fmt::make_format_args(args...));
+    conPrintAs<ConMsgType::Info>(color, format, args...);
 }
 
 // Debug
 template <typename... Args>
 inline void printd(std::string_view format, const Args &...args) {
-    vConPrint(appfw::ConMsgInfo().setType(ConMsgType::Debug), format,
-              fmt::make_format_args(args...));
+    conPrintAs<ConMsgType::Debug>(ConMsgColor::Default, format, args...);
 }
 
 template <typename... Args>
 inline void printd(ConMsgColor color, std::string_view format, const Args &...args) {
-    vConPrint(appfw::ConMsgInfo().setType(ConMsgType::Debug).setColor(color), format,
-              fmt::make_format_args(args...));
+    conPrintAs<ConMsgType::Debug>(color, format, args...);
 }
 
 // Variable type
 template <typename... Args>
 inline void printtype(ConMsgType type, std::string_view format, const Args &...args) {
-    vConPrint(appfw::ConMsgInfo().setType(type), format, fmt::make_format_args(args...));
+    if (appfw::isConMsgTypeCompiled(type)) {
+        conPrint(type, ConMsgColor::Default, format, args...);
+    }
 }
 
 template <typename... Args>
 inline void printtype(ConMsgType type, ConMsgColor color, std::string_view format,
                       const Args &...args) {
-    vConPrint(appfw::ConMsgInfo().setType(type).setColor(color), format,
-              fmt::make_format_args(args...));
+    if (appfw::isConMsgTypeCompiled(type)) {
+        conPrint(type, color, format, args...);
+    }
 }
 
 } // namespace MODULE_NAMESPACE
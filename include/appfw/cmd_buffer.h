@@ -22,15 +22,20 @@ public:
     CmdBuffer(const CommandHandler &handler);
 
     /**
-     * Parses `cmd` and adds it to the bottom of the queue.
+     * Parses `cmd` and moves the commands to the bottom of the queue.
      */
-    void append(const std::string &cmd);
+    void append(std::string_view cmd);
 
     /**
      * Adds `cmd` to the bottom of the queue.
      */
     void append(const CmdString &cmd);
 
+    /**
+     * Moves `cmd` to the bottom of the queue.
+     */
+    void append(CmdString &&cmd);
+
     /**
      * Adds `cmds` to the bottom of the queue.
      */
@@ -1,33 +1,108 @@
 #ifndef APPFW_CMD_STRING_H
 #define APPFW_CMD_STRING_H
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
 #include <vector>
 #include <string>
 #include <string_view>
 
 namespace appfw {
 
+/**
+ * A parsed command: a list of arguments.
+ * Arguments are stored back to back in a single string and returned as views into it.
+ * Positions of the first INLINE_ARG_COUNT arguments are stored inline
+ * so parsing a typical command allocates at most once (not at all for short commands).
+ */
 class CmdString {
 public:
+    //! Number of arguments stored without a heap allocation
+    static constexpr size_t INLINE_ARG_COUNT = 6;
+
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view *;
+        using reference = std::string_view;
+
+        Iterator(const CmdString *pCmd, size_t idx)
+            : m_pCmd(pCmd)
+            , m_uIdx(idx) {}
+
+        inline std::string_view operator*() const { return (*m_pCmd)[m_uIdx]; }
+        inline Iterator &operator++() { m_uIdx++; return *this; }
+        inline Iterator operator++(int) { Iterator it = *this; m_uIdx++; return it; }
+        inline bool operator==(const Iterator &rhs) const { return m_uIdx == rhs.m_uIdx; }
+        inline bool operator!=(const Iterator &rhs) const { return m_uIdx != rhs.m_uIdx; }
+
+    private:
+        const CmdString *m_pCmd;
+        size_t m_uIdx;
+    };
+
     CmdString() = default;
     CmdString(const std::string *itbeg, const std::string *itend);
+    CmdString(std::initializer_list<std::string_view> args);
+
+    inline size_t size() const { return m_uArgCount; }
+    inline bool empty() const { return m_uArgCount == 0; }
+    inline Iterator begin() const { return Iterator(this, 0); }
+    inline Iterator end() const { return Iterator(this, m_uArgCount); }
 
-    inline auto size() const { return m_Args.size(); }
-    inline auto empty() const { return m_Args.empty(); }
-    inline auto begin() const { return m_Args.begin(); }
-    inline auto begin() { return m_Args.begin(); }
-    inline auto end() const { return m_Args.end(); }
-    inline auto end() { return m_Args.end(); }
-    inline auto &operator[](size_t idx) const { return m_Args[idx]; }
-    inline auto &operator[](size_t idx) { return m_Args[idx]; }
-    inline const std::vector<std::string> &getArgs() const { return m_Args; }
+    /**
+     * Returns an argument. The view is valid until the command is modified or destroyed.
+     */
+    inline std::string_view operator[](size_t idx) const {
+        const ArgRange &arg = idx < INLINE_ARG_COUNT ? m_InlineArgs[idx]
+                                                     : m_ExtraArgs[idx - INLINE_ARG_COUNT];
+        return std::string_view(m_Buffer.data() + arg.uOffset, arg.uLength);
+    }
+
+    /**
+     * Returns a copy of the arguments as strings.
+     */
+    std::vector<std::string> getArgs() const;
+
+    /**
+     * Adds an argument to the end.
+     */
+    void addArg(std::string_view arg);
+
+    /**
+     * Removes all arguments. Keeps allocated memory.
+     */
+    void clear();
 
     std::string toString() const;
 
+    /**
+     * Parses a string of commands separated by ';' or new lines
+     * and calls `fn` for each non-empty command.
+     * The same CmdString object is refilled for every command, `fn` may move it out.
+     */
+    static void parse(std::string_view str, const std::function<void(CmdString &cmd)> &fn);
+
+    /**
+     * Parses a string of commands into a list.
+     */
     static std::vector<CmdString> parse(std::string_view str);
+
     static std::string toString(const std::vector<CmdString> &arr);
 
 private:
-    std::vector<std::string> m_Args;
+    struct ArgRange {
+        uint32_t uOffset;
+        uint32_t uLength;
+    };
+
+    std::string m_Buffer;
+    size_t m_uArgCount = 0;
+    ArgRange m_InlineArgs[INLINE_ARG_COUNT] = {};
+    std::vector<ArgRange> m_ExtraArgs;
 };
 
 } // namespace appfw
@@ -0,0 +1,166 @@
+#ifndef APPFW_CONSOLE_BINARY_LOG_H
+#define APPFW_CONSOLE_BINARY_LOG_H
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <appfw/console/console_system.h>
+#include <appfw/filesystem.h>
+#include <appfw/utils.h>
+
+namespace appfw {
+
+class MappedFile;
+
+//----------------------------------------------------------------
+// File format
+//
+// A file starts with BinaryLogFileHeader followed by records.
+// Each record is BinaryLogRecordHeader, the tag and the text.
+// A record with zero size or the end of the file ends the list.
+// Values are in native byte order (little-endian on supported platforms).
+//----------------------------------------------------------------
+
+//! Magic at the start of a binary log file
+constexpr char BINARY_LOG_MAGIC[8] = {'A', 'F', 'W', 'B', 'L', 'O', 'G', '\0'};
+
+//! Version of the format
+constexpr uint32_t BINARY_LOG_VERSION = 1;
+
+//! Extension of binary log files
+constexpr char BINARY_LOG_EXTENSION[] = ".blog";
+
+struct BinaryLogFileHeader {
+    char magic[8];
+    uint32_t uVersion;
+    uint32_t uHeaderSize;  //!< Offset of the first record
+    int64_t iCreateTime;   //!< Unix time when the file was created
+    uint64_t uSegmentIdx;  //!< Number of the file since the sink was created
+};
+
+struct BinaryLogRecordHeader {
+    uint32_t uSize; //!< Size of the record including the header
+    uint8_t uType;
+    uint8_t uColor;
+    uint16_t uTagLength;
+    int64_t iTime;
+};
+
+static_assert(sizeof(BinaryLogFileHeader) == 32);
+static_assert(sizeof(BinaryLogRecordHeader) == 16);
+
+//----------------------------------------------------------------
+
+/**
+ * Console receiver that writes messages into binary log files.
+ * Files (segments) are created with full size and memory-mapped so a message is a memcpy.
+ * A new segment is started when the current one is full or too old.
+ * The last segment is truncated to its contents when it is closed.
+ *
+ * Segments are named "<prefix>_<local date>_<local time>_<idx>.blog" and placed in a directory
+ * of the FileSystem. Decode them with appfw_binlog_decode or BinaryLogReader.
+ */
+class BinaryLogSink : public IConsoleReceiver, NoMove {
+public:
+    struct Options {
+        //! Virtual path of the directory (e.g. "logs:" or "logs:server")
+        std::string dir;
+
+        //! Start of the file names
+        std::string prefix = "log";
+
+        //! Size of a segment in bytes
+        size_t segmentSize = 16 * 1024 * 1024;
+
+        //! Maximum time since creation of a segment. Zero to disable.
+        std::chrono::seconds maxSegmentAge = std::chrono::hours(1);
+
+        //! Maximum number of segments in the directory, older ones are removed. Zero to keep all.
+        size_t maxSegments = 0;
+    };
+
+    /**
+     * Creates the first segment.
+     * Throws if the directory is not valid or the file can't be created.
+     */
+    BinaryLogSink(FileSystem &fileSystem, const Options &options);
+    ~BinaryLogSink();
+
+    /**
+     * @return whether the sink writes messages. It stops after it fails to create a segment.
+     */
+    inline bool isOpen() { return m_pFile != nullptr; }
+
+    /**
+     * @return path to the current segment
+     */
+    inline const fs::path &getSegmentPath() { return m_SegmentPath; }
+
+    /**
+     * Closes the current segment and starts a new one.
+     * Throws if the file can't be created.
+     */
+    void rotate();
+
+    // IConsoleReceiver
+    void onAdd(ConsoleSystem *pConSys) override;
+    void onRemove(ConsoleSystem *pConSys) override;
+    void print(const ConMsgInfo &info, std::string_view msg) override;
+    bool isThreadSafe() override;
+
+private:
+    FileSystem &m_FileSystem;
+    Options m_Options;
+    std::unique_ptr<MappedFile> m_pFile;
+    fs::path m_SegmentPath;
+    size_t m_uOffset = 0;
+    uint64_t m_uSegmentIdx = 0;
+    time_t m_SegmentTime = 0;
+
+    void openSegment();
+    void closeSegment();
+    void removeOldSegments();
+    std::string getVirtualPath(std::string_view fileName);
+};
+
+//----------------------------------------------------------------
+
+/**
+ * Reads records of a binary log file.
+ */
+class BinaryLogReader : NoMove {
+public:
+    struct Record {
+        ConMsgType type;
+        ConMsgColor color;
+        time_t time;
+        std::string_view tag;
+        std::string_view text;
+    };
+
+    /**
+     * Reads the file. Throws if it can't be read or has an invalid header.
+     */
+    explicit BinaryLogReader(const fs::path &path);
+
+    /**
+     * @return header of the file
+     */
+    inline const BinaryLogFileHeader &getHeader() const { return m_Header; }
+
+    /**
+     * Reads the next record. Views are valid while the reader exists.
+     * @return false at the end of the file
+     */
+    bool readRecord(Record &record);
+
+private:
+    std::vector<uint8_t> m_Data;
+    BinaryLogFileHeader m_Header = {};
+    size_t m_uOffset = 0;
+};
+
+} // namespace appfw
+
+#endif
@@ -0,0 +1,128 @@
+#ifndef APPFW_CONSOLE_CON_DEFERRED_MSG_H
+#define APPFW_CONSOLE_CON_DEFERRED_MSG_H
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <fmt/format.h>
+
+namespace appfw {
+
+/**
+ * A console message with its arguments captured to be formatted later by the thread
+ * that prints it. Capturing is a copy of the arguments and the format string without
+ * any allocations.
+ *
+ * Only arithmetic arguments are captured since pointers and strings may not outlive the call.
+ */
+class ConDeferredMsg {
+public:
+    //! Maximum size of the arguments and the format string
+    static constexpr size_t MAX_DATA_SIZE = 128;
+
+    ConDeferredMsg() = default;
+
+    //! Copies only the used part of the buffer
+    inline ConDeferredMsg(const ConDeferredMsg &other) { *this = other; }
+
+    inline ConDeferredMsg &operator=(const ConDeferredMsg &other) {
+        m_pfnFormat = other.m_pfnFormat;
+        m_uSize = other.m_uSize;
+        std::memcpy(m_Data, other.m_Data, m_uSize);
+        return *this;
+    }
+
+    /**
+     * @return whether arguments of these types can be captured
+     */
+    template <typename... Args>
+    static constexpr bool canCapture() {
+        return (std::is_arithmetic_v<Args> && ...) && getArgsSize<Args...>() <= MAX_DATA_SIZE;
+    }
+
+    /**
+     * Captures the format string and the arguments.
+     * @return  false if they don't fit
+     */
+    template <typename... Args>
+    bool capture(std::string_view format, const Args &...args);
+
+    /**
+     * @return whether nothing was captured
+     */
+    inline bool isEmpty() const { return m_pfnFormat == nullptr; }
+
+    /**
+     * Formats the message. Throws fmt::format_error if the format string is invalid.
+     */
+    inline std::string format() const { return m_pfnFormat(m_Data, m_uSize); }
+
+private:
+    using FormatFn = std::string (*)(const uint8_t *data, size_t size);
+
+    FormatFn m_pfnFormat = nullptr;
+    uint16_t m_uSize = 0;
+    alignas(std::max_align_t) uint8_t m_Data[MAX_DATA_SIZE];
+
+    static constexpr size_t alignUp(size_t offset, size_t align) {
+        return (offset + align - 1) & ~(align - 1);
+    }
+
+    //! @returns size of arguments stored one after another with their alignment
+    template <typename... Args>
+    static constexpr size_t getArgsSize() {
+        size_t offset = 0;
+        ((offset = alignUp(offset, alignof(Args)) + sizeof(Args)), ...);
+        return offset;
+    }
+
+    template <typename T>
+    static inline T readArg(const uint8_t *data, size_t &offset) {
+        T value;
+        offset = alignUp(offset, alignof(T));
+        std::memcpy(&value, data + offset, sizeof(T));
+        offset += sizeof(T);
+        return value;
+    }
+
+    //! Format string is stored after the arguments
+    template <typename... Args>
+    static std::string formatArgs(const uint8_t *data, size_t size) {
+        constexpr size_t argsSize = getArgsSize<Args...>();
+        std::string_view format(reinterpret_cast<const char *>(data) + argsSize, size - argsSize);
+
+        // Braced init list is evaluated left to right
+        [[maybe_unused]] size_t offset = 0;
+        std::tuple<Args...> args{readArg<Args>(data, offset)...};
+
+        return std::apply(
+            [&](const auto &...a) { return fmt::vformat(format, fmt::make_format_args(a...)); },
+            args);
+    }
+};
+
+template <typename... Args>
+inline bool ConDeferredMsg::capture(std::string_view format, const Args &...args) {
+    static_assert(canCapture<Args...>(), "Arguments can't be captured");
+    constexpr size_t argsSize = getArgsSize<Args...>();
+
+    if (argsSize + format.size() > MAX_DATA_SIZE) {
+        return false;
+    }
+
+    [[maybe_unused]] size_t offset = 0;
+    ((offset = alignUp(offset, alignof(Args)), std::memcpy(m_Data + offset, &args, sizeof(Args)),
+      offset += sizeof(Args)),
+     ...);
+
+    std::memcpy(m_Data + argsSize, format.data(), format.size());
+    m_uSize = (uint16_t)(argsSize + format.size());
+    m_pfnFormat = &formatArgs<Args...>;
+    return true;
+}
+
+} // namespace appfw
+
+#endif
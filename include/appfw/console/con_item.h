@@ -1,9 +1,12 @@
 #ifndef APPFW_CONSOLE_CON_ITEM_H
 #define APPFW_CONSOLE_CON_ITEM_H
+#include <atomic>
 #include <set>
 #include <functional>
+#include <memory>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include <appfw/cmd_string.h>
 #include <appfw/utils.h>
@@ -79,7 +82,10 @@ private:
  */
 class ConVarBase : public ConItemBase {
 public:
+    using ChangeHandler = std::function<void(ConVarBase &cvar)>;
+
     using ConItemBase::ConItemBase;
+    ~ConVarBase();
 
     /**
      * Returns whether cvar is locked or not.
@@ -108,14 +114,97 @@ public:
      */
     virtual const char *getVarTypeAsString() = 0;
 
+    /**
+     * Adds a handler called when the value changes.
+     * Changes are collected and delivered once per tick from notifySubscribers,
+     * so a cvar changed many times in a tick calls each handler once.
+     * The cvar must not be destroyed from a handler.
+     * @return ID of the subscription
+     */
+    uint64_t subscribe(const ChangeHandler &handler);
+
+    /**
+     * Removes a handler added by subscribe.
+     */
+    void unsubscribe(uint64_t id);
+
+    /**
+     * Calls handlers of cvars changed since the last call. Called by mainLoopTick.
+     * Changes made by handlers are delivered on the next call.
+     */
+    static void notifySubscribers();
+
     virtual ConItemType getType() override;
 
+protected:
+    /**
+     * Adds the cvar to the list of changed cvars if it has subscribers.
+     */
+    void markChanged();
+
 private:
     bool m_bIsLocked = false;
+    bool m_bIsChanged = false;
+    uint64_t m_uNextSubscriberId = 1;
+    std::vector<std::pair<uint64_t, ChangeHandler>> m_Subscribers;
+
+    /**
+     * Returns a reference to the list of changed cvars.
+     */
+    static std::vector<ConVarBase *> &getChangedCvars();
+
+    /**
+     * Returns a reference to the list of cvars being delivered by notifySubscribers.
+     */
+    static std::vector<ConVarBase *> &getNotifiedCvars();
 };
 
 //----------------------------------------------------------------
 
+namespace detail::convar {
+
+/**
+ * Copy of a cvar value that can be read from any thread.
+ * Trivially copyable values are stored in an atomic.
+ */
+template <typename T>
+class SharedValue {
+public:
+    static_assert(std::atomic<T>::is_always_lock_free, "cvar type must be lock-free atomic");
+    using ReadType = T;
+
+    inline ReadType load() const { return m_Value.load(std::memory_order_relaxed); }
+    inline void store(const T &value) { m_Value.store(value, std::memory_order_release); }
+
+private:
+    std::atomic<T> m_Value = T();
+};
+
+/**
+ * Strings are immutable copies swapped by pointer (RCU-style).
+ * Readers hold a reference so an old copy is freed after the last reader releases it.
+ * Atomic shared_ptr access isn't lock-free in libstdc++ and libc++.
+ */
+template <>
+class SharedValue<std::string> {
+public:
+    using ReadType = std::shared_ptr<const std::string>;
+
+    inline ReadType load() const {
+        return std::atomic_load_explicit(&m_pValue, std::memory_order_acquire);
+    }
+
+    inline void store(const std::string &value) {
+        std::atomic_store_explicit(&m_pValue, std::make_shared<const std::string>(value),
+                                   std::memory_order_release);
+    }
+
+private:
+    std::shared_ptr<const std::string> m_pValue = std::make_shared<const std::string>();
+};
+
+} // namespace detail::convar
+
 template <typename T>
 class ConVar : public ConVarBase {
 public:
@@ -125,12 +214,22 @@ public:
            Callback cb = Callback());
 
     /**
-     * Returns value of the convar.
+     * Returns value of the convar. Must only be called from the main thread.
      */
     const T &getValue();
 
     /**
-     * Sets a new value of the cvar.
+     * Returns value of the convar. Thread-safe, lock-free for arithmetic types.
+     * The value may lag behind setValue on the main thread.
+     * String cvars return a shared pointer to an immutable copy. Loading the pointer
+     * takes a short internal lock of the standard library (atomic shared_ptr access).
+     */
+    inline typename detail::convar::SharedValue<T>::ReadType getValueRelaxed() const {
+        return m_SharedValue.load();
+    }
+
+    /**
+     * Sets a new value of the cvar. Must only be called from the main thread.
      * @return Whether or nos new value was applied.
      */
     VarSetResult setValue(const T &newVal);
@@ -145,7 +244,8 @@ public:
     virtual const char *getVarTypeAsString() override;
 
 private:
-    T m_Value;
+    T m_Value = T();
+    detail::convar::SharedValue<T> m_SharedValue;
     Callback m_Callback;
 };
 
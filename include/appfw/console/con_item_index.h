@@ -0,0 +1,72 @@
+#ifndef APPFW_CONSOLE_CON_ITEM_INDEX_H
+#define APPFW_CONSOLE_CON_ITEM_INDEX_H
+#include <string_view>
+#include <vector>
+#include <appfw/console/con_item.h>
+#include <appfw/utils.h>
+
+namespace appfw {
+
+/**
+ * Index of console items by name.
+ * Lookup is an open-addressing hash table (linear probing) that stores the hash with the item
+ * so a lookup compares strings only on a hash match and never allocates.
+ * Keys are the names owned by the items themselves.
+ *
+ * A list of items ordered by name is kept alongside for listing.
+ */
+class ConItemIndex : NoMove {
+public:
+    ConItemIndex();
+
+    /**
+     * @return the item with specified name or nullptr
+     */
+    ConItemBase *find(std::string_view name) const;
+
+    /**
+     * Adds an item.
+     * @return false if an item with the same name already exists
+     */
+    bool insert(ConItemBase *pItem);
+
+    /**
+     * Removes an item.
+     * @return false if the item is not in the index
+     */
+    bool erase(ConItemBase *pItem);
+
+    /**
+     * @return number of items
+     */
+    inline size_t size() const { return m_SortedItems.size(); }
+
+    /**
+     * @return items ordered by name
+     */
+    inline const std::vector<ConItemBase *> &getSortedItems() const { return m_SortedItems; }
+
+private:
+    struct Slot {
+        size_t uHash = 0;
+        ConItemBase *pItem = nullptr;
+    };
+
+    //! Initial number of slots
+    static constexpr size_t MIN_SLOT_COUNT = 64;
+
+    std::vector<Slot> m_Slots;
+    std::vector<ConItemBase *> m_SortedItems;
+
+    //! @return index of the slot with the item or of the empty slot where it would be
+    size_t findSlot(std::string_view name, size_t hash) const;
+
+    //! Reinserts all items into a table of specified size (power of 2).
+    void rehash(size_t slotCount);
+
+    static size_t hashName(std::string_view name);
+};
+
+} // namespace appfw
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef APPFW_CONSOLE_CON_MSG_FILTER_H
+#define APPFW_CONSOLE_CON_MSG_FILTER_H
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <appfw/console/con_item.h>
+#include <appfw/console/con_msg.h>
+#include <appfw/utils.h>
+
+/**
+ * Least severe message type that is compiled in (a ConMsgType value name, e.g. Info).
+ * Print calls of less severe types are removed at compile time. Input is never removed.
+ */
+#ifndef APPFW_CON_MIN_LEVEL
+#define APPFW_CON_MIN_LEVEL Debug
+#endif
+
+namespace appfw {
+
+//! Least severe message type that is compiled in
+constexpr ConMsgType CON_MIN_LEVEL = ConMsgType::APPFW_CON_MIN_LEVEL;
+
+/**
+ * @return whether messages of this type are compiled in
+ */
+constexpr bool isConMsgTypeCompiled(ConMsgType type) {
+    return type <= CON_MIN_LEVEL || type == ConMsgType::Input;
+}
+
+/**
+ * Filters messages of a tag by type before they are formatted.
+ * A message is printed if its type is at least as severe as the level of the tag or,
+ * if the tag has no level, the global level (con_min_level cvar).
+ *
+ * Each module has a filter for its tag with a cvar named "<module>_con_min_level".
+ */
+class ConMsgFilter : NoMove {
+public:
+    /**
+     * @param   tag         Tag of filtered messages
+     * @param   cvarName    Name of the level cvar. Must be a string literal.
+     */
+    ConMsgFilter(const char *tag, const char *cvarName);
+    ~ConMsgFilter();
+
+    /**
+     * @return tag of filtered messages
+     */
+    inline const char *getTag() const { return m_pszTag; }
+
+    /**
+     * @return the level cvar of the tag
+     */
+    inline ConVar<int> &getLevelCvar() { return m_Level; }
+
+    /**
+     * @return whether messages of this type pass the filter. Thread-safe.
+     */
+    inline bool isEnabled(ConMsgType type) const {
+        return m_uTypeMask.load(std::memory_order_relaxed) & (1u << (unsigned)type);
+    }
+
+    /**
+     * @return the global level
+     */
+    static ConMsgType getGlobalLevel();
+
+    /**
+     * Sets the global level. Called by con_min_level cvar, its value is not updated.
+     */
+    static void setGlobalLevel(ConMsgType level);
+
+private:
+    const char *m_pszTag = nullptr;
+    std::atomic<uint32_t> m_uTypeMask = 0;
+    ConVar<int> m_Level;
+
+    //! Sets the mask from the level of the tag and the global level.
+    void updateTypeMask(int level);
+
+    static std::atomic<uint8_t> &getGlobalLevelRef();
+    static std::mutex &getListMutex();
+    static std::set<ConMsgFilter *> &getList();
+};
+
+} // namespace appfw
+
+#endif
@@ -0,0 +1,145 @@
+#ifndef APPFW_CONSOLE_CON_MSG_HISTORY_H
+#define APPFW_CONSOLE_CON_MSG_HISTORY_H
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string_view>
+#include <vector>
+#include <appfw/console/con_msg.h>
+#include <appfw/utils.h>
+
+namespace appfw {
+
+/**
+ * Saved console messages in a single contiguous byte ring.
+ * Each message is a fixed header (info and length) followed by the text.
+ * Oldest messages are removed to make space for new ones.
+ *
+ * Messages are numbered in the order they were pushed so readers on other threads
+ * can continue from where they stopped. Thread-safe.
+ */
+class ConMsgHistory : NoMove {
+public:
+    //! Default size in bytes
+    static constexpr size_t DEF_SIZE = 64 * 1024;
+
+    //! Minimum size in bytes
+    static constexpr size_t MIN_SIZE = 1024;
+
+    /**
+     * @param   size    Size of the buffer in bytes. Throws std::invalid_argument if less than MIN_SIZE.
+     */
+    explicit ConMsgHistory(size_t size = DEF_SIZE);
+
+    /**
+     * @return size of the buffer in bytes
+     */
+    inline size_t getSize() const { return m_Data.size(); }
+
+    /**
+     * Sets the size of the buffer. Saved messages are discarded.
+     * Throws std::invalid_argument if less than MIN_SIZE.
+     */
+    void setSize(size_t size);
+
+    /**
+     * Copies a message into the buffer. Text that doesn't fit in the buffer is truncated.
+     * @return the saved text. Valid until the next push, setSize or clear.
+     */
+    std::string_view push(const ConMsgInfo &info, std::string_view msg);
+
+    /**
+     * @return number of saved messages
+     */
+    size_t getCount();
+
+    /**
+     * @return number of the oldest saved message
+     */
+    uint64_t getFirstIndex();
+
+    /**
+     * @return number the next pushed message will have
+     */
+    uint64_t getNextIndex();
+
+    /**
+     * Calls fn(uint64_t idx, const ConMsgInfo &info, std::string_view msg) for saved messages
+     * starting from message number idx (or the oldest one if it was removed) until fn returns false.
+     * The buffer is locked during the call, fn must not print.
+     * @return number of the message after the last one fn accepted
+     */
+    template <typename T>
+    uint64_t forEach(uint64_t idx, T fn);
+
+    /**
+     * Removes all messages.
+     */
+    void clear();
+
+private:
+    struct Header {
+        ConMsgInfo info;
+        uint32_t uLength;
+    };
+
+    //! Header length of the end-of-ring marker
+    static constexpr uint32_t WRAP_MARKER = UINT32_MAX;
+
+    std::mutex m_Mutex;
+    std::vector<uint8_t> m_Data;
+    size_t m_uHead = 0; //!< Offset of the oldest message
+    size_t m_uTail = 0; //!< Offset where the next message is written
+    size_t m_uCount = 0;
+    uint64_t m_uFirstIdx = 0;
+
+    static constexpr size_t getEntrySize(size_t textLength) {
+        size_t size = sizeof(Header) + textLength;
+        return (size + alignof(Header) - 1) & ~(alignof(Header) - 1);
+    }
+
+    inline Header readHeader(size_t offset) const {
+        Header header;
+        std::memcpy(&header, m_Data.data() + offset, sizeof(Header));
+        return header;
+    }
+
+    //! @returns offset of the message that starts at offset or after the end of the ring.
+    size_t skipWrap(size_t offset) const;
+
+    //! @returns whether a message of specified size can be written at m_uTail (may wrap it).
+    bool reserve(size_t size);
+
+    //! Removes the oldest message.
+    void popFront();
+};
+
+template <typename T>
+inline uint64_t ConMsgHistory::forEach(uint64_t idx, T fn) {
+    std::lock_guard lock(m_Mutex);
+    size_t offset = m_uHead;
+    uint64_t curIdx = m_uFirstIdx;
+
+    for (size_t i = 0; i < m_uCount; i++, curIdx++) {
+        offset = skipWrap(offset);
+        Header header = readHeader(offset);
+
+        if (curIdx >= idx) {
+            std::string_view text(reinterpret_cast<const char *>(m_Data.data()) + offset +
+                                      sizeof(Header),
+                                  header.uLength);
+
+            if (!fn(curIdx, header.info, text)) {
+                return curIdx;
+            }
+        }
+
+        offset += getEntrySize(header.uLength);
+    }
+
+    return curIdx;
+}
+
+} // namespace appfw
+
+#endif
@@ -1,14 +1,19 @@
 #ifndef APPFW_CONSOLE_CONSOLE_SYSTEM_H
 #define APPFW_CONSOLE_CONSOLE_SYSTEM_H
-#include <map>
+#include <atomic>
+#include <condition_variable>
 #include <set>
 #include <string>
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <appfw/console/con_deferred_msg.h>
 #include <appfw/console/con_item.h>
+#include <appfw/console/con_item_index.h>
+#include <appfw/console/con_msg_history.h>
 #include <appfw/console/con_msg.h>
 #include <appfw/cmd_buffer.h>
+#include <appfw/mpsc_queue.h>
 #include <appfw/utils.h>
 
 namespace appfw {
@@ -46,13 +51,37 @@ public:
     virtual bool isThreadSafe() = 0;
 };
 
+/**
+ * What print does when the message queue is full.
+ */
+enum class ConQueueFullPolicy
+{
+    Block, //!< Wait until there is space. Drains the queue itself if output is thread-safe,
+           //!< otherwise drops the message if the main thread doesn't drain it in time.
+    Drop,  //!< Drop the message and count it
+};
+
 class ConsoleSystem : NoMove {
 public:
-    ConsoleSystem();
+    //! Default capacity of the message queue
+    static constexpr size_t DEF_MSG_QUEUE_SIZE = 4096;
+
+    //! Maximum time print waits for the main thread to drain a full queue with Block policy
+    static constexpr auto MAX_QUEUE_BLOCK_TIME = std::chrono::milliseconds(100);
+
+    /**
+     * @param   msgQueueSize    Capacity of the message queue (rounded up to a power of 2)
+     * @param   historySize     Size of the message history in bytes
+     */
+    ConsoleSystem(size_t msgQueueSize = DEF_MSG_QUEUE_SIZE,
+                  size_t historySize = ConMsgHistory::DEF_SIZE);
     ~ConsoleSystem();
 
     /**
      * Prints a string to the console. Thread-safe.
+     * Messages from the main thread are printed immediately unless the sink thread is running.
+     * Messages from other threads are put into a lock-free queue
+     * and printed by processMsgQueue or by the sink thread.
      */
     void print(const ConMsgInfo &info, std::string_view msg);
 
@@ -61,12 +90,64 @@ public:
      */
     void print(const ConMsgInfo &info, std::string &&msg);
 
+    /**
+     * Prints a message with captured arguments. Thread-safe.
+     * It is formatted by the thread that prints it: main thread, sink thread
+     * or another producer draining the queue.
+     */
+    void print(const ConMsgInfo &info, ConDeferredMsg &&msg);
+
+    /**
+     * Enables or disables deferred formatting. If enabled, print functions that only take
+     * arithmetic arguments capture them instead of formatting the message on the calling thread.
+     * Invalid format strings are reported in the message instead of throwing.
+     */
+    inline void setDeferredFormatting(bool state) {
+        m_bDeferredFormatting.store(state, std::memory_order_relaxed);
+    }
+
+    /**
+     * @return whether deferred formatting is enabled
+     */
+    inline bool isDeferredFormatting() {
+        return m_bDeferredFormatting.load(std::memory_order_relaxed);
+    }
+
     /**
      * Returns whether console output is thread-safe.
      * If false, messages from other threads will be delayed until next tick.
      */
     bool isThreadSafeOutput();
 
+    /**
+     * Sets what happens when the message queue is full.
+     */
+    inline void setQueueFullPolicy(ConQueueFullPolicy policy) {
+        m_QueueFullPolicy.store(policy, std::memory_order_relaxed);
+    }
+
+    /**
+     * @return number of messages dropped because the queue was full
+     */
+    inline uint64_t getDroppedMsgCount() { return m_uDroppedMsgs.load(std::memory_order_relaxed); }
+
+    /**
+     * Starts a thread that prints queued messages. All messages go through the queue,
+     * including the ones from the main thread.
+     * Throws std::logic_error if any receiver isn't thread-safe.
+     */
+    void startSinkThread();
+
+    /**
+     * Stops the sink thread and prints remaining messages.
+     */
+    void stopSinkThread();
+
+    /**
+     * @return whether the sink thread is running
+     */
+    inline bool isSinkThreadRunning() { return m_bSinkThreadRunning; }
+
     /**
      * Finds an item by name.
      * @param   name    Name of the item.
@@ -80,7 +161,7 @@ public:
      * @param   name    Name of the convar.
      * @return Found item or nullptr.
      */
-    inline ConVarBase *findCvar(const std::string &name) {
+    inline ConVarBase *findCvar(std::string_view name) {
         return static_cast<ConVarBase *>(findItem(name, ConItemType::ConVar));
     }
 
@@ -89,14 +170,14 @@ public:
      * @param   name    Name of the command.
      * @return Found item or nullptr.
      */
-    inline ConVarBase *findCommand(const std::string &name) {
+    inline ConVarBase *findCommand(std::string_view name) {
         return static_cast<ConVarBase *>(findItem(name, ConItemType::ConCommand));
     }
 
     /**
-     * Returns map of all items, ordered alphabetically.
+     * Returns list of all items, ordered alphabetically.
      */
-    const auto &getItemMap() { return m_ConItems; }
+    inline const std::vector<ConItemBase *> &getItemList() { return m_ConItems.getSortedItems(); }
 
     /**
      * Registers an item.
@@ -140,6 +221,7 @@ public:
 
     /**
      * Prints all pending messages from other threads.
+     * Sets the calling thread as the main thread.
      */
     void processMsgQueue();
 
@@ -158,21 +240,64 @@ public:
      */
     void printPreviousMessages(IConsoleReceiver *pRecv);
 
-private:
-    class RingBuffer;
+    /**
+     * Returns the history of printed messages. Can be read from any thread.
+     */
+    inline ConMsgHistory &getHistory() { return m_History; }
+
+    /**
+     * Sets the size of the message history in bytes. Saved messages are discarded.
+     */
+    void setHistorySize(size_t size);
 
-    std::unique_ptr<RingBuffer> m_pMsgBuf;
-    std::map<std::string, ConItemBase *, std::less<>> m_ConItems;
+private:
+    //! A message in the queue. Either text or deferred is set.
+    struct QueuedMsg {
+        ConMsgInfo info;
+        std::string text;
+        ConDeferredMsg deferred;
+    };
+
+    //! Time the sink thread sleeps if not woken up by an error message
+    static constexpr auto SINK_WAIT_TIME = std::chrono::milliseconds(10);
+
+    ConMsgHistory m_History;
+    ConItemIndex m_ConItems;
     std::set<IConsoleReceiver *> m_RecvList;
     CmdBuffer m_CmdBuffer;
 
-    // Output thread safety
-    std::queue<ConMsg> m_ThreadedMsgQueue;
-    std::thread::id m_MainThread;
+    // Output thread safety.
+    // Queue is drained by whoever holds m_OutputMutex.
+    MPSCQueue<QueuedMsg> m_MsgQueue;
+    std::atomic<std::thread::id> m_MainThread;
     std::mutex m_OutputMutex;
-    bool m_bThreadSafeOutput = true;
+    std::atomic_bool m_bThreadSafeOutput = true;
+    std::atomic<ConQueueFullPolicy> m_QueueFullPolicy = ConQueueFullPolicy::Block;
+    std::atomic<uint64_t> m_uDroppedMsgs = 0;
+    std::atomic_bool m_bDeferredFormatting = false;
+
+    // Sink thread
+    std::thread m_SinkThread;
+    std::atomic_bool m_bSinkThreadRunning = false;
+    std::mutex m_SinkMutex;
+    std::condition_variable m_SinkCv;
+    bool m_bStopSinkThread = false;
 
     void updateThreadSafetyState();
+
+    //! Puts a message into the queue according to the policy
+    void enqueueMsg(QueuedMsg &&msg);
+
+    //! Prints all queued messages. m_OutputMutex must be locked.
+    void drainMsgQueue();
+
+    //! Saves the message and passes it to receivers. m_OutputMutex must be locked.
+    void outputMsg(const ConMsgInfo &info, std::string_view msg);
+
+    void sinkThreadWorker();
+
+    //! Formats a deferred message. Format errors are returned as the text.
+    static std::string formatDeferredMsg(const ConDeferredMsg &msg);
 };
 
 } // namespace appfw
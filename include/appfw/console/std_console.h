@@ -6,7 +6,10 @@
 namespace appfw {
 
 /**
- * Terminal console using std::cin and std::cout.
+ * Terminal console using std::cin and stdout.
+ * Output is collected in a buffer and written in one call when the buffer is full,
+ * on errors and every main loop tick. Before the first tick every message is written immediately.
+ * Colors are written as ANSI escape codes if stdout is a terminal.
  */
 class StdConsole : public ITermConsole, NoMove {
 public:
@@ -20,8 +23,17 @@ public:
 
     TermInputMethod getInputMethod() override;
     void tick() override;
+    void flush() override;
+
+    /**
+     * Enables or disables ANSI color escape codes. Enabled by default if stdout is a terminal.
+     */
+    void setColorsEnabled(bool state);
 
 private:
+    //! Output is written when the buffer reaches this size
+    static constexpr size_t OUT_BUF_SIZE = 64 * 1024;
+
     struct SyncData {
         bool bIsValid = false;
         std::mutex mutex;
@@ -33,7 +45,16 @@ private:
     std::queue<std::string> m_CmdQueue;
     TermInputMethod m_InputMethod;
 
-    void setColor(ConMsgColor color);
+    std::mutex m_OutMutex;
+    std::string m_OutBuf;
+    bool m_bUseColors = false;
+    bool m_bBatchOutput = false;
+
+    //! Appends the escape code of the color to the buffer
+    void appendColor(ConMsgColor color);
+
+    //! Writes the buffer to stdout. m_OutMutex must be locked.
+    void writeOutput();
 
     static void threadWorker(StdConsole *t, std::shared_ptr<SyncData> pSyncData);
 };
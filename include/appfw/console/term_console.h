@@ -30,6 +30,11 @@ public:
      * Called every main loop tick just before ConsoleSystem::processCommand().
      */
     virtual void tick() = 0;
+
+    /**
+     * Writes buffered output. Called at the end of every main loop tick.
+     */
+    virtual void flush() = 0;
 };
 
 } // namespace appfw
@@ -1,10 +1,8 @@
 #ifndef APPFW_EXTCON_EXTCON_HOST_H
 #define APPFW_EXTCON_EXTCON_HOST_H
-#include <condition_variable>
 #include <appfw/binary_buffer.h>
 #include <appfw/console/console_system.h>
-#include <appfw/network/tcp_server4.h>
-#include <appfw/network/datagram_parser.h>
+#include <appfw/network/framed_tcp_server.h>
 
 namespace appfw {
 
@@ -19,6 +17,10 @@ public:
     //! Begins listening for extcon connections on specified address.
     void enable(const IPAddress4 &addr, uint16_t port);
 
+    //! Begins listening for extcon connections on specified address.
+    //! Can be a Unix domain socket address for clients on the same machine.
+    void enable(const SockAddr &addr);
+
     //! Disconnects all clients and closes the server socket.
     void disable();
 
@@ -31,6 +33,9 @@ public:
     //! @returns whether host focus is requested and resets the flag.
     inline bool isHostFocusRequested() { return m_bHostFocusRequested.exchange(false); }
 
+    //! @returns number of messages removed from the history before they were sent
+    inline uint64_t getDroppedMsgCount() { return m_uDroppedMsgs.load(std::memory_order_relaxed); }
+
     // IConsoleReceiver
     void onAdd(ConsoleSystem *pConSys) override;
     void onRemove(ConsoleSystem *pConSys) override;
@@ -38,50 +43,55 @@ public:
     bool isThreadSafe() override;
 
 private:
-    //! Maximum queue size. If it's more than that, print call will wait until it's empty.
-    static constexpr int MAX_QUEUE_SIZE = 128;
-
     class WorkerThread : appfw::NoMove {
     public:
         WorkerThread(ExtconHost &con);
         ~WorkerThread();
 
-        void start(const IPAddress4 &addr, uint16_t port);
+        void start(const SockAddr &addr);
         void stop();
 
     private:
         static constexpr int POLL_TIME = 1000 / 60;
         static constexpr size_t MAX_TCP_READ_SIZE = 65535;
 
+        //! Messages are sent in batches up to this size.
+        //! No new batch is queued while the send queue is larger than that.
+        static constexpr size_t MAX_BATCH_SIZE = 64 * 1024;
+
+        //! Time in ms the send queue can go without progress before the client is dropped
+        static constexpr int WRITE_TIMEOUT = 10000;
+
         ExtconHost &m_Con;
         std::atomic_bool m_bIsThreadRunning = false;
         std::thread m_Thread;
 
-        TcpServer4 m_Server;
-        DatagramParser m_ClientParser;
+        FramedTcpServer m_Server;
         std::vector<uint8_t> m_Buffer;
+        std::vector<uint8_t> m_SendBatch;
 
-        appfw::TcpClientSocket4Ptr m_pClientSocket;
+        appfw::TcpClientSocketPtr m_pClientSocket;
         bool m_bIsSocketValid = false;
 
-        void run(const IPAddress4 &addr, uint16_t port) noexcept;
+        //! Messages are sent straight from the console history
+        uint64_t m_uNextMsgIdx = 0;
+
+        void run(const SockAddr &addr) noexcept;
         void pollServer();
         void updateConnectedClient();
         void sendAvailableCommands();
         void sendQueuedMessages();
         void sendRequestFocus();
-        void onConnAccepted(appfw::TcpClientSocket4Ptr socket) noexcept;
-        void onConnClosed(appfw::TcpClientSocket4Ptr socket,
+        void onConnAccepted(appfw::TcpClientSocketPtr socket) noexcept;
+        void onConnClosed(appfw::TcpClientSocketPtr socket,
                           appfw::SocketCloseReason reason) noexcept;
-        void onReadyRead(appfw::TcpClientSocket4Ptr socket) noexcept;
-        void onPayloadReceived(appfw::BinaryInputStream &stream) noexcept;
+        void onPayloadReceived(const appfw::TcpClientSocketPtr &socket,
+                               appfw::BinaryInputStream &stream) noexcept;
         appfw::BinaryBuffer prepareSendBuffer(uint8_t opcode);
+        void finishBuffer(appfw::BinaryBuffer &buffer);
         void sendBuffer(appfw::BinaryBuffer &buffer);
-    };
 
-    struct PrintMessage {
-        ConMsgInfo info;
-        std::string text;
+        friend class ExtconHost;
     };
 
     ConsoleSystem *m_pConSys = nullptr;
@@ -92,9 +102,7 @@ private:
     std::mutex m_StateSyncMutex; // State variables are updated from the worker
     bool m_bStateIsConnected = false;
 
-    std::mutex m_PrintQueueMutex;
-    std::condition_variable m_PrintQueueEmptyCv;
-    std::queue<PrintMessage> m_PrintQueue;
+    std::atomic<uint64_t> m_uDroppedMsgs = 0;
 
     std::mutex m_AvailableCommandsMutex;
     std::vector<std::string> m_AvailableCommands;
@@ -0,0 +1,152 @@
+#ifndef APPFW_MPSC_QUEUE_H
+#define APPFW_MPSC_QUEUE_H
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <appfw/utils.h>
+
+namespace appfw {
+
+/**
+ * A bounded lock-free queue with multiple producers and a single consumer.
+ * Based on Dmitry Vyukov's bounded MPMC queue: each cell has a sequence number
+ * that tells whether it's free to write or ready to read.
+ *
+ * tryPush can be called from any thread. tryPop must only be called by one thread
+ * at a time (e.g. under a mutex).
+ */
+template <typename T>
+class MPSCQueue : NoMove {
+public:
+    /**
+     * @param   capacity    Maximum number of items. Rounded up to a power of 2.
+     */
+    explicit MPSCQueue(size_t capacity);
+    ~MPSCQueue();
+
+    /**
+     * @return maximum number of items
+     */
+    inline size_t capacity() const { return m_uMask + 1; }
+
+    /**
+     * @return number of items. May be out of date by the time it returns.
+     */
+    size_t sizeApprox() const;
+
+    /**
+     * Moves an item into the queue. Never blocks.
+     * @return  false if the queue is full (item is left untouched)
+     */
+    bool tryPush(T &&item);
+
+    /**
+     * Moves the oldest item out of the queue. Single consumer only.
+     * @return  false if the queue is empty
+     */
+    bool tryPop(T &item);
+
+private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    struct Cell {
+        std::atomic<size_t> seq;
+        std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+
+        inline T *get() { return std::launder(reinterpret_cast<T *>(&storage)); }
+    };
+
+    std::unique_ptr<Cell[]> m_pCells;
+    size_t m_uMask = 0;
+
+    // Producers and the consumer write to different cache lines
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_uEnqueuePos = 0;
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_uDequeuePos = 0;
+};
+
+template <typename T>
+inline MPSCQueue<T>::MPSCQueue(size_t capacity) {
+    size_t size = 2;
+
+    while (size < capacity) {
+        size *= 2;
+    }
+
+    m_pCells = std::make_unique<Cell[]>(size);
+    m_uMask = size - 1;
+
+    for (size_t i = 0; i < size; i++) {
+        m_pCells[i].seq.store(i, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+inline MPSCQueue<T>::~MPSCQueue() {
+    T item;
+
+    while (tryPop(item)) {
+    }
+}
+
+template <typename T>
+inline size_t MPSCQueue<T>::sizeApprox() const {
+    size_t enqueuePos = m_uEnqueuePos.load(std::memory_order_relaxed);
+    size_t dequeuePos = m_uDequeuePos.load(std::memory_order_relaxed);
+    return enqueuePos >= dequeuePos ? enqueuePos - dequeuePos : 0;
+}
+
+template <typename T>
+inline bool MPSCQueue<T>::tryPush(T &&item) {
+    size_t pos = m_uEnqueuePos.load(std::memory_order_relaxed);
+    Cell *cell = nullptr;
+
+    for (;;) {
+        cell = &m_pCells[pos & m_uMask];
+        size_t seq = cell->seq.load(std::memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+        if (diff == 0) {
+            // Cell is free, try to claim it
+            if (m_uEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // Consumer hasn't freed the cell yet
+            return false;
+        } else {
+            // Another producer claimed it
+            pos = m_uEnqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    new (&cell->storage) T(std::move(item));
+    cell->seq.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+inline bool MPSCQueue<T>::tryPop(T &item) {
+    size_t pos = m_uDequeuePos.load(std::memory_order_relaxed);
+    Cell *cell = &m_pCells[pos & m_uMask];
+    size_t seq = cell->seq.load(std::memory_order_acquire);
+
+    if ((intptr_t)seq - (intptr_t)(pos + 1) < 0) {
+        // Empty or the producer hasn't finished writing
+        return false;
+    }
+
+    T *pItem = cell->get();
+    item = std::move(*pItem);
+    pItem->~T();
+    cell->seq.store(pos + m_uMask + 1, std::memory_order_release);
+    m_uDequeuePos.store(pos + 1, std::memory_order_relaxed);
+    return true;
+}
+
+} // namespace appfw
+
+#endif
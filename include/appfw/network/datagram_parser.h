@@ -2,10 +2,41 @@
 #define APPFW_NETWORK_DATAGRAM_PARSER_H
 #include <vector>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <appfw/binary_stream.h>
 
 namespace appfw {
 
+//! A thread-safe pool of payload reassembly buffers that can be shared by many parsers.
+//! Parsers take a buffer when a packet needs reassembly and return it when it's done,
+//! so idle connections don't hold any memory.
+class DatagramBufferPool {
+public:
+    static constexpr size_t DEF_MAX_BUFFERS = 16;
+    static constexpr size_t DEF_MAX_BUFFER_SIZE = 64 * 1024;
+
+    //! @param  maxBuffers      Maximum number of free buffers kept in the pool
+    //! @param  maxBufferSize   Larger buffers are freed instead of being returned to the pool
+    DatagramBufferPool(size_t maxBuffers = DEF_MAX_BUFFERS,
+                       size_t maxBufferSize = DEF_MAX_BUFFER_SIZE);
+
+    //! @returns a buffer of at least specified size.
+    std::vector<uint8_t> acquire(size_t size);
+
+    //! Returns the buffer into the pool.
+    void release(std::vector<uint8_t> &&buf);
+
+    //! @returns the number of free buffers in the pool.
+    size_t getFreeBufferCount();
+
+private:
+    std::mutex m_Mutex;
+    std::vector<std::vector<uint8_t>> m_FreeBuffers;
+    size_t m_uMaxBuffers = 0;
+    size_t m_uMaxBufferSize = 0;
+};
+
 //! Simple datagram parser for stream protocols (like TCP).
 //! Packet structure:
 //! - Header
@@ -16,6 +47,7 @@ class DatagramParser {
 public:
     static constexpr uint16_t MAX_MAGIC_SIZE = 30;
     static constexpr uint32_t MAX_ABSOLUTE_PAYLOAD_SIZE = std::numeric_limits<uint32_t>::max() - MAX_MAGIC_SIZE - sizeof(uint32_t);
+    static constexpr uint32_t DEF_RETAINED_BUFFER_SIZE = 4096;
 
     enum class Error {
         NoError,
@@ -24,11 +56,12 @@ public:
     };
 
     //! Called when full payload is received.
-    //! It is NOT recommended to modify 'payload' if you use 'stream'.
+    //! If the whole packet was in the input of parseData, payload points directly into it.
+    //! Otherwise it points into the internal reassembly buffer. Only valid during the call.
     //! @param  stream  Binary stream of the payload
     //! @param  payload Payload buffer (same as stream).
     //! @param  size    Payload size
-    using PayloadCallback = std::function<void(appfw::BinaryInputStream &stream, uint8_t *payload, size_t size)>;
+    using PayloadCallback = std::function<void(appfw::BinaryInputStream &stream, const uint8_t *payload, size_t size)>;
 
     //! Sets the magic bytes.
     void setMagic(const uint8_t *magic, uint16_t size);
@@ -37,8 +70,17 @@ public:
     void setMagic(const char *magic, uint16_t size);
 
     //! Sets the maximum payload size.
+    //! Reassembly buffer is allocated on demand for the announced payload size.
     void setMaxPayloadSize(uint32_t size);
 
+    //! Sets the size of reassembly buffer kept between packets.
+    //! Buffer is freed after a packet larger than that.
+    void setRetainedBufferSize(uint32_t size);
+
+    //! Sets the pool to take reassembly buffers from. Can be nullptr.
+    //! If set, buffers are returned into the pool after every reassembled packet.
+    void setBufferPool(const std::shared_ptr<DatagramBufferPool> &pool);
+
     //! Sets the payload callback.
     void setPayloadCallback(const PayloadCallback &cb);
 
@@ -46,6 +88,7 @@ public:
     void reset();
 
     //! Parses incoming stream of data. When payload is fully read, calls payload callback.
+    //! Packets that are fully contained in the data are parsed in place without copying.
     //! If an error occures, sets error and returns false. State is undefined, it's best to close the connection and call reset().
     //! @param  data        Incoming data
     //! @param  size        Size of the data
@@ -69,17 +112,33 @@ private:
     uint8_t m_Magic[MAX_MAGIC_SIZE];
     uint16_t m_uMagicSize = 0;
     uint32_t m_uMaxPayloadSize = 0;
+    uint32_t m_uRetainedBufferSize = DEF_RETAINED_BUFFER_SIZE;
     PayloadCallback m_fnPayloadCallback;
+    std::shared_ptr<DatagramBufferPool> m_pBufferPool;
 
-    Stage m_Stage;
-    uint32_t m_uParsedPacketSize;
+    Stage m_Stage = Stage::Magic;
+    uint32_t m_uParsedPacketSize = 0;
     uint8_t m_ParsedMagic[MAX_MAGIC_SIZE];
     uint8_t m_ParsedPayloadSizeBytes[sizeof(uint32_t)];
-    uint32_t m_uParsedPayloadSize;
+    uint32_t m_uParsedPayloadSize = 0;
     std::vector<uint8_t> m_ParsedPayload;
 
     //! @returns the size of the header.
     inline uint32_t getHeaderSize() { return m_uMagicSize + sizeof(uint32_t); }
+
+    //! Parses a packet at the start of the data if it's fully available.
+    //! @param  packetSize  Size of the parsed packet or 0 if it's incomplete
+    //! @returns success or not
+    bool parseInPlace(const uint8_t *data, uint32_t size, uint32_t &packetSize, Error &error);
+
+    //! Calls the payload callback.
+    void onPayloadParsed(const uint8_t *payload, uint32_t size);
+
+    //! Makes sure the reassembly buffer can hold the parsed payload.
+    void allocPayloadBuffer();
+
+    //! Frees or returns into the pool the reassembly buffer if it shouldn't be kept.
+    void releasePayloadBuffer();
 };
 
 }
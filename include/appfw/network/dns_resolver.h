@@ -0,0 +1,142 @@
+#ifndef APPFW_NETWORK_DNS_RESOLVER_H
+#define APPFW_NETWORK_DNS_RESOLVER_H
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <list>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <appfw/network/sock_addr.h>
+#include <appfw/utils.h>
+
+namespace appfw {
+
+/**
+ * Resolves host names on a pool of worker threads so the caller doesn't block in getaddrinfo.
+ *
+ * Results are cached. Lookups of a name that is already being resolved share the same result.
+ * getaddrinfo doesn't return record TTLs so cached entries live for a configurable time.
+ * Failed lookups are cached too, for a shorter time.
+ */
+class DnsResolver : NoMove {
+public:
+    using AddrList = std::list<SockAddr>;
+    using ResultFuture = std::shared_future<AddrList>;
+
+    //! Callback with the ready result. result.get() throws if resolution failed.
+    using Callback = std::function<void(const ResultFuture &result)>;
+
+    //! Default number of worker threads
+    static constexpr unsigned DEF_THREAD_COUNT = 2;
+
+    //! Default time in ms a resolved name is cached for
+    static constexpr int DEF_CACHE_TTL = 60'000;
+
+    //! Default time in ms a failed lookup is cached for
+    static constexpr int DEF_NEGATIVE_CACHE_TTL = 5'000;
+
+    /**
+     * Starts the worker threads.
+     * @param   threadCount     Number of lookups that can run in parallel
+     */
+    explicit DnsResolver(unsigned threadCount = DEF_THREAD_COUNT);
+
+    /**
+     * Stops the worker threads. Waits for running lookups to finish.
+     * Queued lookups fail.
+     */
+    ~DnsResolver();
+
+    /**
+     * Sets time in ms a resolved name is cached for (0 - don't cache).
+     * Applies to new results.
+     */
+    void setCacheTTL(int time);
+
+    /**
+     * Sets time in ms a failed lookup is cached for (0 - don't cache).
+     * Applies to new results.
+     */
+    void setNegativeCacheTTL(int time);
+
+    /**
+     * Removes all finished lookups from the cache.
+     */
+    void clearCache();
+
+    /**
+     * @return the number of cached and running lookups.
+     */
+    size_t getCacheSize();
+
+    /**
+     * Resolves hostname and port into a list of addresses. Same as resolveHostName
+     * but doesn't block. Returns a cached result if available.
+     * @return  Future of the list. get() throws if resolution fails.
+     */
+    ResultFuture resolve(const std::string &hostname, const std::string &port,
+                         SockType type = SockType::Any,
+                         AddressFamily family = AddressFamily::Unspec);
+
+    /**
+     * Same as resolve() but calls the callback from tick() once the result is ready.
+     */
+    void resolve(const std::string &hostname, const std::string &port, SockType type,
+                 AddressFamily family, Callback cb);
+
+    /**
+     * Calls callbacks of finished lookups and removes expired cache entries.
+     * Should be called from the main loop.
+     */
+    void tick();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    //! How often tick() removes expired entries in ms
+    static constexpr int PURGE_PERIOD = 1000;
+
+    struct CacheEntry {
+        ResultFuture result;
+        Clock::time_point expiry = Clock::time_point::max(); //!< max while running
+    };
+
+    struct Request {
+        std::string hostname;
+        std::string port;
+        SockType type = SockType::Any;
+        AddressFamily family = AddressFamily::Unspec;
+        std::string key;
+        std::promise<AddrList> promise;
+    };
+
+    struct PendingCallback {
+        ResultFuture result;
+        Callback callback;
+    };
+
+    std::mutex m_Mutex;
+    std::condition_variable m_QueueCv;
+    std::queue<Request> m_Queue;
+    std::unordered_map<std::string, CacheEntry> m_Cache;
+    int m_iCacheTTL = DEF_CACHE_TTL;
+    int m_iNegativeCacheTTL = DEF_NEGATIVE_CACHE_TTL;
+    bool m_bIsStopping = false;
+    std::vector<std::thread> m_Threads;
+
+    //! Only accessed from resolve and tick
+    std::vector<PendingCallback> m_Callbacks;
+    Clock::time_point m_LastPurgeTime;
+
+    void workerMain();
+    void purgeExpired(Clock::time_point now);
+};
+
+} // namespace appfw
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef APPFW_NETWORK_FRAMED_TCP_SERVER_H
+#define APPFW_NETWORK_FRAMED_TCP_SERVER_H
+#include <memory>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include <appfw/network/datagram_parser.h>
+#include <appfw/network/tcp_server.h>
+#include <appfw/utils.h>
+
+namespace appfw {
+
+/**
+ * A TCP server that splits incoming data into DatagramParser frames.
+ * Every connection has its own parser so frames split across reads are reassembled
+ * independently for each client. Socket is drained into its receive buffer in one pass
+ * on every poll and parsed directly from it. Reassembly buffers for split frames are
+ * taken from a pool shared by all connections.
+ */
+class FramedTcpServer : NoMove {
+public:
+    using ConnAcceptedCallback = TcpServer::ConnAcceptedCallback;
+    using ConnClosedCallback = TcpServer::ConnClosedCallback;
+
+    //! Called when a full payload is received from a client.
+    //! @param  index   Client index (see TcpServer::getSocket)
+    //! @param  socket  Client socket
+    //! @param  stream  Binary stream of the payload
+    //! @param  payload Payload buffer (same as stream). Only valid during the call.
+    using PayloadCallback =
+        std::function<void(size_t index, const TcpClientSocketPtr &socket,
+                           BinaryInputStream &stream, appfw::span<const uint8_t> payload)>;
+
+    FramedTcpServer();
+    ~FramedTcpServer();
+
+    /**
+     * Sets the magic bytes. Applies only to new connections.
+     */
+    void setMagic(const uint8_t *magic, uint16_t size);
+
+    /**
+     * Sets the magic bytes. Applies only to new connections.
+     */
+    void setMagic(const char *magic, uint16_t size);
+
+    /**
+     * Sets the maximum payload size. Applies only to new connections.
+     */
+    void setMaxPayloadSize(uint32_t size);
+
+    /**
+     * @return whether the server is listening for incoming connections
+     */
+    inline bool isListening() { return m_Server.isListening(); }
+
+    /**
+     * Starts listening for incoming connections.
+     * See TcpServer::startListening.
+     */
+    void startListening(IPAddress4 ip, uint16_t port,
+                        int queueSize = TcpServer::CONN_QUEUE_SIZE);
+
+    /**
+     * Starts listening for incoming connections.
+     * See TcpServer::startListening.
+     */
+    void startListening(const SockAddr &addr, int queueSize = TcpServer::CONN_QUEUE_SIZE);
+
+    /**
+     * Stops listening for incoming connections.
+     */
+    void stopListening();
+
+    /**
+     * Accepts incoming connections, reads incoming data and calls payload callback.
+     * @param   time    Time to wait in ms (0 - don't wait, -1 - indefinitely)
+     */
+    void poll(int time);
+
+    /**
+     * @return the underlying TCP server.
+     */
+    inline TcpServer &getServer() { return m_Server; }
+
+    /**
+     * Sends a payload with a frame header. May block.
+     * Throws on failure. The socket will be closed in that case.
+     * @param   socket  Client socket
+     * @param   payload Payload to send
+     */
+    void sendPayload(TcpClientSocket &socket, appfw::span<const uint8_t> payload);
+
+    /**
+     * Sets callback that is called when a new client is accepted.
+     * Must not throw.
+     */
+    void setConnAcceptedCallback(const ConnAcceptedCallback &fn);
+
+    /**
+     * Sets callback that is called when a connection is closed.
+     * Must not throw.
+     */
+    void setConnClosedCallback(const ConnClosedCallback &fn);
+
+    /**
+     * Sets callback that is called when a payload is received.
+     * Must not throw.
+     */
+    void setPayloadCallback(const PayloadCallback &fn);
+
+private:
+    struct Connection {
+        TcpClientSocketPtr socket;
+        DatagramParser parser;
+        size_t index = 0;
+    };
+
+    TcpServer m_Server;
+    std::unordered_map<TcpClientSocket *, std::unique_ptr<Connection>> m_Connections;
+    std::shared_ptr<DatagramBufferPool> m_pBufferPool;
+    std::vector<uint8_t> m_SendBuffer;
+
+    uint8_t m_Magic[DatagramParser::MAX_MAGIC_SIZE];
+    uint16_t m_uMagicSize = 0;
+    uint32_t m_uMaxPayloadSize = 0;
+
+    ConnAcceptedCallback m_fnAcceptedCb;
+    ConnClosedCallback m_fnClosedCb;
+    PayloadCallback m_fnPayloadCb;
+
+    void onConnAccepted(size_t index, TcpClientSocketPtr socket);
+    void onConnClosed(size_t index, TcpClientSocketPtr socket, SocketCloseReason reason);
+    void onReadyRead(size_t index, TcpClientSocketPtr socket);
+};
+
+} // namespace appfw
+
+#endif
@@ -1,5 +1,6 @@
 #ifndef APPFW_NETWORK_IP_ADDRESS_H
 #define APPFW_NETWORK_IP_ADDRESS_H
+#include <array>
 #include <cstdint>
 
 namespace appfw {
@@ -22,6 +23,51 @@ static constexpr IPAddress4 ADDR4_ANY = 0x0000'0000;
 static constexpr IPAddress4 ADDR4_LOOPBACK = 0x7F00'0001;
 static constexpr IPAddress4 ADDR4_BROADCAST = 0xFFFF'FFFF;
 
+struct IPAddress6 {
+    //! IP address in network byte order
+    std::array<uint8_t, 16> addr;
+
+    IPAddress6() = default;
+
+    /**
+     * Constructs an IP address from bytes in network byte order.
+     * ::1 == {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1}
+     */
+    constexpr inline IPAddress6(const std::array<uint8_t, 16> &a) : addr(a) {}
+
+    /**
+     * @return whether it's an IPv4-mapped address (::ffff:a.b.c.d)
+     */
+    constexpr inline bool isV4Mapped() const {
+        for (int i = 0; i < 10; i++) {
+            if (addr[i] != 0) {
+                return false;
+            }
+        }
+
+        return addr[10] == 0xFF && addr[11] == 0xFF;
+    }
+
+    /**
+     * @return the IPv4 part of an IPv4-mapped address
+     */
+    constexpr inline IPAddress4 toV4Mapped() const {
+        return IPAddress4((uint32_t)addr[12] << 24 | (uint32_t)addr[13] << 16 |
+                          (uint32_t)addr[14] << 8 | (uint32_t)addr[15]);
+    }
+
+    /**
+     * @return an IPv4-mapped address (::ffff:a.b.c.d)
+     */
+    static constexpr inline IPAddress6 fromV4Mapped(IPAddress4 ip) {
+        return IPAddress6({0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xFF, 0xFF, (uint8_t)(ip.addr >> 24),
+                           (uint8_t)(ip.addr >> 16), (uint8_t)(ip.addr >> 8), (uint8_t)ip.addr});
+    }
+};
+
+static constexpr IPAddress6 ADDR6_ANY = IPAddress6(std::array<uint8_t, 16>{});
+static constexpr IPAddress6 ADDR6_LOOPBACK = IPAddress6({0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1});
+
 } // namespace appfw 
 
 #endif
@@ -0,0 +1,155 @@
+#ifndef APPFW_NETWORK_NET_METRICS_H
+#define APPFW_NETWORK_NET_METRICS_H
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <string>
+#include <appfw/network/socket.h>
+#include <appfw/utils.h>
+
+namespace appfw {
+
+//! Number of SocketCloseReason values
+constexpr size_t SOCKET_CLOSE_REASON_COUNT = (size_t)SocketCloseReason::InvalidData + 1;
+
+/**
+ * @return name of the close reason
+ */
+const char *getCloseReasonName(SocketCloseReason reason);
+
+/**
+ * A counter updated with relaxed atomics. Can be read from any thread.
+ * Values read together may be slightly inconsistent with each other.
+ */
+class MetricCounter {
+public:
+    inline void add(uint64_t value) { m_uValue.fetch_add(value, std::memory_order_relaxed); }
+    inline void set(uint64_t value) { m_uValue.store(value, std::memory_order_relaxed); }
+    inline uint64_t get() const { return m_uValue.load(std::memory_order_relaxed); }
+
+    //! Sets the value if it's larger than the current one. Single writer only.
+    inline void setMax(uint64_t value) {
+        if (value > get()) {
+            set(value);
+        }
+    }
+
+private:
+    std::atomic<uint64_t> m_uValue = 0;
+};
+
+/**
+ * Traffic counters of a single connection.
+ */
+struct ConnMetrics {
+    struct Snapshot {
+        uint64_t uBytesIn = 0;
+        uint64_t uBytesOut = 0;
+        uint64_t uRecvCalls = 0; //!< Successful reads that returned data
+        uint64_t uSendCalls = 0; //!< Successful sends that sent data
+    };
+
+    MetricCounter bytesIn;
+    MetricCounter bytesOut;
+    MetricCounter recvCalls;
+    MetricCounter sendCalls;
+
+    /**
+     * @return current values of the counters
+     */
+    Snapshot getSnapshot() const;
+};
+
+/**
+ * Counters of a TcpServer. Updated by the thread that polls the server.
+ * Registered in a global list while the server exists to be printed by net_stats.
+ */
+class ServerMetrics : NoMove {
+public:
+    struct Snapshot {
+        uint64_t uAccepts = 0;
+        uint64_t uRejects = 0;          //!< Connections over the client limit or out of descriptors
+        uint64_t uCloses[SOCKET_CLOSE_REASON_COUNT] = {};
+        uint64_t uConnections = 0;      //!< Connected clients after the last poll
+        ConnMetrics::Snapshot traffic;  //!< Sum of all connections
+        uint64_t uSendQueueBytes = 0;   //!< Bytes queued by all clients at the last poll
+        uint64_t uMaxSendQueueBytes = 0;
+        uint64_t uPolls = 0;
+        uint64_t uPollEvents = 0;       //!< Sum of events returned by each poll
+        uint64_t uMaxPollEvents = 0;
+        uint64_t uPollProcessTimeUs = 0; //!< Time spent in poll excluding waiting
+        uint64_t uMaxPollProcessTimeUs = 0;
+
+        //! @returns average number of events per poll
+        inline double getAvgPollEvents() const {
+            return uPolls != 0 ? (double)uPollEvents / uPolls : 0;
+        }
+
+        //! @returns average processing time of a poll in us
+        inline double getAvgPollProcessTime() const {
+            return uPolls != 0 ? (double)uPollProcessTimeUs / uPolls : 0;
+        }
+    };
+
+    MetricCounter accepts;
+    MetricCounter rejects;
+    MetricCounter closes[SOCKET_CLOSE_REASON_COUNT];
+    MetricCounter connections;
+    ConnMetrics traffic;
+    MetricCounter sendQueueBytes;
+    MetricCounter maxSendQueueBytes;
+    MetricCounter polls;
+    MetricCounter pollEvents;
+    MetricCounter maxPollEvents;
+    MetricCounter pollProcessTimeUs;
+    MetricCounter maxPollProcessTimeUs;
+
+    ServerMetrics();
+    ~ServerMetrics();
+
+    /**
+     * Sets the name displayed by net_stats.
+     */
+    void setName(std::string_view name);
+
+    /**
+     * @return the name set in setName. Call from the polling thread or from forEach.
+     */
+    inline const std::string &getName() const { return m_Name; }
+
+    /**
+     * @return current values of the counters
+     */
+    Snapshot getSnapshot() const;
+
+    /**
+     * Sets all counters to zero. Increments done at the same time may be lost.
+     */
+    void reset();
+
+    /**
+     * Calls fn(ServerMetrics &) for every existing instance. Thread-safe.
+     */
+    template <typename T>
+    static void forEach(T fn);
+
+private:
+    std::string m_Name;
+
+    static std::mutex &getListMutex();
+    static std::set<ServerMetrics *> &getList();
+};
+
+template <typename T>
+inline void ServerMetrics::forEach(T fn) {
+    std::lock_guard lock(getListMutex());
+
+    for (ServerMetrics *i : getList()) {
+        fn(*i);
+    }
+}
+
+} // namespace appfw
+
+#endif
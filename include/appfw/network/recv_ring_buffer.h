@@ -0,0 +1,99 @@
+#ifndef APPFW_NETWORK_RECV_RING_BUFFER_H
+#define APPFW_NETWORK_RECV_RING_BUFFER_H
+#include <cstdint>
+#include <vector>
+#include <appfw/span.h>
+
+namespace appfw {
+
+/**
+ * A fixed-capacity byte ring buffer for received socket data.
+ * Data is exposed as up to two contiguous regions so it can be filled with a single
+ * vectored read and parsed in place without copying.
+ * Memory is allocated on first use.
+ */
+class RecvRingBuffer {
+public:
+    //! Default capacity in bytes
+    static constexpr size_t DEF_CAPACITY = 32 * 1024;
+
+    //! Up to two contiguous regions of the buffer, in order.
+    template <typename T>
+    struct View {
+        appfw::span<T> first;
+        appfw::span<T> second;
+
+        inline size_t size() const { return first.size() + second.size(); }
+        inline bool empty() const { return size() == 0; }
+    };
+
+    using ReadView = View<const uint8_t>;
+    using WriteView = View<uint8_t>;
+
+    RecvRingBuffer() = default;
+    explicit RecvRingBuffer(size_t capacity);
+
+    /**
+     * Sets the capacity. Buffered data is discarded.
+     */
+    void setCapacity(size_t capacity);
+
+    /**
+     * @return the capacity in bytes.
+     */
+    inline size_t capacity() const { return m_uCapacity; }
+
+    /**
+     * @return number of buffered bytes.
+     */
+    inline size_t size() const { return m_uSize; }
+
+    /**
+     * @return number of bytes that can be written.
+     */
+    inline size_t freeSpace() const { return m_uCapacity - m_uSize; }
+
+    inline bool empty() const { return m_uSize == 0; }
+    inline bool full() const { return m_uSize == m_uCapacity; }
+
+    /**
+     * @return view of buffered data. Invalidated by consume() and commit().
+     */
+    ReadView readable() const;
+
+    /**
+     * Removes N bytes from the front of the buffer.
+     */
+    void consume(size_t n);
+
+    /**
+     * Copies up to buf.size() bytes into buf and consumes them.
+     * @return number of bytes copied.
+     */
+    size_t read(appfw::span<uint8_t> buf);
+
+    /**
+     * @return view of free space. Allocates the memory if needed.
+     */
+    WriteView writable();
+
+    /**
+     * Marks N bytes written into writable() view as buffered data.
+     */
+    void commit(size_t n);
+
+    /**
+     * Discards all buffered data.
+     */
+    void clear();
+
+private:
+    std::vector<uint8_t> m_Data;
+    size_t m_uCapacity = DEF_CAPACITY;
+    size_t m_uHead = 0;
+    size_t m_uSize = 0;
+};
+
+} // namespace appfw
+
+#endif
@@ -1,9 +1,11 @@
 #ifndef APPFW_NETWORK_SOCK_ADD_H
 #define APPFW_NETWORK_SOCK_ADD_H
 #include <string>
+#include <string_view>
 #include <list>
 #include <appfw/network/ip_address.h>
 
+struct sockaddr;
 struct sockaddr_in;
 
 namespace appfw {
@@ -25,6 +27,92 @@ struct SockAddr4 {
     static SockAddr4 fromSockAddrStruct(const sockaddr_in &sa);
 };
 
+enum class AddressFamily
+{
+    Unspec = 0, //!< No address
+    IPv4,
+    IPv6,
+    Unix, //!< Unix domain socket (AF_UNIX)
+};
+
+/**
+ * A socket address of any supported family.
+ * Stores the native sockaddr struct so it can be passed to socket functions directly.
+ */
+class SockAddr {
+public:
+    //! Size of the storage. Fits any sockaddr struct (same as sockaddr_storage).
+    static constexpr size_t STORAGE_SIZE = 128;
+
+    SockAddr() = default;
+
+    //! Constructs an IPv4 address
+    SockAddr(const SockAddr4 &addr);
+
+    //! Constructs an IPv4 address
+    SockAddr(IPAddress4 ip, uint16_t port);
+
+    //! Constructs an IPv6 address
+    SockAddr(const IPAddress6 &ip, uint16_t port, uint32_t scopeId = 0);
+
+    //! Constructs a Unix domain socket address. Throws if the path is too long.
+    //! Path starting with a null character is in the abstract namespace (Linux only).
+    //! Not supported on Windows.
+    static SockAddr fromUnixPath(std::string_view path);
+
+    //! @returns the address family
+    inline AddressFamily getFamily() const { return m_Family; }
+
+    //! @returns whether the address is IPv4
+    inline bool isIPv4() const { return m_Family == AddressFamily::IPv4; }
+
+    //! @returns whether the address is IPv6
+    inline bool isIPv6() const { return m_Family == AddressFamily::IPv6; }
+
+    //! @returns whether the address is a Unix domain socket
+    inline bool isUnix() const { return m_Family == AddressFamily::Unix; }
+
+    //! @returns the port in host byte order
+    uint16_t getPort() const;
+
+    //! @returns the IPv4 address. Address must be IPv4.
+    SockAddr4 toSockAddr4() const;
+
+    //! @returns the IPv6 address. Address must be IPv6.
+    IPAddress6 getIPAddress6() const;
+
+    //! @returns the IPv6 scope ID. Address must be IPv6.
+    uint32_t getScopeId() const;
+
+    //! @returns the path of a Unix domain socket. Empty for unnamed sockets.
+    //! Address must be Unix.
+    std::string getUnixPath() const;
+
+    //! @returns IPv4 address if it's IPv4-mapped IPv6 address. Otherwise returns the same address.
+    SockAddr unmapped() const;
+
+    //! Converts address to a string. IPv6 addresses are in brackets: [::1]:port.
+    //! Unix addresses are unix:path, abstract ones are unix:@name.
+    std::string toString() const;
+
+    //! @returns the native sockaddr struct
+    inline const sockaddr *getSockAddrStruct() const {
+        return reinterpret_cast<const sockaddr *>(m_Storage);
+    }
+
+    //! @returns the size of the native sockaddr struct
+    inline int getSockAddrSize() const { return m_iSize; }
+
+    //! Converts a native sockaddr struct to SockAddr.
+    //! Unsupported families are converted to an Unspec address.
+    static SockAddr fromSockAddrStruct(const sockaddr *sa, size_t size);
+
+private:
+    alignas(8) uint8_t m_Storage[STORAGE_SIZE] = {};
+    int m_iSize = 0;
+    AddressFamily m_Family = AddressFamily::Unspec;
+};
+
 enum class SockType
 {
     Any = 0,
@@ -33,11 +121,20 @@ enum class SockType
 };
 
 /**
- * Resolves hostname and port into a list of addresses.
+ * Resolves hostname and port into a list of addresses of any family.
+ * See getaddrinfo(3).
+ * @param   family  Family of returned addresses (Unspec - any)
+ */
+std::list<SockAddr> resolveHostName(const std::string &hostname, const std::string &port,
+                                    SockType type = SockType::Any,
+                                    AddressFamily family = AddressFamily::Unspec);
+
+/**
+ * Resolves hostname and port into a list of IPv4 addresses.
  * See getaddrinfo(3).
  */
-std::list<SockAddr4> resolveHostName(const std::string &hostname, const std::string &port,
-                                     SockType type = SockType::Any);
+std::list<SockAddr4> resolveHostName4(const std::string &hostname, const std::string &port,
+                                      SockType type = SockType::Any);
 
 } // namespace appfw 
 
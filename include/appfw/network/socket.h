@@ -13,6 +13,9 @@ constexpr SocketFile NULL_SOCKET = (SocketFile)(~(0));
 #elif PLATFORM_UNIX
 using SocketFile = int;
 constexpr SocketFile NULL_SOCKET = -1;
+
+//! Maximum number of file descriptors passed over a Unix domain socket in one call.
+constexpr size_t MAX_PASSED_FDS = 16;
 #else
 #error
 #endif
@@ -24,6 +27,7 @@ enum class SocketCloseReason
     TimeOut,     //!< Timed out
     User,        //!< Closed by user
     Shutdown,    //!< Server is shutting down
+    InvalidData, //!< Received data couldn't be parsed
 };
 
 enum class NetClientStatus
@@ -33,6 +37,17 @@ enum class NetClientStatus
     Connected,  //!< Connection established
 };
 
+enum class NetBackend
+{
+    Poll,    //!< poll(2) or WSAPoll
+    IoUring, //!< io_uring with multishot accept and recv (Linux 6.0+)
+};
+
+/**
+ * @return whether the backend is compiled in and supported by the system
+ */
+bool isNetBackendSupported(NetBackend backend);
+
 /**
  * RAII wrapper for sockets.
  */
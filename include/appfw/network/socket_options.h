@@ -0,0 +1,54 @@
+#ifndef APPFW_NETWORK_SOCKET_OPTIONS_H
+#define APPFW_NETWORK_SOCKET_OPTIONS_H
+#include <optional>
+
+namespace appfw {
+
+/**
+ * Options applied to a socket with setsockopt.
+ * Only set options are applied, others are left at system defaults.
+ * Options not supported by the platform are ignored.
+ */
+struct SocketOptions {
+    //! Disables Nagle's algorithm (TCP_NODELAY). Reduces latency of small messages.
+    std::optional<bool> noDelay;
+
+    //! Only sends full frames until uncorked (TCP_CORK). Linux only.
+    std::optional<bool> cork;
+
+    //! Size of the kernel send buffer in bytes (SO_SNDBUF)
+    std::optional<int> sendBufferSize;
+
+    //! Size of the kernel receive buffer in bytes (SO_RCVBUF)
+    std::optional<int> recvBufferSize;
+
+    //! Enables keep-alive probes (SO_KEEPALIVE)
+    std::optional<bool> keepAlive;
+
+    //! Idle time in seconds before first keep-alive probe (TCP_KEEPIDLE)
+    std::optional<int> keepAliveIdle;
+
+    //! Time in seconds between keep-alive probes (TCP_KEEPINTVL)
+    std::optional<int> keepAliveInterval;
+
+    //! Number of failed probes before the connection is dropped (TCP_KEEPCNT)
+    std::optional<int> keepAliveCount;
+
+    //! Time in microseconds to busy-poll the device queue on blocking reads (SO_BUSY_POLL).
+    //! Linux only.
+    std::optional<int> busyPoll;
+
+    inline SocketOptions &setNoDelay(bool v) { noDelay = v; return *this; }
+    inline SocketOptions &setCork(bool v) { cork = v; return *this; }
+    inline SocketOptions &setSendBufferSize(int v) { sendBufferSize = v; return *this; }
+    inline SocketOptions &setRecvBufferSize(int v) { recvBufferSize = v; return *this; }
+    inline SocketOptions &setKeepAlive(bool v) { keepAlive = v; return *this; }
+    inline SocketOptions &setKeepAliveIdle(int v) { keepAliveIdle = v; return *this; }
+    inline SocketOptions &setKeepAliveInterval(int v) { keepAliveInterval = v; return *this; }
+    inline SocketOptions &setKeepAliveCount(int v) { keepAliveCount = v; return *this; }
+    inline SocketOptions &setBusyPoll(int v) { busyPoll = v; return *this; }
+};
+
+} // namespace appfw
+
+#endif
@@ -0,0 +1,169 @@
+#ifndef APPFW_NETWORK_TCP_CLIENT_H
+#define APPFW_NETWORK_TCP_CLIENT_H
+#include <vector>
+#include <appfw/network/recv_ring_buffer.h>
+#include <appfw/network/socket.h>
+#include <appfw/network/socket_options.h>
+#include <appfw/span.h>
+#include <appfw/timer.h>
+
+namespace appfw {
+
+/**
+ * A TCP client for IPv4 and IPv6. Can also connect to a Unix domain socket.
+ */
+class TcpClient {
+public:
+    //! Default time-out in ms
+    static constexpr int DEF_TIMEOUT = 5000;
+
+    /**
+     * @return The status of the socket
+     */
+    inline NetClientStatus getStatus() { return m_Status; }
+
+    /**
+     * @return The address of remote server
+     */
+    inline const SockAddr &getRemoteAddr() { return m_Addr; }
+
+    /**
+     * @return the native socket (e.g. for getsockopt) or 0 if closed
+     */
+    inline SocketFile getNativeSocket() { return m_fd.get(); }
+
+    /**
+     * Sets options applied to the socket in connect.
+     * If the socket is open, applies them immediately. Throws on failure.
+     */
+    void setSocketOptions(const SocketOptions &opts);
+
+    /**
+     * @return options set in setSocketOptions
+     */
+    inline const SocketOptions &getSocketOptions() { return m_SocketOptions; }
+
+    /**
+     * Connects the client to a server. Throws on error or if not closed.
+     * @param   addr    Address of the server
+     * @param   timeout Time-out in ms
+     */
+    void connect(const SockAddr &addr, int timeout = DEF_TIMEOUT);
+
+    /**
+     * Updates the status of the socket.
+     * Throws and closes on error. Use TcpClientPool to update many clients at once.
+     * @param   time    Time to wait in ms (0 - don't wait, -1 - indefinitely)
+     * @return  true if data is available to read
+     */
+    bool updateStatus(int time);
+
+    /**
+     * Disconnects and closes the socket.
+     */
+    void close();
+
+    /**
+     * @return the reason why the socket was closed last time
+     */
+    inline SocketCloseReason getCloseReason() { return m_CloseReason; }
+
+    /**
+     * Reads up to N bytes from the socket. Non-blocking.
+     * Throws on failure. The socket will be closed in that case.
+     * @param   buf     Buffer to put the data into.
+     * @return  Number of bytes read. Returns 0 if nothing to read. Returns 0 if EOF.
+     */
+    int read(appfw::span<uint8_t> buf);
+
+    /**
+     * Reads all available data into the receive buffer. Non-blocking.
+     * Uses a single vectored read per buffer fill and stops when the socket is drained
+     * or the buffer is full. On EOF the socket is closed.
+     * Throws on failure. The socket will be closed in that case.
+     * @return  Number of bytes received.
+     */
+    size_t receive();
+
+#if PLATFORM_UNIX
+    /**
+     * Same as receive() but also receives file descriptors passed over a Unix domain socket.
+     * Received descriptors are appended to fds, the caller must close them.
+     * @return  Number of bytes received.
+     */
+    size_t receiveWithFds(std::vector<int> &fds);
+#endif
+
+    /**
+     * @return the receive buffer filled by receive(). Consume data after processing it.
+     */
+    inline RecvRingBuffer &getRecvBuffer() { return m_RecvBuffer; }
+
+    /**
+     * Sends up to N bytes of data in the buffer.
+     * Throws on failure. The socket will be closed in that case.
+     * @param   buf     Data to send
+     * @return  Number of bytes send
+     */
+    int write(appfw::span<const uint8_t> buf);
+
+#if PLATFORM_UNIX
+    /**
+     * Sends up to N bytes of data with file descriptors attached (SCM_RIGHTS).
+     * Unix domain sockets only. Up to MAX_PASSED_FDS descriptors, data must not be empty.
+     * Throws on failure. The socket will be closed in that case.
+     * @param   buf     Data to send
+     * @param   fds     Descriptors to pass. Only sent if some data was sent.
+     * @return  Number of bytes send
+     */
+    int writeWithFds(appfw::span<const uint8_t> buf, appfw::span<const int> fds);
+#endif
+
+    /**
+     * Sets the maximum time writeAll can wait for the socket to become writable.
+     * If it's exceeded, the connection is closed.
+     * @param   time    Time in ms (0 - no time-out)
+     */
+    inline void setWriteTimeout(int time) { m_iWriteTimeout = time; }
+
+    /**
+     * Sends all data in the buffer. May block up to the write time-out.
+     * Throws on failure. The socket will be closed in that case.
+     * @param   buf     Data to send
+     */
+    void writeAll(appfw::span<const uint8_t> buf);
+
+private:
+    NetClientStatus m_Status = NetClientStatus::Closed;
+    SockAddr m_Addr;
+    SockFd m_fd;
+    SocketOptions m_SocketOptions;
+    SocketCloseReason m_CloseReason = SocketCloseReason::User;
+    int m_iTimeOut = 0;
+    int m_iWriteTimeout = 0;
+    Timer m_Timer;
+    RecvRingBuffer m_RecvBuffer;
+
+    void close(SocketCloseReason reason);
+
+    //! @returns the poll events to wait for in the current status
+    short getPollEvents();
+
+    /**
+     * Updates the status using events returned by poll. Throws and closes on error.
+     * @return  true if data is available to read
+     */
+    bool processPollEvents(int revents);
+
+    //! Throws and closes if the connection time-out has expired.
+    void checkConnectTimeOut();
+
+    size_t receiveInternal(std::vector<int> *fds);
+    int handleError(std::string_view callName);
+
+    friend class TcpClientPool;
+};
+
+} // namespace appfw 
+
+#endif
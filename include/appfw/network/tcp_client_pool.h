@@ -0,0 +1,105 @@
+#ifndef APPFW_NETWORK_TCP_CLIENT_POOL_H
+#define APPFW_NETWORK_TCP_CLIENT_POOL_H
+#include <functional>
+#include <memory>
+#include <appfw/network/tcp_client.h>
+#include <appfw/timer_wheel.h>
+#include <appfw/utils.h>
+
+namespace appfw {
+
+using TcpClientPtr = std::shared_ptr<TcpClient>;
+
+/**
+ * Drives many outgoing TCP connections from a single thread with one poll call.
+ * Connection time-outs are kept in a timer wheel so poll only wakes up when one expires.
+ *
+ * Clients are closed by calling close() on them or by errors. Closed clients are removed
+ * at the end of poll(). Indexes passed to callbacks are only valid until then.
+ */
+class TcpClientPool : NoMove {
+public:
+    using ConnectedCallback = std::function<void(size_t index, TcpClientPtr client)>;
+    using ReadyReadCallback = std::function<void(size_t index, TcpClientPtr client)>;
+    using ClosedCallback = std::function<void(size_t index, TcpClientPtr client, SocketCloseReason reason)>;
+
+    TcpClientPool();
+    ~TcpClientPool();
+
+    /**
+     * Creates a client, starts connecting and adds it to the pool.
+     * Throws if connect fails immediately.
+     * @param   addr    Address of the server
+     * @param   timeout Connection time-out in ms
+     * @return  the new client
+     */
+    TcpClientPtr connect(const SockAddr &addr, int timeout = TcpClient::DEF_TIMEOUT);
+
+    /**
+     * Adds a connecting or a connected client to the pool. Throws if the client is closed.
+     * The client must not be used with updateStatus while it is in the pool.
+     */
+    void add(TcpClientPtr client);
+
+    /**
+     * Returns the number of clients in the pool.
+     * This number is updated during poll. Don't save it.
+     */
+    size_t getClientCount();
+
+    /**
+     * Returns a client.
+     * @param   idx     Client idx [0; getClientCount())
+     */
+    TcpClientPtr getClient(size_t idx);
+
+    /**
+     * @return the timer wheel updated during poll. Can be used for custom timers.
+     */
+    inline TimerWheel &getTimerWheel() { return m_Timers; }
+
+    /**
+     * Finishes connecting, checks for incoming data and runs expired timers.
+     * Doesn't wait indefinitely if the pool has no clients and no timers.
+     * Throws if poll fails.
+     * @param   time    Time to wait in ms (0 - don't wait, -1 - indefinitely).
+     *                  Returns earlier if a timer expires.
+     */
+    void poll(int time);
+
+    /**
+     * Sets callback that is called from poll() when a client becomes connected.
+     * Must not throw.
+     */
+    inline void setConnectedCallback(const ConnectedCallback &fn) { m_fnConnectedCb = fn; }
+
+    /**
+     * Sets callback that is called when data is available to read.
+     * Use receive() or read() of the client. Must not throw.
+     */
+    inline void setReadyReadCallback(const ReadyReadCallback &fn) { m_fnReadyReadCb = fn; }
+
+    /**
+     * Sets callback that is called from poll() for any client that is closed (even manually)
+     * right before it is removed from the pool.
+     * Must not throw.
+     */
+    inline void setClosedCallback(const ClosedCallback &fn) { m_fnClosedCb = fn; }
+
+private:
+    struct Data;
+
+    TimerWheel m_Timers;
+    std::unique_ptr<Data> m_Data;
+    ConnectedCallback m_fnConnectedCb;
+    ReadyReadCallback m_fnReadyReadCb;
+    ClosedCallback m_fnClosedCb;
+
+    void processEvents(size_t idx, int revents);
+    void removeClosedClients();
+    void onClientClosed(size_t idx);
+};
+
+} // namespace appfw
+
+#endif
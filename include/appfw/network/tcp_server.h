@@ -0,0 +1,423 @@
+#ifndef APPFW_NETWORK_TCP_SERVER_H
+#define APPFW_NETWORK_TCP_SERVER_H
+#include <memory>
+#include <functional>
+#include <vector>
+#include <appfw/filesystem.h>
+#include <appfw/network/net_metrics.h>
+#include <appfw/network/recv_ring_buffer.h>
+#include <appfw/network/socket.h>
+#include <appfw/network/socket_options.h>
+#include <appfw/span.h>
+#include <appfw/timer_wheel.h>
+
+namespace appfw {
+
+namespace platsock {
+class SendQueue;
+}
+
+class TcpClientSocket;
+using TcpClientSocketPtr = std::shared_ptr<TcpClientSocket>;
+
+/**
+ * A TCP server for IPv4 and IPv6 with callbacks.
+ * A server listening on an IPv6 address also accepts IPv4 clients (dual-stack)
+ * unless setIPv6Only(true) is called.
+ * It can also listen on a Unix domain socket address for local IPC. A socket file left by
+ * a server that didn't stop cleanly is replaced on listen, listening on a path of a live
+ * server fails. The file is removed on stop. TCP socket options must not be set in that case.
+ */
+class TcpServer {
+public:
+    using ConnAcceptedCallback = std::function<void(size_t index, TcpClientSocketPtr socket)>;
+    using ConnClosedCallback = std::function<void(size_t index, TcpClientSocketPtr socket, SocketCloseReason reason)>;
+    using ReadyReadCallback = std::function<void(size_t index, TcpClientSocketPtr socket)>;
+
+    /**
+     * Default size of the pending connections queue.
+     * The system may limit it (net.core.somaxconn on Linux).
+     */
+    static constexpr int CONN_QUEUE_SIZE = 1024;
+
+    /**
+     * Default maximum number of connections accepted in one poll.
+     */
+    static constexpr int DEF_ACCEPT_BUDGET = 64;
+
+    /**
+     * Time in ms accepting is paused for when the process is out of file descriptors
+     * or memory and a pending connection couldn't be dropped.
+     */
+    static constexpr int ACCEPT_BACKOFF_TIME = 100;
+
+    TcpServer();
+    ~TcpServer();
+
+    /**
+     * @return whether the server is listening for incoming connections
+     */
+    inline bool isListening() { return m_fd.get() != 0; }
+
+    /**
+     * Starts listening for incoming connections.
+     * Throws if already open or fails to open.
+     * @param   ip          IP address of interface (can be ADDR4_ANY)
+     * @param   port        Listen port
+     * @param   queueSize   Size of incoming ocnnections queue
+     */
+    void startListening(IPAddress4 ip, uint16_t port, int queueSize = CONN_QUEUE_SIZE);
+
+    /**
+     * Starts listening for incoming connections.
+     * Throws if already open or fails to open.
+     * @param   addr        Address of interface (e.g. ADDR6_ANY for all IPv4 and IPv6 interfaces)
+     * @param   queueSize   Size of incoming ocnnections queue
+     */
+    void startListening(const SockAddr &addr, int queueSize = CONN_QUEUE_SIZE);
+
+    /**
+     * Stops listening for incoming connections.
+     */
+    void stopListening();
+
+    /**
+     * Sets options applied to the listen socket in startListening and to every accepted socket.
+     * Connections that fail to apply them are dropped.
+     */
+    inline void setSocketOptions(const SocketOptions &opts) { m_SocketOptions = opts; }
+
+    /**
+     * @return options set in setSocketOptions
+     */
+    inline const SocketOptions &getSocketOptions() { return m_SocketOptions; }
+
+    /**
+     * Sets whether a server listening on an IPv6 address rejects IPv4 clients (IPV6_V6ONLY).
+     * Applies on next startListening.
+     */
+    inline void setIPv6Only(bool state) { m_bIPv6Only = state; }
+
+    /**
+     * Sets the maximum number of connections accepted in one poll so that a connection flood
+     * doesn't starve reads. The rest is accepted during next polls.
+     * With io_uring the kernel accepts connections itself and the budget is not used.
+     * @param   count   Number of connections (0 - unlimited)
+     */
+    inline void setAcceptBudget(int count) { m_iAcceptBudget = count; }
+
+    /**
+     * Sets the maximum number of connected clients. Connections over the limit are accepted,
+     * sent the reject message and closed without calling any callbacks.
+     * Clients closed with TcpClientSocket::close() don't count even before they are removed.
+     * @param   count   Number of clients (0 - unlimited)
+     */
+    inline void setMaxClients(size_t count) { m_uMaxClients = count; }
+
+    /**
+     * Sets the data sent to rejected connections. Sent without blocking, may be cut short.
+     */
+    inline void setRejectMessage(appfw::span<const uint8_t> msg) {
+        m_RejectMessage.assign(msg.begin(), msg.end());
+    }
+
+    /**
+     * Sets the backend used to wait for events. Applies on next startListening.
+     * io_uring receives data into kernel-selected buffers without a syscall per read.
+     * Falls back to Poll if the backend is not supported or for Unix domain sockets.
+     */
+    inline void setBackend(NetBackend backend) { m_Backend = backend; }
+
+    /**
+     * @return the backend in use
+     */
+    inline NetBackend getBackend() { return m_ActiveBackend; }
+
+    /**
+     * @return address passed to startListening
+     */
+    inline const SockAddr &getListenAddress() { return m_ListenAddr; }
+
+    /**
+     * Sets the time after which a client that hasn't sent anything is closed with TimeOut.
+     * Applies to new connections.
+     * @param   time    Time in ms (0 - no time-out)
+     */
+    inline void setIdleTimeout(int time) { m_iIdleTimeout = time; }
+
+    /**
+     * Sets the maximum time writeAll can wait for the socket to become writable.
+     * Also limits the time the send queue can go without progress.
+     * If it's exceeded, the connection is closed with TimeOut. Applies to new connections.
+     * @param   time    Time in ms (0 - no time-out)
+     */
+    inline void setWriteTimeout(int time) { m_iWriteTimeout = time; }
+
+    /**
+     * @return the timer wheel updated during poll. Can be used for custom timers.
+     */
+    inline TimerWheel &getTimerWheel() { return m_Timers; }
+
+    /**
+     * @return counters of the server. Can be read from any thread.
+     */
+    inline const ServerMetrics &getMetrics() { return m_Metrics; }
+
+    /**
+     * Accepts incoming connections, reads incoming data, sends queued data
+     * and runs expired timers.
+     * @param   time    Time to wait in ms (0 - don't wait, -1 - indefinitely).
+     *                  Returns earlier if a timer expires.
+     */
+    void poll(int time);
+
+    /**
+     * Returns the number of connected clients.
+     * This number is updated during poll. Don't save it.
+     */
+    size_t getConnectedClients();
+
+    /**
+     * Returns a client socket.
+     * @param   idx     Client idx [0; getConnectedClients())
+     */
+    TcpClientSocketPtr getSocket(size_t idx);
+
+    /**
+     * Sends all data in the buffer to all clients. May block.
+     * Throws on failure. The socket will be closed in that case.
+     * @param   buf     Data to send
+     */
+    void sendToAll(appfw::span<uint8_t> buf);
+
+    /**
+     * Sets callback that is called when a new client is accepted.
+     * Must not throw.
+     */
+    void setConnAcceptedCallback(const ConnAcceptedCallback &fn);
+
+    /**
+     * Sets callback that is called when a connection is closed.
+     * It is caled from poll() for any socket that is lcosed (even manually).
+     * Must not throw.
+     */
+    void setConnClosedCallback(const ConnClosedCallback &fn);
+
+    /**
+     * Sets callback that is called when a data is received.
+     * Must not throw.
+     */
+    void setReadyReadCallback(const ReadyReadCallback &fn);
+
+private:
+    struct Data;
+
+    appfw::SockFd m_fd;
+    SockAddr m_ListenAddr;
+    SocketOptions m_SocketOptions;
+    bool m_bIPv6Only = false;
+    bool m_bOwnsUnixSocketFile = false;
+    NetBackend m_Backend = NetBackend::Poll;
+    NetBackend m_ActiveBackend = NetBackend::Poll;
+    int m_iIdleTimeout = 0;
+    int m_iWriteTimeout = 0;
+    int m_iAcceptBudget = DEF_ACCEPT_BUDGET;
+    size_t m_uMaxClients = 0;
+    std::vector<uint8_t> m_RejectMessage;
+    TimerWheel m_Timers;
+    ServerMetrics m_Metrics;
+    std::unique_ptr<Data> m_Data;
+    ConnAcceptedCallback m_fnAcceptedCb;
+    ConnClosedCallback m_fnClosedCb;
+    ReadyReadCallback m_fnReadyReadCb;
+
+    void pollSockets(int time);
+    void pollIoUring(int time);
+    void acceptConnections();
+    void acceptConnection(SocketFile sock, const SockAddr &addr);
+    void rejectConnection(SocketFile sock);
+    bool dropPendingConnection();
+    void pauseAccepting();
+    void onReadyRead(size_t idx);
+    void onReadyWrite(size_t idx);
+    void updateSendQueue(size_t idx);
+    void onConnectionClosed(size_t idx);
+    void removeConnection(size_t idx);
+};
+
+class TcpClientSocket {
+public:
+    //! Passed as length to sendFile to send until the end of the file.
+    static constexpr uint64_t FILE_END = UINT64_MAX;
+
+    TcpClientSocket();
+    ~TcpClientSocket();
+
+    /**
+     * @return whether the socket is open or not
+     */
+    inline bool isOpen() { return m_fd.get() != 0 && !m_bIsClosing; }
+
+    /**
+     * Marks the socket as awaiting closing.
+     * It will be closed at the end of poll() call.
+     */
+    inline void close(SocketCloseReason reason = SocketCloseReason::User) {
+        if (!m_bIsClosing && m_pOpenConnections) {
+            (*m_pOpenConnections)--;
+        }
+
+        m_bIsClosing = true;
+        m_CloseReason = reason;
+    }
+
+    /**
+     * @return remote address. IPv4 clients of dual-stack servers have IPv4 addresses.
+     */
+    inline const SockAddr &getRemoteAddress() { return m_RemoteAddr; }
+
+    /**
+     * @return the native socket (e.g. for getsockopt) or 0 if closed
+     */
+    inline SocketFile getNativeSocket() { return m_fd.get(); }
+
+    /**
+     * Applies socket options to the connection (e.g. to cork or uncork it).
+     * Throws on failure.
+     */
+    void setSocketOptions(const SocketOptions &opts);
+
+    /**
+     * Sets user data pointer
+     */
+    inline void setUserData(void *userdata) { m_pUserData = userdata; }
+
+    /**
+     * @return user data set in setUserData
+     */
+    inline void *getUserData() { return m_pUserData; }
+
+    /**
+     * Reads up to N bytes from the socket. Non-blocking.
+     * Throws on failure. The socket will be closed in that case.
+     * @param   buf     Buffer to put the data into.
+     * @return  Number of bytes read. Returns 0 if nothing to read. Returns 0 if EOF.
+     */
+    int read(appfw::span<uint8_t> buf);
+
+    /**
+     * Reads all available data into the receive buffer. Non-blocking.
+     * Uses a single vectored read per buffer fill and stops when the socket is drained
+     * or the buffer is full. On EOF the socket is closed with ConnAborted.
+     * Throws on failure. The socket will be closed in that case.
+     * @return  Number of bytes received.
+     */
+    size_t receive();
+
+#if PLATFORM_UNIX
+    /**
+     * Same as receive() but also receives file descriptors passed over a Unix domain socket.
+     * Received descriptors are appended to fds, the caller must close them.
+     * @return  Number of bytes received.
+     */
+    size_t receiveWithFds(std::vector<int> &fds);
+#endif
+
+    /**
+     * @return the receive buffer filled by receive(). Consume data after processing it.
+     */
+    inline RecvRingBuffer &getRecvBuffer() { return m_RecvBuffer; }
+
+    /**
+     * Sends up to N bytes of data in the buffer.
+     * Throws on failure. The socket will be closed in that case.
+     * @param   buf     Data to send
+     * @return  Number of bytes send
+     */
+    int write(appfw::span<const uint8_t> buf);
+
+#if PLATFORM_UNIX
+    /**
+     * Sends up to N bytes of data with file descriptors attached (SCM_RIGHTS).
+     * Unix domain sockets only. Up to MAX_PASSED_FDS descriptors, data must not be empty.
+     * Throws on failure. The socket will be closed in that case.
+     * @param   buf     Data to send
+     * @param   fds     Descriptors to pass. Only sent if some data was sent.
+     * @return  Number of bytes send
+     */
+    int writeWithFds(appfw::span<const uint8_t> buf, appfw::span<const int> fds);
+#endif
+
+    /**
+     * Sends all data in the buffer. May block up to the write time-out of the server.
+     * Throws on failure. The socket will be closed in that case.
+     * @param   buf     Data to send
+     */
+    void writeAll(appfw::span<const uint8_t> buf);
+
+    /**
+     * Sends as much data as possible and queues the rest. Never blocks.
+     * Queued data is sent during poll() when the socket becomes writable.
+     * write() and writeAll() send the queue first so the order is preserved.
+     * Throws on failure. The socket will be closed in that case.
+     * @param   buf     Data to send
+     */
+    void queueWrite(appfw::span<const uint8_t> buf);
+
+    /**
+     * Queues a range of a file to be sent. Never blocks.
+     * On Linux the data is sent with sendfile(2) without copying it into user space.
+     * The file is opened immediately, throws if it can't be opened or offset is past its end.
+     * @param   path    Path to the file (e.g. from FileSystem::findExistingFile)
+     * @param   offset  Offset of the first byte
+     * @param   length  Number of bytes to send (truncated to the end of the file)
+     */
+    void sendFile(const fs::path &path, uint64_t offset = 0, uint64_t length = FILE_END);
+
+    /**
+     * @return number of bytes queued by queueWrite and sendFile that weren't sent yet
+     */
+    uint64_t getSendQueueSize();
+
+    /**
+     * @return traffic counters of the connection. Can be read from any thread.
+     */
+    inline const ConnMetrics &getMetrics() { return m_Metrics; }
+
+private:
+    appfw::SockFd m_fd;
+    SockAddr m_RemoteAddr;
+    bool m_bIsClosing = false;
+    void *m_pUserData = nullptr;
+    SocketCloseReason m_CloseReason = SocketCloseReason::Failure;
+    RecvRingBuffer m_RecvBuffer;
+    TimerWheel::TimerId m_IdleTimer = TimerWheel::NULL_TIMER;
+    TimerWheel::TimerId m_WriteTimer = TimerWheel::NULL_TIMER;
+    int m_iWriteTimeout = 0;
+    bool m_bHasSendProgress = false;
+    ConnMetrics m_Metrics;
+    ServerMetrics *m_pServerMetrics = nullptr;
+    size_t *m_pOpenConnections = nullptr; //!< Server count of connections that aren't closing
+
+    //! Created on first queueWrite or sendFile
+    std::unique_ptr<platsock::SendQueue> m_pSendQueue;
+
+    //! Data received by the io_uring backend
+    struct UringState;
+    std::unique_ptr<UringState> m_pUring;
+
+    size_t receiveInternal(std::vector<int> *fds);
+
+    //! Sends queued data. @returns whether the queue is empty
+    bool flushSendQueue();
+
+    void onDataReceived(size_t size);
+    void onDataSent(size_t size);
+    int handleError(std::string_view callName);
+
+    friend class TcpServer;
+};
+
+} // namespace appfw 
+
+#endif
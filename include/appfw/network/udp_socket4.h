@@ -0,0 +1,206 @@
+#ifndef APPFW_NETWORK_UDP_SOCKET4_H
+#define APPFW_NETWORK_UDP_SOCKET4_H
+#include <memory>
+#include <vector>
+#include <appfw/network/socket.h>
+#include <appfw/network/socket_options.h>
+#include <appfw/span.h>
+#include <appfw/utils.h>
+
+namespace appfw {
+
+/**
+ * A message slot of UdpBatch4.
+ */
+struct UdpMessage4 {
+    //! Source address on receive, destination address on send
+    SockAddr4 addr = SockAddr4();
+
+    //! Number of bytes in the slot buffer
+    size_t size = 0;
+
+    //! Size of segments the buffer consists of (0 - single datagram).
+    //! On send the buffer is split into datagrams of this size (GSO).
+    //! On receive it is set if the kernel coalesced several datagrams (GRO).
+    uint16_t segmentSize = 0;
+};
+
+/**
+ * A preallocated array of datagrams for batched send and receive.
+ * All buffers are stored in a single contiguous block, slot i is at [i * bufferSize; (i + 1) * bufferSize).
+ * Platform message headers are allocated once so batched calls don't allocate.
+ */
+class UdpBatch4 : NoMove {
+public:
+    //! Default size of a slot buffer. Fits an Ethernet frame.
+    static constexpr size_t DEF_BUFFER_SIZE = 2048;
+
+    /**
+     * @param   count       Number of message slots
+     * @param   bufferSize  Size of each slot buffer. Datagrams larger than that are truncated.
+     *                      Must fit all segments when GSO or GRO is used.
+     */
+    UdpBatch4(size_t count, size_t bufferSize = DEF_BUFFER_SIZE);
+    ~UdpBatch4();
+
+    //! @returns the number of message slots
+    inline size_t capacity() const { return m_Messages.size(); }
+
+    //! @returns the size of a slot buffer
+    inline size_t bufferSize() const { return m_uBufferSize; }
+
+    //! @returns the number of messages in the batch
+    inline size_t size() const { return m_uSize; }
+
+    //! @returns whether the batch is empty
+    inline bool empty() const { return m_uSize == 0; }
+
+    //! @returns whether all slots are used
+    inline bool full() const { return m_uSize == capacity(); }
+
+    //! Removes all messages from the batch. Doesn't free memory.
+    inline void clear() { m_uSize = 0; }
+
+    //! @returns the message in slot idx
+    inline UdpMessage4 &getMessage(size_t idx) { return m_Messages[idx]; }
+
+    //! @returns the whole buffer of slot idx
+    inline appfw::span<uint8_t> getBuffer(size_t idx) {
+        return appfw::span<uint8_t>(m_Buffer.data() + idx * m_uBufferSize, m_uBufferSize);
+    }
+
+    //! @returns the data of message idx
+    inline appfw::span<const uint8_t> getData(size_t idx) {
+        return appfw::span<const uint8_t>(m_Buffer.data() + idx * m_uBufferSize,
+                                          m_Messages[idx].size);
+    }
+
+    /**
+     * Copies a message into the next free slot.
+     * @param   addr        Destination address
+     * @param   data        Datagram or segments if segmentSize is set
+     * @param   segmentSize Size of segments (0 - single datagram)
+     * @return  false if the batch is full or data doesn't fit into a slot
+     */
+    bool push(const SockAddr4 &addr, appfw::span<const uint8_t> data, uint16_t segmentSize = 0);
+
+    /**
+     * Sets the number of messages after the buffers were filled manually.
+     */
+    void setSize(size_t size);
+
+private:
+    struct Data;
+
+    std::vector<uint8_t> m_Buffer;
+    std::vector<UdpMessage4> m_Messages;
+    size_t m_uBufferSize = 0;
+    size_t m_uSize = 0;
+    std::unique_ptr<Data> m_Data;
+
+    friend class UdpSocket4;
+};
+
+/**
+ * A non-blocking UDP socket for IPv4.
+ * On Linux batches are sent and received with a single sendmmsg/recvmmsg call,
+ * on other platforms they fall back to a loop of sendto/recvfrom.
+ */
+class UdpSocket4 : NoMove {
+public:
+    //! Maximum size of a UDP payload over IPv4
+    static constexpr size_t MAX_DATAGRAM_SIZE = 65507;
+
+    UdpSocket4();
+    ~UdpSocket4();
+
+    /**
+     * @return whether the socket is open or not
+     */
+    inline bool isOpen() { return m_fd.get() != 0; }
+
+    /**
+     * Opens the socket and binds it to the address.
+     * Throws if already open or fails to open.
+     * @param   addr    Local address (port 0 - any free port)
+     */
+    void open(const SockAddr4 &addr = SockAddr4{ADDR4_ANY, 0});
+
+    /**
+     * Closes the socket.
+     */
+    void close();
+
+    /**
+     * @return the address the socket is bound to
+     */
+    inline const SockAddr4 &getLocalAddress() { return m_LocalAddr; }
+
+    /**
+     * Applies socket options. Only socket-level options (buffer sizes, busy-poll) apply to UDP.
+     * Throws on failure.
+     */
+    void setSocketOptions(const SocketOptions &opts);
+
+    /**
+     * Enables or disables coalescing of received datagrams by the kernel (UDP_GRO).
+     * Coalesced datagrams are received as a single message with segmentSize set.
+     * @return  false if not supported by the platform
+     */
+    bool setGroEnabled(bool enable);
+
+    /**
+     * Waits until data is available to read.
+     * Throws on error.
+     * @param   time    Time to wait in ms (0 - don't wait, -1 - indefinitely)
+     * @return  true if data is available to read
+     */
+    bool poll(int time);
+
+    /**
+     * Sends a datagram. Non-blocking.
+     * Throws on failure.
+     * @return  false if the datagram wasn't sent because the socket would block
+     */
+    bool sendTo(const SockAddr4 &addr, appfw::span<const uint8_t> data);
+
+    /**
+     * Receives a datagram. Non-blocking. Datagrams larger than the buffer are truncated.
+     * Throws on failure.
+     * @param   buf     Buffer to put the datagram into
+     * @param   size    Size of the received datagram
+     * @param   addr    Source address
+     * @return  false if nothing to read
+     */
+    bool receiveFrom(appfw::span<uint8_t> buf, size_t &size, SockAddr4 &addr);
+
+    /**
+     * Sends messages [offset; batch.size()) of the batch. Non-blocking.
+     * Messages with segmentSize set are split into datagrams by the kernel (GSO)
+     * or in software if it's not supported or the kernel rejects the message.
+     * Throws on failure.
+     * @return  Number of messages sent. Less than requested if the socket would block.
+     */
+    size_t sendBatch(UdpBatch4 &batch, size_t offset = 0);
+
+    /**
+     * Clears the batch and receives up to batch.capacity() datagrams into it. Non-blocking.
+     * Throws on failure.
+     * @return  Number of messages received. 0 if nothing to read.
+     */
+    size_t receiveBatch(UdpBatch4 &batch);
+
+private:
+    SockFd m_fd;
+    SockAddr4 m_LocalAddr = SockAddr4();
+
+    /**
+     * Sends buf as datagrams of segmentSize bytes.
+     * @return  false if the first datagram wasn't sent because the socket would block
+     */
+    bool sendSegments(const SockAddr4 &addr, appfw::span<const uint8_t> buf, size_t segmentSize);
+};
+
+} // namespace appfw
+
+#endif
@@ -1,5 +1,8 @@
 #ifndef APPFW_SPAN_H
 #define APPFW_SPAN_H
+#include <array>
+#include <limits>
+#include <vector>
 #include <appfw/dbg.h>
 
 namespace appfw {
@@ -0,0 +1,144 @@
+#ifndef APPFW_TIMER_WHEEL_H
+#define APPFW_TIMER_WHEEL_H
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <appfw/utils.h>
+
+namespace appfw {
+
+/**
+ * A hierarchical timer wheel with 1 ms resolution.
+ * Adding, cancelling and rescheduling a timer is O(1). Expired timers are found using
+ * per-level occupancy masks so empty time spans are skipped without iterating them.
+ *
+ * Time is counted in ms since construction and only moves in advance() or update(),
+ * delays are relative to the time of the last update. Meant to be driven by an event loop:
+ * poll with getTimeout() and call update() after every poll.
+ */
+class TimerWheel : NoMove {
+public:
+    using TimerId = uint64_t;
+    using Callback = std::function<void()>;
+
+    //! Id that is never returned by add()
+    static constexpr TimerId NULL_TIMER = 0;
+
+    TimerWheel();
+
+    /**
+     * @return the time of the wheel in ms
+     */
+    inline uint64_t getTime() const { return m_uTime; }
+
+    /**
+     * @return the real time in ms since construction
+     */
+    uint64_t getRealTime() const;
+
+    /**
+     * @return the number of active timers
+     */
+    inline size_t size() const { return m_uActiveCount; }
+
+    /**
+     * Adds a one-shot timer.
+     * @param   delay   Time in ms after getTime() when the timer expires. Values < 1 are treated as 1.
+     * @param   cb      Callback called from advance(). Can add and cancel timers.
+     * @return  Id of the timer
+     */
+    TimerId add(int64_t delay, Callback cb);
+
+    /**
+     * Cancels a timer.
+     * @return  false if the timer has already expired or was cancelled
+     */
+    bool cancel(TimerId id);
+
+    /**
+     * Moves the expiration time of an active timer to getTime() + delay.
+     * @return  false if the timer has already expired or was cancelled
+     */
+    bool reschedule(TimerId id, int64_t delay);
+
+    /**
+     * @return whether the timer is active
+     */
+    bool isActive(TimerId id) const;
+
+    /**
+     * Advances the time and calls callbacks of expired timers in order of expiration.
+     * @param   time    New time. Ignored if less than getTime().
+     */
+    void advance(uint64_t time);
+
+    /**
+     * Advances the time to getRealTime().
+     */
+    inline void update() { advance(getRealTime()); }
+
+    /**
+     * Returns time to wait until something needs to be done. May be earlier than the actual
+     * expiration of the next timer if it needs to be moved to a lower level.
+     * @param   maxTime Maximum time to return (-1 - infinite)
+     * @return  Time in ms from getTime() or maxTime (-1 if infinite and there are no timers)
+     */
+    int getTimeout(int maxTime) const;
+
+private:
+    static constexpr unsigned SLOT_BITS = 6;
+    static constexpr unsigned SLOTS = 1 << SLOT_BITS;
+    static constexpr unsigned LEVELS = 7;
+    static constexpr uint64_t MAX_TIME = (1ull << (SLOT_BITS * LEVELS)) - 1;
+    static constexpr uint32_t NIL = UINT32_MAX;
+    static constexpr uint64_t NO_EVENT = UINT64_MAX;
+
+    struct Entry {
+        Callback callback;
+        uint64_t expiry = 0;
+        uint32_t prev = NIL;
+        uint32_t next = NIL;
+        uint32_t generation = 1;
+        uint32_t slot = NIL; //!< NIL if free
+    };
+
+    std::chrono::steady_clock::time_point m_StartTime;
+    uint64_t m_uTime = 0;
+    size_t m_uActiveCount = 0;
+    std::vector<Entry> m_Entries;
+    uint32_t m_uFreeHead = NIL;
+
+    //! Lists of slots of all levels. Timers with the same expiry fire in order of adding.
+    uint32_t m_Heads[LEVELS * SLOTS];
+    uint32_t m_Tails[LEVELS * SLOTS];
+
+    //! Bit i is set if slot i of the level is not empty
+    uint64_t m_Occupied[LEVELS] = {};
+
+    static inline TimerId makeId(uint32_t index, uint32_t generation) {
+        return ((TimerId)generation << 32) | index;
+    }
+
+    //! @returns the entry index or NIL if id is not active
+    uint32_t findEntry(TimerId id) const;
+
+    //! Puts the entry into the slot for its expiry time.
+    void link(uint32_t idx);
+
+    //! Removes the entry from its slot.
+    void unlink(uint32_t idx);
+
+    //! Moves all entries of a slot to lower levels.
+    void cascade(unsigned level, unsigned slot);
+
+    //! Calls all timers in the slot of the first level.
+    void fire(unsigned slot);
+
+    //! @returns the earliest time after m_uTime when a slot needs to be processed.
+    uint64_t getNextEventTime() const;
+};
+
+} // namespace appfw
+
+#endif
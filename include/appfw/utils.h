@@ -186,6 +186,14 @@ inline bool isFutureReady(const std::future<R> &f) {
     return f.valid() && f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
 }
 
+/**
+ * Returns whether a shared future is ready.
+ */
+template <typename R>
+inline bool isFutureReady(const std::shared_future<R> &f) {
+    return f.valid() && f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
 //----------------------------------------------------------------
 
 /**
@@ -79,6 +79,10 @@ void appfw::shutdown() {
     s_Lib.uInitCount--;
 
     if (s_Lib.uInitCount == 0) {
+        // Print messages queued by other threads
+        s_Lib.pConSys->stopSinkThread();
+        s_Lib.pConSys->processMsgQueue();
+
         // Shutdown console receiver
         if (s_Lib.pTermConsole) {
             s_Lib.pConSys->removeConsoleReceiver(s_Lib.pTermConsole.get());
@@ -96,5 +100,10 @@ void appfw::mainLoopTick() {
     }
 
     s_Lib.pConSys->processCommand();
+    ConVarBase::notifySubscribers();
     s_Lib.pConSys->processMsgQueue();
+
+    if (s_Lib.pTermConsole) {
+        s_Lib.pTermConsole->flush();
+    }
 }
@@ -6,8 +6,9 @@ appfw::CmdBuffer::CmdBuffer(const CommandHandler &handler) {
     setCommandHandler(handler);
 }
 
-void appfw::CmdBuffer::append(const std::string &cmd) {
-    append(CmdString::parse(cmd));
+void appfw::CmdBuffer::append(std::string_view cmd) {
+    std::lock_guard lock(m_Mutex);
+    CmdString::parse(cmd, [this](CmdString &args) { m_CmdQueue.push(std::move(args)); });
 }
 
 void appfw::CmdBuffer::append(const CmdString &cmd) {
@@ -17,6 +18,13 @@ void appfw::CmdBuffer::append(const CmdString &cmd) {
     }
 }
 
+void appfw::CmdBuffer::append(CmdString &&cmd) {
+    std::lock_guard lock(m_Mutex);
+    if (!cmd.empty()) {
+        m_CmdQueue.push(std::move(cmd));
+    }
+}
+
 void appfw::CmdBuffer::append(const std::vector<CmdString> &cmds) {
     std::lock_guard lock(m_Mutex);
     for (auto &i : cmds) {
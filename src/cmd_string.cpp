@@ -1,9 +1,48 @@
+#include <limits>
 #include <appfw/cmd_string.h>
 
 appfw::CmdString::CmdString(const std::string *itbeg, const std::string *itend) {
-    size_t s = std::distance(itbeg, itend);
-    m_Args.resize(s);
-    std::copy(itbeg, itend, m_Args.begin());
+    for (auto it = itbeg; it != itend; ++it) {
+        addArg(*it);
+    }
+}
+
+appfw::CmdString::CmdString(std::initializer_list<std::string_view> args) {
+    for (std::string_view arg : args) {
+        addArg(arg);
+    }
+}
+
+std::vector<std::string> appfw::CmdString::getArgs() const {
+    std::vector<std::string> args;
+    args.reserve(size());
+
+    for (std::string_view arg : *this) {
+        args.emplace_back(arg);
+    }
+
+    return args;
+}
+
+void appfw::CmdString::addArg(std::string_view arg) {
+    ArgRange range;
+    range.uOffset = (uint32_t)m_Buffer.size();
+    range.uLength = (uint32_t)arg.size();
+    m_Buffer.append(arg);
+
+    if (m_uArgCount < INLINE_ARG_COUNT) {
+        m_InlineArgs[m_uArgCount] = range;
+    } else {
+        m_ExtraArgs.push_back(range);
+    }
+
+    m_uArgCount++;
+}
+
+void appfw::CmdString::clear() {
+    m_Buffer.clear();
+    m_ExtraArgs.clear();
+    m_uArgCount = 0;
 }
 
 std::string appfw::CmdString::toString() const {
@@ -25,13 +64,13 @@ std::string appfw::CmdString::toString() const {
     return s;
 }
 
-std::vector<appfw::CmdString> appfw::CmdString::parse(std::string_view cmd) {
+void appfw::CmdString::parse(std::string_view cmd,
+                             const std::function<void(CmdString &cmd)> &fn) {
     if (cmd.empty()) {
-        return std::vector<CmdString>();
+        return;
     }
 
-    std::vector<CmdString> strings;
-    std::vector<std::string> args;
+    CmdString args;
     size_t i = 0;
 
     // Skip spaces
@@ -53,9 +92,7 @@ std::vector<appfw::CmdString> appfw::CmdString::parse(std::string_view cmd) {
             } else if (c == ';' || c == '\n') {
                 // End of command
                 if (!args.empty()) {
-                    CmdString newCmd;
-                    newCmd.m_Args = std::move(args);
-                    strings.push_back(std::move(newCmd));
+                    fn(args);
                     args.clear();
                 }
                 continue;
@@ -70,16 +107,14 @@ std::vector<appfw::CmdString> appfw::CmdString::parse(std::string_view cmd) {
                 // End of argument
                 size_t len = i - argStart;
                 if (len != 0) {
-                    args.push_back(std::string(cmd.substr(argStart, len)));
+                    args.addArg(cmd.substr(argStart, len));
                 }
                 argStart = NO_ARG;
 
                 if (c == ';' || c == '\n') {
                     // End of command
                     if (!args.empty()) {
-                        CmdString newCmd;
-                        newCmd.m_Args = std::move(args);
-                        strings.push_back(std::move(newCmd));
+                        fn(args);
                         args.clear();
                     }
                     continue;
@@ -94,7 +129,7 @@ std::vector<appfw::CmdString> appfw::CmdString::parse(std::string_view cmd) {
                 // End of argument
                 size_t len = i - argStart;
                 if (len != 0) {
-                    args.push_back(std::string(cmd.substr(argStart, len)));
+                    args.addArg(cmd.substr(argStart, len));
                 }
                 argStart = NO_ARG;
                 isInQuotes = false;
@@ -103,13 +138,14 @@ std::vector<appfw::CmdString> appfw::CmdString::parse(std::string_view cmd) {
     }
 
     if (!args.empty()) {
-        // Move what's left into a new command
-        CmdString newCmd;
-        newCmd.m_Args = std::move(args);
-        strings.push_back(std::move(newCmd));
-        args.clear();
+        // What's left is the last command
+        fn(args);
     }
+}
 
+std::vector<appfw::CmdString> appfw::CmdString::parse(std::string_view cmd) {
+    std::vector<CmdString> strings;
+    parse(cmd, [&](CmdString &args) { strings.push_back(std::move(args)); });
     return strings;
 }
 
@@ -0,0 +1,205 @@
+#include <algorithm>
+#include <fstream>
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+#include <appfw/console/binary_log.h>
+#include <appfw/dbg.h>
+#include "../mapped_file.h"
+
+//----------------------------------------------------------------
+// BinaryLogSink
+//----------------------------------------------------------------
+appfw::BinaryLogSink::BinaryLogSink(FileSystem &fileSystem, const Options &options)
+    : m_FileSystem(fileSystem)
+    , m_Options(options) {
+    if (m_Options.segmentSize < sizeof(BinaryLogFileHeader) + sizeof(BinaryLogRecordHeader)) {
+        throw std::invalid_argument("segment size is too small");
+    }
+
+    openSegment();
+}
+
+appfw::BinaryLogSink::~BinaryLogSink() {
+    closeSegment();
+}
+
+void appfw::BinaryLogSink::rotate() {
+    closeSegment();
+    openSegment();
+}
+
+void appfw::BinaryLogSink::onAdd(ConsoleSystem *) {}
+
+void appfw::BinaryLogSink::onRemove(ConsoleSystem *) {}
+
+void appfw::BinaryLogSink::print(const ConMsgInfo &info, std::string_view msg) {
+    if (!m_pFile) {
+        return;
+    }
+
+    // Truncate the tag, then the text if they don't fit in an empty segment.
+    // The constructor guarantees that the headers fit.
+    size_t maxDataSize = m_pFile->size() - sizeof(BinaryLogFileHeader) - sizeof(BinaryLogRecordHeader);
+    std::string_view tag = info.tag ? info.tag : "";
+    tag = tag.substr(0, std::min<size_t>(maxDataSize, UINT16_MAX));
+    msg = msg.substr(0, std::min<size_t>(maxDataSize - tag.size(), UINT32_MAX / 2));
+
+    size_t recordSize = sizeof(BinaryLogRecordHeader) + tag.size() + msg.size();
+    bool isFull = m_uOffset + recordSize > m_pFile->size();
+    bool isOld = m_Options.maxSegmentAge.count() != 0 &&
+                 info.time - m_SegmentTime >= (time_t)m_Options.maxSegmentAge.count();
+
+    if (isFull || isOld) {
+        try {
+            rotate();
+        } catch (const std::exception &) {
+            // Can't print from a receiver. The sink stops, check isOpen().
+            closeSegment();
+            return;
+        }
+    }
+
+    BinaryLogRecordHeader header;
+    header.uSize = (uint32_t)recordSize;
+    header.uType = (uint8_t)info.type;
+    header.uColor = (uint8_t)info.color;
+    header.uTagLength = (uint16_t)tag.size();
+    header.iTime = (int64_t)info.time;
+
+    uint8_t *p = m_pFile->data() + m_uOffset;
+    std::memcpy(p, &header, sizeof(header));
+    std::memcpy(p + sizeof(header), tag.data(), tag.size());
+    std::memcpy(p + sizeof(header) + tag.size(), msg.data(), msg.size());
+    m_uOffset += recordSize;
+}
+
+bool appfw::BinaryLogSink::isThreadSafe() {
+    return true;
+}
+
+void appfw::BinaryLogSink::openSegment() {
+    AFW_ASSERT(!m_pFile);
+    time_t now = std::time(nullptr);
+    std::string fileName = fmt::format("{}_{:%Y%m%d_%H%M%S}_{:04}{}", m_Options.prefix,
+                                       fmt::localtime(now), m_uSegmentIdx, BINARY_LOG_EXTENSION);
+    fs::path path = m_FileSystem.getFilePath(getVirtualPath(fileName));
+    fs::create_directories(path.parent_path());
+
+    auto pFile = std::make_unique<MappedFile>();
+    pFile->create(path, m_Options.segmentSize);
+
+    BinaryLogFileHeader header = {};
+    std::memcpy(header.magic, BINARY_LOG_MAGIC, sizeof(header.magic));
+    header.uVersion = BINARY_LOG_VERSION;
+    header.uHeaderSize = sizeof(BinaryLogFileHeader);
+    header.iCreateTime = (int64_t)now;
+    header.uSegmentIdx = m_uSegmentIdx;
+    std::memcpy(pFile->data(), &header, sizeof(header));
+
+    m_pFile = std::move(pFile);
+    m_SegmentPath = path;
+    m_SegmentTime = now;
+    m_uOffset = sizeof(BinaryLogFileHeader);
+    m_uSegmentIdx++;
+
+    if (m_Options.maxSegments != 0) {
+        removeOldSegments();
+    }
+}
+
+void appfw::BinaryLogSink::closeSegment() {
+    if (m_pFile) {
+        m_pFile->close(m_uOffset);
+        m_pFile.reset();
+    }
+}
+
+void appfw::BinaryLogSink::removeOldSegments() {
+    std::string start = m_Options.prefix + "_";
+    std::string_view ext = BINARY_LOG_EXTENSION;
+    std::vector<std::string> segments;
+
+    for (const std::string &name : m_FileSystem.getFileList(m_Options.dir)) {
+        if (name.size() > start.size() + ext.size() && name.compare(0, start.size(), start) == 0 &&
+            name.compare(name.size() - ext.size(), ext.size(), ext) == 0) {
+            segments.push_back(name);
+        }
+    }
+
+    // Names begin with the time so sorted list is from oldest to newest
+    std::sort(segments.begin(), segments.end());
+
+    for (size_t i = 0; i + m_Options.maxSegments < segments.size(); i++) {
+        fs::path path = m_FileSystem.findExistingFile(getVirtualPath(segments[i]), std::nothrow);
+
+        if (!path.empty() && path != m_SegmentPath) {
+            std::error_code ec;
+            fs::remove(path, ec);
+        }
+    }
+}
+
+std::string appfw::BinaryLogSink::getVirtualPath(std::string_view fileName) {
+    std::string_view dir = m_Options.dir;
+
+    if (!dir.empty() && dir.back() != ':' && dir.back() != '/') {
+        return fmt::format("{}/{}", dir, fileName);
+    }
+
+    return fmt::format("{}{}", dir, fileName);
+}
+
+//----------------------------------------------------------------
+// BinaryLogReader
+//----------------------------------------------------------------
+appfw::BinaryLogReader::BinaryLogReader(const fs::path &path) {
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+
+    if (!file.is_open()) {
+        throw std::runtime_error(fmt::format("failed to open {}", path.u8string()));
+    }
+
+    m_Data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    if (m_Data.size() < sizeof(BinaryLogFileHeader)) {
+        throw std::runtime_error(fmt::format("{} is not a binary log", path.u8string()));
+    }
+
+    std::memcpy(&m_Header, m_Data.data(), sizeof(m_Header));
+
+    if (std::memcmp(m_Header.magic, BINARY_LOG_MAGIC, sizeof(m_Header.magic)) != 0) {
+        throw std::runtime_error(fmt::format("{} is not a binary log", path.u8string()));
+    }
+
+    if (m_Header.uVersion != BINARY_LOG_VERSION) {
+        throw std::runtime_error(
+            fmt::format("{} has unsupported version {}", path.u8string(), m_Header.uVersion));
+    }
+
+    m_uOffset = std::min<size_t>(m_Header.uHeaderSize, m_Data.size());
+}
+
+bool appfw::BinaryLogReader::readRecord(Record &record) {
+    if (m_Data.size() - m_uOffset < sizeof(BinaryLogRecordHeader)) {
+        return false;
+    }
+
+    BinaryLogRecordHeader header;
+    std::memcpy(&header, m_Data.data() + m_uOffset, sizeof(header));
+
+    // Zero size is the unused part of a segment that wasn't closed
+    if (header.uSize < sizeof(header) + header.uTagLength ||
+        header.uSize > m_Data.size() - m_uOffset) {
+        return false;
+    }
+
+    const char *p = reinterpret_cast<const char *>(m_Data.data() + m_uOffset + sizeof(header));
+    record.type = (ConMsgType)header.uType;
+    record.color = (ConMsgColor)header.uColor;
+    record.time = (time_t)header.iTime;
+    record.tag = std::string_view(p, header.uTagLength);
+    record.text = std::string_view(p + header.uTagLength,
+                                   header.uSize - sizeof(header) - header.uTagLength);
+    m_uOffset += header.uSize;
+    return true;
+}
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <appfw/console/con_item.h>
 #include <appfw/appfw.h>
 #include <appfw/init.h>
@@ -46,8 +47,81 @@ bool appfw::ConVarBase::isLocked() { return m_bIsLocked; }
 
 void appfw::ConVarBase::setLocked(bool state) { m_bIsLocked = state; }
 
+appfw::ConVarBase::~ConVarBase() {
+    if (m_bIsChanged) {
+        auto &changed = getChangedCvars();
+        changed.erase(std::find(changed.begin(), changed.end(), this));
+    }
+
+    // Destroyed while notifySubscribers is running
+    for (ConVarBase *&pCvar : getNotifiedCvars()) {
+        if (pCvar == this) {
+            pCvar = nullptr;
+        }
+    }
+}
+
+uint64_t appfw::ConVarBase::subscribe(const ChangeHandler &handler) {
+    uint64_t id = m_uNextSubscriberId++;
+    m_Subscribers.push_back({id, handler});
+    return id;
+}
+
+void appfw::ConVarBase::unsubscribe(uint64_t id) {
+    auto it = std::find_if(m_Subscribers.begin(), m_Subscribers.end(),
+                           [id](const auto &i) { return i.first == id; });
+
+    if (it != m_Subscribers.end()) {
+        m_Subscribers.erase(it);
+    }
+}
+
+void appfw::ConVarBase::notifySubscribers() {
+    auto &notified = getNotifiedCvars();
+    AFW_ASSERT_MSG(notified.empty(), "notifySubscribers is not reentrant");
+    notified.swap(getChangedCvars());
+
+    for (size_t i = 0; i < notified.size(); i++) {
+        ConVarBase *pCvar = notified[i];
+
+        if (!pCvar) {
+            continue;
+        }
+
+        pCvar->m_bIsChanged = false;
+
+        // Handlers may unsubscribe
+        auto subscribers = pCvar->m_Subscribers;
+
+        for (auto &j : subscribers) {
+            j.second(*pCvar);
+        }
+    }
+
+    notified.clear();
+}
+
 appfw::ConItemType appfw::ConVarBase::getType() { return ConItemType::ConVar; }
 
+void appfw::ConVarBase::markChanged() {
+    if (!m_bIsChanged && !m_Subscribers.empty()) {
+        m_bIsChanged = true;
+        getChangedCvars().push_back(this);
+    }
+}
+
+// Lists are never destroyed so static cvars can access them in their destructors
+
+std::vector<appfw::ConVarBase *> &appfw::ConVarBase::getChangedCvars() {
+    static auto *pList = new std::vector<ConVarBase *>();
+    return *pList;
+}
+
+std::vector<appfw::ConVarBase *> &appfw::ConVarBase::getNotifiedCvars() {
+    static auto *pList = new std::vector<ConVarBase *>();
+    return *pList;
+}
+
 //----------------------------------------------------------------
 // ConVar
 //----------------------------------------------------------------
@@ -76,7 +150,12 @@ appfw::VarSetResult appfw::ConVar<T>::setValue(const T &newVal) {
         }
     }
 
-    m_Value = newVal;
+    if (!(m_Value == newVal)) {
+        m_Value = newVal;
+        m_SharedValue.store(m_Value);
+        markChanged();
+    }
+
     return VarSetResult::Success;
 }
 
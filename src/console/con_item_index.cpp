@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <functional>
+#include <appfw/console/con_item_index.h>
+#include <appfw/dbg.h>
+
+appfw::ConItemIndex::ConItemIndex() {
+    m_Slots.resize(MIN_SLOT_COUNT);
+}
+
+appfw::ConItemBase *appfw::ConItemIndex::find(std::string_view name) const {
+    return m_Slots[findSlot(name, hashName(name))].pItem;
+}
+
+bool appfw::ConItemIndex::insert(ConItemBase *pItem) {
+    std::string_view name = pItem->getName();
+    size_t hash = hashName(name);
+    size_t idx = findSlot(name, hash);
+
+    if (m_Slots[idx].pItem) {
+        return false;
+    }
+
+    // Keep load factor at or below 1/2
+    if ((size() + 1) * 2 > m_Slots.size()) {
+        rehash(m_Slots.size() * 2);
+        idx = findSlot(name, hash);
+    }
+
+    m_Slots[idx] = {hash, pItem};
+
+    auto it = std::lower_bound(
+        m_SortedItems.begin(), m_SortedItems.end(), name,
+        [](ConItemBase *pLhs, std::string_view rhs) { return pLhs->getName() < rhs; });
+    m_SortedItems.insert(it, pItem);
+    return true;
+}
+
+bool appfw::ConItemIndex::erase(ConItemBase *pItem) {
+    std::string_view name = pItem->getName();
+    size_t idx = findSlot(name, hashName(name));
+
+    if (m_Slots[idx].pItem != pItem) {
+        return false;
+    }
+
+    // Backward-shift deletion: move following items of the probe sequence into the hole
+    // so lookups don't need tombstones
+    size_t mask = m_Slots.size() - 1;
+    size_t hole = idx;
+
+    for (size_t i = (hole + 1) & mask; m_Slots[i].pItem; i = (i + 1) & mask) {
+        size_t home = m_Slots[i].uHash & mask;
+
+        // Move if the home slot is not in (hole, i] (cyclically)
+        if (((i - home) & mask) >= ((i - hole) & mask)) {
+            m_Slots[hole] = m_Slots[i];
+            hole = i;
+        }
+    }
+
+    m_Slots[hole] = Slot();
+
+    auto it = std::lower_bound(
+        m_SortedItems.begin(), m_SortedItems.end(), name,
+        [](ConItemBase *pLhs, std::string_view rhs) { return pLhs->getName() < rhs; });
+    AFW_ASSERT(it != m_SortedItems.end() && *it == pItem);
+    m_SortedItems.erase(it);
+    return true;
+}
+
+size_t appfw::ConItemIndex::findSlot(std::string_view name, size_t hash) const {
+    size_t mask = m_Slots.size() - 1;
+
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        const Slot &slot = m_Slots[i];
+
+        if (!slot.pItem || (slot.uHash == hash && slot.pItem->getName() == name)) {
+            return i;
+        }
+    }
+}
+
+void appfw::ConItemIndex::rehash(size_t slotCount) {
+    AFW_ASSERT((slotCount & (slotCount - 1)) == 0);
+    std::vector<Slot> oldSlots(slotCount);
+    m_Slots.swap(oldSlots);
+    size_t mask = slotCount - 1;
+
+    for (const Slot &slot : oldSlots) {
+        if (slot.pItem) {
+            size_t i = slot.uHash & mask;
+
+            while (m_Slots[i].pItem) {
+                i = (i + 1) & mask;
+            }
+
+            m_Slots[i] = slot;
+        }
+    }
+}
+
+size_t appfw::ConItemIndex::hashName(std::string_view name) {
+    return std::hash<std::string_view>()(name);
+}
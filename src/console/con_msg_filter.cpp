@@ -0,0 +1,87 @@
+#include <appfw/console/con_msg_filter.h>
+#include <appfw/appfw.h>
+
+static bool isValidLevel(int level) {
+    return level >= (int)appfw::ConMsgType::WTF && level <= (int)appfw::ConMsgType::Debug;
+}
+
+static ConVar<int> con_min_level("con_min_level", (int)appfw::ConMsgType::Debug,
+                                 "Least severe message type printed: 0 wtf, 1 fatal, 2 error, "
+                                 "3 warning, 4 notice, 5 info, 6 debug",
+                                 [](const int &, const int &newVal) {
+                                     if (!isValidLevel(newVal)) {
+                                         return false;
+                                     }
+
+                                     appfw::ConMsgFilter::setGlobalLevel((appfw::ConMsgType)newVal);
+                                     return true;
+                                 });
+
+//----------------------------------------------------------------
+// ConMsgFilter
+//----------------------------------------------------------------
+appfw::ConMsgFilter::ConMsgFilter(const char *tag, const char *cvarName)
+    : m_pszTag(tag)
+    , m_Level(cvarName, -1, "Least severe message type printed for this module (-1 for con_min_level)") {
+    m_Level.setCallback([this](const int &, const int &newVal) {
+        if (newVal != -1 && !isValidLevel(newVal)) {
+            return false;
+        }
+
+        updateTypeMask(newVal);
+        return true;
+    });
+
+    std::lock_guard lock(getListMutex());
+    updateTypeMask(-1);
+    getList().insert(this);
+}
+
+appfw::ConMsgFilter::~ConMsgFilter() {
+    std::lock_guard lock(getListMutex());
+    getList().erase(this);
+}
+
+appfw::ConMsgType appfw::ConMsgFilter::getGlobalLevel() {
+    return (ConMsgType)getGlobalLevelRef().load(std::memory_order_relaxed);
+}
+
+void appfw::ConMsgFilter::setGlobalLevel(ConMsgType level) {
+    AFW_ASSERT(isValidLevel((int)level));
+    std::lock_guard lock(getListMutex());
+    getGlobalLevelRef().store((uint8_t)level, std::memory_order_relaxed);
+
+    for (ConMsgFilter *pFilter : getList()) {
+        pFilter->updateTypeMask(pFilter->m_Level.getValue());
+    }
+}
+
+void appfw::ConMsgFilter::updateTypeMask(int level) {
+    if (level == -1) {
+        level = (int)getGlobalLevel();
+    }
+
+    // Input is console echo, it's always printed
+    uint32_t mask = 1u << (unsigned)ConMsgType::Input;
+
+    for (int i = 0; i <= level; i++) {
+        mask |= 1u << (unsigned)i;
+    }
+
+    m_uTypeMask.store(mask, std::memory_order_relaxed);
+}
+
+std::atomic<uint8_t> &appfw::ConMsgFilter::getGlobalLevelRef() {
+    static std::atomic<uint8_t> level = (uint8_t)ConMsgType::Debug;
+    return level;
+}
+
+std::mutex &appfw::ConMsgFilter::getListMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::set<appfw::ConMsgFilter *> &appfw::ConMsgFilter::getList() {
+    static std::set<ConMsgFilter *> list;
+    return list;
+}
@@ -0,0 +1,113 @@
+#include <stdexcept>
+#include <appfw/console/con_msg_history.h>
+#include <appfw/dbg.h>
+
+appfw::ConMsgHistory::ConMsgHistory(size_t size) {
+    setSize(size);
+}
+
+void appfw::ConMsgHistory::setSize(size_t size) {
+    if (size < MIN_SIZE) {
+        throw std::invalid_argument("history size is too small");
+    }
+
+    std::lock_guard lock(m_Mutex);
+    m_Data.clear();
+    m_Data.resize(size);
+    m_Data.shrink_to_fit();
+    m_uFirstIdx += m_uCount;
+    m_uHead = m_uTail = m_uCount = 0;
+}
+
+std::string_view appfw::ConMsgHistory::push(const ConMsgInfo &info, std::string_view msg) {
+    std::lock_guard lock(m_Mutex);
+
+    // Truncate to the largest message that fits
+    size_t maxLength = (m_Data.size() - sizeof(Header)) & ~(alignof(Header) - 1);
+    msg = msg.substr(0, maxLength);
+    size_t size = getEntrySize(msg.size());
+
+    while (!reserve(size)) {
+        popFront();
+    }
+
+    Header header;
+    header.info = info;
+    header.uLength = (uint32_t)msg.size();
+
+    uint8_t *pEntry = m_Data.data() + m_uTail;
+    std::memcpy(pEntry, &header, sizeof(Header));
+    std::memcpy(pEntry + sizeof(Header), msg.data(), msg.size());
+
+    m_uTail += size;
+    m_uCount++;
+
+    return std::string_view(reinterpret_cast<const char *>(pEntry + sizeof(Header)), msg.size());
+}
+
+size_t appfw::ConMsgHistory::getCount() {
+    std::lock_guard lock(m_Mutex);
+    return m_uCount;
+}
+
+uint64_t appfw::ConMsgHistory::getFirstIndex() {
+    std::lock_guard lock(m_Mutex);
+    return m_uFirstIdx;
+}
+
+uint64_t appfw::ConMsgHistory::getNextIndex() {
+    std::lock_guard lock(m_Mutex);
+    return m_uFirstIdx + m_uCount;
+}
+
+void appfw::ConMsgHistory::clear() {
+    std::lock_guard lock(m_Mutex);
+    m_uFirstIdx += m_uCount;
+    m_uHead = m_uTail = m_uCount = 0;
+}
+
+size_t appfw::ConMsgHistory::skipWrap(size_t offset) const {
+    if (m_Data.size() - offset < sizeof(Header) || readHeader(offset).uLength == WRAP_MARKER) {
+        return 0;
+    }
+
+    return offset;
+}
+
+bool appfw::ConMsgHistory::reserve(size_t size) {
+    if (m_uCount == 0) {
+        m_uHead = m_uTail = 0;
+        return true;
+    }
+
+    if (m_uTail > m_uHead) {
+        // Free space is after the tail and before the head
+        if (m_Data.size() - m_uTail >= size) {
+            return true;
+        }
+
+        // Continue from the start
+        if (m_Data.size() - m_uTail >= sizeof(Header)) {
+            Header marker = {};
+            marker.uLength = WRAP_MARKER;
+            std::memcpy(m_Data.data() + m_uTail, &marker, sizeof(Header));
+        }
+
+        m_uTail = 0;
+    }
+
+    // Free space is between the tail and the head (none if equal)
+    return m_uTail < m_uHead && m_uHead - m_uTail >= size;
+}
+
+void appfw::ConMsgHistory::popFront() {
+    AFW_ASSERT(m_uCount > 0);
+    m_uHead = skipWrap(m_uHead);
+    m_uHead += getEntrySize(readHeader(m_uHead).uLength);
+    m_uCount--;
+    m_uFirstIdx++;
+
+    if (m_uCount != 0) {
+        m_uHead = skipWrap(m_uHead);
+    }
+}
@@ -2,98 +2,12 @@
 #include <appfw/console/console_system.h>
 #include <appfw/dbg.h>
 
-//----------------------------------------------------------------
-// RingBuffer
-//----------------------------------------------------------------
-class appfw::ConsoleSystem::RingBuffer {
-public:
-    static constexpr size_t MAX_BUFFER_SIZE = 64;
-
-    RingBuffer();
-
-    //! Adds a message to the end of the buffer
-    void push(const ConMsgInfo &info, std::string_view msg);
-
-    //! Moves a message to the end of the buffer
-    const ConMsg &push(const ConMsgInfo &info, std::string &&msg);
-
-    //! Moves a message to the end of the buffer
-    const ConMsg &push(ConMsg &&msg);
-
-    //! Returns the number of saved messages
-    size_t size();
-
-    //! Prints ring buffer contents into the receiver
-    void printPreviousMessages(IConsoleReceiver *pRecv);
-
-private:
-    std::vector<ConMsg> m_Buf;
-    size_t m_uPtr = 0;
-    size_t m_uSize = 0;
-    std::mutex m_Mutex;
-};
-
-appfw::ConsoleSystem::RingBuffer::RingBuffer() {
-    m_Buf.resize(MAX_BUFFER_SIZE);
-}
-
-void appfw::ConsoleSystem::RingBuffer::push(const ConMsgInfo &info, std::string_view msg) {
-    ConMsg m = {info, std::string(msg)};
-    push(std::move(m));
-}
-
-const appfw::ConMsg &appfw::ConsoleSystem::RingBuffer::push(const ConMsgInfo &info, std::string &&msg) {
-    ConMsg m = {info, std::move(msg)};
-    return push(std::move(m));
-}
-
-const appfw::ConMsg &appfw::ConsoleSystem::RingBuffer::push(ConMsg &&msg) {
-    std::lock_guard lock(m_Mutex);
-    m_Buf[m_uPtr] = std::move(msg);
-    ConMsg &newmsg = m_Buf[m_uPtr];
-    m_uPtr++;
-
-    if (m_uPtr == m_Buf.size()) {
-        m_uPtr = 0;
-    }
-
-    if (m_uSize < m_Buf.size()) {
-        m_uSize++;
-    }
-
-    return newmsg;
-}
-
-size_t appfw::ConsoleSystem::RingBuffer::size() {
-    return m_uSize;
-}
-
-void appfw::ConsoleSystem::RingBuffer::printPreviousMessages(IConsoleReceiver *pRecv) {
-    std::lock_guard lock(m_Mutex);
-
-    if (m_uSize < m_Buf.size()) {
-        for (size_t i = 0; i < m_uSize; i++) {
-            auto &[info, msg] = m_Buf[i];
-            pRecv->print(info, msg);
-        }
-    } else {
-        for (size_t i = m_uPtr; i < m_uSize; i++) {
-            auto &[info, msg] = m_Buf[i];
-            pRecv->print(info, msg);
-        }
-
-        for (size_t i = 0; i < m_uPtr; i++) {
-            auto &[info, msg] = m_Buf[i];
-            pRecv->print(info, msg);
-        }
-    }
-}
-
 //----------------------------------------------------------------
 // ConsoleSystem
 //----------------------------------------------------------------
-appfw::ConsoleSystem::ConsoleSystem() {
-    m_pMsgBuf = std::make_unique<RingBuffer>();
+appfw::ConsoleSystem::ConsoleSystem(size_t msgQueueSize, size_t historySize)
+    : m_History(historySize)
+    , m_MsgQueue(msgQueueSize) {
     updateThreadSafetyState();
 
     m_CmdBuffer.setCommandHandler([this](const CmdString &cmd) { commandNow(cmd); });
@@ -107,35 +21,38 @@ appfw::ConsoleSystem::ConsoleSystem() {
     pending.clear();
 }
 
-appfw::ConsoleSystem::~ConsoleSystem() = default;
+appfw::ConsoleSystem::~ConsoleSystem() {
+    stopSinkThread();
+}
 
 void appfw::ConsoleSystem::print(const ConMsgInfo &info, std::string_view msg) {
-    std::lock_guard lock(m_OutputMutex);
-    m_pMsgBuf->push(info, msg);
-
-    if (m_bThreadSafeOutput || std::this_thread::get_id() == m_MainThread) {
-        // Output right now
-        for (IConsoleReceiver *pRecv : m_RecvList) {
-            pRecv->print(info, msg);
-        }
+    if (!m_bSinkThreadRunning && std::this_thread::get_id() == m_MainThread.load()) {
+        std::lock_guard lock(m_OutputMutex);
+        drainMsgQueue();
+        outputMsg(info, msg);
     } else {
-        // Put into the queue
-        m_ThreadedMsgQueue.push({info, std::string(msg)});
+        enqueueMsg({info, std::string(msg), {}});
     }
 }
 
 void appfw::ConsoleSystem::print(const ConMsgInfo &info, std::string &&msg) {
-    std::lock_guard lock(m_OutputMutex);
-    const ConMsg &conMsg = m_pMsgBuf->push(info, std::move(msg));
+    if (!m_bSinkThreadRunning && std::this_thread::get_id() == m_MainThread.load()) {
+        // Output right now after the messages from other threads
+        std::lock_guard lock(m_OutputMutex);
+        drainMsgQueue();
+        outputMsg(info, msg);
+    } else {
+        enqueueMsg({info, std::move(msg), {}});
+    }
+}
 
-    if (m_bThreadSafeOutput || std::this_thread::get_id() == m_MainThread) {
-        // Output right now
-        for (IConsoleReceiver *pRecv : m_RecvList) {
-            pRecv->print(info, conMsg.second);
-        }
+void appfw::ConsoleSystem::print(const ConMsgInfo &info, ConDeferredMsg &&msg) {
+    if (!m_bSinkThreadRunning && std::this_thread::get_id() == m_MainThread.load()) {
+        std::lock_guard lock(m_OutputMutex);
+        drainMsgQueue();
+        outputMsg(info, formatDeferredMsg(msg));
     } else {
-        // Put a copy into the queue
-        m_ThreadedMsgQueue.push(conMsg);
+        enqueueMsg({info, {}, std::move(msg)});
     }
 }
 
@@ -143,31 +60,61 @@ bool appfw::ConsoleSystem::isThreadSafeOutput() {
     return m_bThreadSafeOutput;
 }
 
+void appfw::ConsoleSystem::startSinkThread() {
+    if (m_bSinkThreadRunning) {
+        return;
+    }
+
+    if (!m_bThreadSafeOutput) {
+        throw std::logic_error("sink thread requires all console receivers to be thread-safe");
+    }
+
+    m_bStopSinkThread = false;
+    m_SinkThread = std::thread([this]() { sinkThreadWorker(); });
+    m_bSinkThreadRunning = true;
+}
+
+void appfw::ConsoleSystem::stopSinkThread() {
+    if (!m_bSinkThreadRunning) {
+        return;
+    }
+
+    {
+        std::lock_guard lock(m_SinkMutex);
+        m_bStopSinkThread = true;
+    }
+
+    m_SinkCv.notify_one();
+    m_SinkThread.join();
+    m_bSinkThreadRunning = false;
+
+    std::lock_guard lock(m_OutputMutex);
+    drainMsgQueue();
+}
+
 appfw::ConItemBase *appfw::ConsoleSystem::findItem(std::string_view name, ConItemType type) {
-    auto it = m_ConItems.find(name);
+    ConItemBase *pItem = m_ConItems.find(name);
 
-    if (it == m_ConItems.end()) {
+    if (!pItem) {
         return nullptr;
     }
 
-    ConItemType itemType = it->second->getType();
+    ConItemType itemType = pItem->getType();
 
     if (type == ConItemType::Any || itemType == type) {
-        return it->second;
+        return pItem;
     } else {
         return nullptr;
     }
 }
 
 void appfw::ConsoleSystem::registerConItem(ConItemBase *pItem) {
-    m_ConItems.insert({std::string(pItem->getName()), pItem});
+    m_ConItems.insert(pItem);
 }
 
 void appfw::ConsoleSystem::unregisterConItem(ConItemBase *pItem) {
-    auto it = m_ConItems.find(pItem->getName());
-    AFW_ASSERT(it != m_ConItems.end());
-    AFW_ASSERT(it->second == pItem);
-    m_ConItems.erase(it);
+    [[maybe_unused]] bool isErased = m_ConItems.erase(pItem);
+    AFW_ASSERT(isErased);
 }
 
 void appfw::ConsoleSystem::command(const std::string &cmd) {
@@ -179,11 +126,7 @@ void appfw::ConsoleSystem::command(const CmdString &cmd) {
 }
 
 void appfw::ConsoleSystem::commandNow(const std::string &cmd) {
-    auto cmds = CmdString::parse(cmd);
-
-    for (auto &i : cmds) {
-        commandNow(i);
-    }
+    CmdString::parse(cmd, [this](CmdString &args) { commandNow(args); });
 }
 
 void appfw::ConsoleSystem::commandNow(const CmdString &cmd) {
@@ -205,7 +148,7 @@ void appfw::ConsoleSystem::commandNow(const CmdString &cmd) {
                      pCvar->getStringValue(), pCvar->getVarTypeAsString(), pCvar->isLocked() ? "(locked)" : "");
             printi("{}", pCvar->getDescr());
         } else {
-            VarSetResult result = pCvar->setStringValue(cmd[1]);
+            VarSetResult result = pCvar->setStringValue(std::string(cmd[1]));
 
             switch (result) {
             case VarSetResult::Success:
@@ -238,22 +181,20 @@ void appfw::ConsoleSystem::processAllCommands() {
 }
 
 void appfw::ConsoleSystem::processMsgQueue() {
-    std::lock_guard<std::mutex> lock(m_OutputMutex);
-    AFW_ASSERT_MSG(m_ThreadedMsgQueue.size() <= 100, "Msg queue is unusually long (> 100)");
     m_MainThread = std::this_thread::get_id();
 
-    while (!m_ThreadedMsgQueue.empty()) {
-        auto &[info, msg] = m_ThreadedMsgQueue.front();
-        
-        for (IConsoleReceiver *pRecv : m_RecvList) {
-            pRecv->print(info, msg);
-        }
-
-        m_ThreadedMsgQueue.pop();
+    if (!m_bSinkThreadRunning) {
+        std::lock_guard<std::mutex> lock(m_OutputMutex);
+        drainMsgQueue();
     }
 }
 
 void appfw::ConsoleSystem::addConsoleReceiver(IConsoleReceiver *pRecv) {
+    if (m_bSinkThreadRunning && !pRecv->isThreadSafe()) {
+        throw std::logic_error("receiver must be thread-safe while the sink thread is running");
+    }
+
+    std::lock_guard lock(m_OutputMutex);
     AFW_ASSERT_MSG(m_RecvList.find(pRecv) == m_RecvList.end(),
                    "pRecv has already been registered.");
     m_RecvList.insert(pRecv);
@@ -263,6 +204,7 @@ void appfw::ConsoleSystem::addConsoleReceiver(IConsoleReceiver *pRecv) {
 }
 
 void appfw::ConsoleSystem::removeConsoleReceiver(IConsoleReceiver *pRecv) {
+    std::lock_guard lock(m_OutputMutex);
     AFW_ASSERT_MSG(m_RecvList.find(pRecv) != m_RecvList.end(), "pRecv hasn't been registered.");
     pRecv->onRemove(this);
     m_RecvList.erase(pRecv);
@@ -270,15 +212,110 @@ void appfw::ConsoleSystem::removeConsoleReceiver(IConsoleReceiver *pRecv) {
     updateThreadSafetyState();
 }
 
+void appfw::ConsoleSystem::setHistorySize(size_t size) {
+    std::lock_guard lock(m_OutputMutex);
+    m_History.setSize(size);
+}
+
 void appfw::ConsoleSystem::printPreviousMessages(IConsoleReceiver *pRecv) {
-    m_pMsgBuf->printPreviousMessages(pRecv);
+    m_History.forEach(0, [&](uint64_t, const ConMsgInfo &info, std::string_view msg) {
+        pRecv->print(info, msg);
+        return true;
+    });
 }
 
 void appfw::ConsoleSystem::updateThreadSafetyState() {
-    m_bThreadSafeOutput = true;
+    bool isThreadSafe = true;
 
     for (auto pRecv : m_RecvList) {
-        m_bThreadSafeOutput = m_bThreadSafeOutput && pRecv->isThreadSafe();
+        isThreadSafe = isThreadSafe && pRecv->isThreadSafe();
+    }
+
+    m_bThreadSafeOutput = isThreadSafe;
+}
+
+void appfw::ConsoleSystem::enqueueMsg(QueuedMsg &&msg) {
+    bool isUrgent = msg.info.type <= ConMsgType::Error;
+    std::chrono::steady_clock::time_point deadline;
+    bool isWaiting = false;
+
+    while (!m_MsgQueue.tryPush(std::move(msg))) {
+        if (m_QueueFullPolicy.load(std::memory_order_relaxed) == ConQueueFullPolicy::Drop) {
+            m_uDroppedMsgs.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        if (m_bThreadSafeOutput) {
+            // Become the consumer instead of waiting for it
+            std::lock_guard lock(m_OutputMutex);
+            drainMsgQueue();
+        } else {
+            // Only the main thread can print. Don't hang if it's stalled.
+            auto now = std::chrono::steady_clock::now();
+
+            if (!isWaiting) {
+                deadline = now + MAX_QUEUE_BLOCK_TIME;
+                isWaiting = true;
+            } else if (now >= deadline) {
+                m_uDroppedMsgs.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            std::this_thread::yield();
+        }
+    }
+
+    if (m_bSinkThreadRunning &&
+        (isUrgent || m_MsgQueue.sizeApprox() >= m_MsgQueue.capacity() / 2)) {
+        // Print errors without a delay in case the app is about to crash.
+        // Also wake it up before the queue fills up.
+        m_SinkCv.notify_one();
+    }
+}
+
+void appfw::ConsoleSystem::drainMsgQueue() {
+    QueuedMsg msg;
+
+    while (m_MsgQueue.tryPop(msg)) {
+        if (msg.deferred.isEmpty()) {
+            outputMsg(msg.info, msg.text);
+        } else {
+            outputMsg(msg.info, formatDeferredMsg(msg.deferred));
+        }
+    }
+}
+
+void appfw::ConsoleSystem::outputMsg(const ConMsgInfo &info, std::string_view msg) {
+    // Receivers get the copy in the history.
+    // It's only overwritten by the next message which can't be pushed while m_OutputMutex is locked.
+    std::string_view savedMsg = m_History.push(info, msg);
+
+    for (IConsoleReceiver *pRecv : m_RecvList) {
+        pRecv->print(info, savedMsg);
+    }
+}
+
+std::string appfw::ConsoleSystem::formatDeferredMsg(const ConDeferredMsg &msg) {
+    try {
+        return msg.format();
+    } catch (const std::exception &e) {
+        return fmt::format("< format error: {} >", e.what());
+    }
+}
+
+void appfw::ConsoleSystem::sinkThreadWorker() {
+    std::unique_lock sinkLock(m_SinkMutex);
+
+    while (!m_bStopSinkThread) {
+        m_SinkCv.wait_for(sinkLock, SINK_WAIT_TIME);
+        sinkLock.unlock();
+
+        {
+            std::lock_guard lock(m_OutputMutex);
+            drainMsgQueue();
+        }
+
+        sinkLock.lock();
     }
 }
 
@@ -321,12 +358,12 @@ static ConCommand
                    }
                }
 
-               auto &map = appfw::getConsole().getItemMap();
+               auto &items = appfw::getConsole().getItemList();
                size_t count = 0;
 
-               for (auto &i : map) {
-                   if (filter == ConItemType::Any || filter == i.second->getType()) {
-                       printItemInfo(i.second);
+               for (ConItemBase *pItem : items) {
+                   if (filter == ConItemType::Any || filter == pItem->getType()) {
+                       printItemInfo(pItem);
                        count++;
                    }
                }
@@ -3,10 +3,26 @@
 
 #if PLATFORM_WINDOWS
 #include <appfw/windows.h>
+#elif PLATFORM_UNIX
+#include <cerrno>
+#include <poll.h>
+#include <unistd.h>
+#else
+#error
 #endif
 
 appfw::StdConsole::StdConsole(TermInputMethod inputMethod) {
     m_InputMethod = inputMethod;
+    m_OutBuf.reserve(OUT_BUF_SIZE);
+
+#if PLATFORM_WINDOWS
+    HANDLE h = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD mode = 0;
+    m_bUseColors = GetConsoleMode(h, &mode) &&
+                   SetConsoleMode(h, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+#else
+    m_bUseColors = isatty(STDOUT_FILENO);
+#endif
 
     if (m_InputMethod == TermInputMethod::Enable) {
         m_pSyncData = std::make_shared<SyncData>();
@@ -17,6 +33,8 @@ appfw::StdConsole::StdConsole(TermInputMethod inputMethod) {
 }
 
 appfw::StdConsole::~StdConsole() {
+    flush();
+
     if (m_InputMethod == TermInputMethod::Enable) {
         std::lock_guard<std::mutex> lock(m_pSyncData->mutex);
         m_pSyncData->bIsValid = false;
@@ -31,12 +49,27 @@ void appfw::StdConsole::onAdd(ConsoleSystem *conSys) {
 void appfw::StdConsole::onRemove([[maybe_unused]] ConsoleSystem *conSys) {
     AFW_ASSERT(m_pConSys == conSys);
     m_pConSys = nullptr;
+    flush();
 }
 
 void appfw::StdConsole::print(const ConMsgInfo &info, std::string_view msg) {
-    setColor(info.color != ConMsgColor::Default ? info.color : getMsgTypeColor(info.type));
-    std::cout << msg << "\n";
-    setColor(ConMsgColor::Default);
+    std::lock_guard lock(m_OutMutex);
+    ConMsgColor color = info.color != ConMsgColor::Default ? info.color : getMsgTypeColor(info.type);
+
+    if (m_bUseColors && color != ConMsgColor::Default) {
+        appendColor(color);
+        m_OutBuf.append(msg);
+        appendColor(ConMsgColor::Default);
+    } else {
+        m_OutBuf.append(msg);
+    }
+
+    m_OutBuf.push_back('\n');
+
+    // Errors are written immediately in case the app is about to crash
+    if (!m_bBatchOutput || m_OutBuf.size() >= OUT_BUF_SIZE || info.type <= ConMsgType::Error) {
+        writeOutput();
+    }
 }
 
 bool appfw::StdConsole::isThreadSafe() {
@@ -60,6 +93,19 @@ void appfw::StdConsole::tick() {
     }
 }
 
+void appfw::StdConsole::flush() {
+    std::lock_guard lock(m_OutMutex);
+
+    // Main loop is running, it will flush the output every tick
+    m_bBatchOutput = true;
+    writeOutput();
+}
+
+void appfw::StdConsole::setColorsEnabled(bool state) {
+    std::lock_guard lock(m_OutMutex);
+    m_bUseColors = state;
+}
+
 void appfw::StdConsole::threadWorker(StdConsole *t, std::shared_ptr<SyncData> pSyncData) {
     for (;;) {
         std::string input;
@@ -76,14 +122,67 @@ void appfw::StdConsole::threadWorker(StdConsole *t, std::shared_ptr<SyncData> pS
     }
 }
 
+void appfw::StdConsole::appendColor(ConMsgColor color) {
+    if (color == ConMsgColor::Default) {
+        m_OutBuf.append("\x1b[0m");
+        return;
+    }
+
+    // 0bIRGB to ANSI 0bBGR
+    unsigned c = (unsigned)color;
+    unsigned ansiColor = (c & 0b0100 ? 1 : 0) | (c & 0b0010 ? 2 : 0) | (c & 0b0001 ? 4 : 0);
+    unsigned code = (c & 0b1000 ? 90 : 30) + ansiColor;
+
+    char buf[8] = "\x1b[";
+    buf[2] = (char)('0' + code / 10);
+    buf[3] = (char)('0' + code % 10);
+    buf[4] = 'm';
+    m_OutBuf.append(buf, 5);
+}
+
 #if PLATFORM_WINDOWS
-void appfw::StdConsole::setColor(ConMsgColor color) {
+void appfw::StdConsole::writeOutput() {
     HANDLE h = GetStdHandle(STD_OUTPUT_HANDLE);
-    WORD colorword = (color != ConMsgColor::Default) ? (WORD)color : (WORD)ConMsgColor::Grey;
-    SetConsoleTextAttribute(h, colorword);
+    size_t offset = 0;
+
+    while (offset < m_OutBuf.size()) {
+        DWORD written = 0;
+
+        if (!WriteFile(h, m_OutBuf.data() + offset, (DWORD)(m_OutBuf.size() - offset), &written,
+                       nullptr)) {
+            // Output is lost
+            break;
+        }
+
+        offset += written;
+    }
+
+    m_OutBuf.clear();
 }
 #else
-void appfw::StdConsole::setColor(ConMsgColor color) {
-    // Do nothing
+void appfw::StdConsole::writeOutput() {
+    size_t offset = 0;
+
+    while (offset < m_OutBuf.size()) {
+        ssize_t size = ::write(STDOUT_FILENO, m_OutBuf.data() + offset, m_OutBuf.size() - offset);
+
+        if (size < 0) {
+            if (errno == EINTR) {
+                continue;
+            } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                // stdout is non-blocking
+                pollfd pfd = {STDOUT_FILENO, POLLOUT, 0};
+                ::poll(&pfd, 1, -1);
+                continue;
+            }
+
+            // Output is lost
+            break;
+        }
+
+        offset += (size_t)size;
+    }
+
+    m_OutBuf.clear();
 }
-#endif
\ No newline at end of file
+#endif
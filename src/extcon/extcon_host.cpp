@@ -10,9 +10,13 @@ appfw::ExtconHost::ExtconHost()
 appfw::ExtconHost::~ExtconHost() {}
 
 void appfw::ExtconHost::enable(const IPAddress4 &addr, uint16_t port) {
+    enable(SockAddr(addr, port));
+}
+
+void appfw::ExtconHost::enable(const SockAddr &addr) {
     disable();
 
-    m_Worker.start(addr, port);
+    m_Worker.start(addr);
     m_bIsWorkerRunning = true;
 }
 
@@ -61,20 +65,9 @@ void appfw::ExtconHost::onRemove([[maybe_unused]] ConsoleSystem *pConSys) {
     m_pConSys = nullptr;
 }
 
-void appfw::ExtconHost::print(const ConMsgInfo &info, std::string_view msg) {
-    if (!m_bIsConnected) {
-        return;
-    }
-    
-    std::unique_lock lock(m_PrintQueueMutex);
-
-    if (m_PrintQueue.size() >= MAX_QUEUE_SIZE) {
-        // Block until the queue is empty
-        m_PrintQueueEmptyCv.wait(lock, [&]() { return m_PrintQueue.empty(); });
-    }
-
-    PrintMessage printMsg{info, std::string(msg)};
-    m_PrintQueue.push(std::move(printMsg));
+void appfw::ExtconHost::print(const ConMsgInfo &, std::string_view) {
+    // The worker reads messages from the history. Never wait for it here:
+    // print is called with the output locked and the worker prints too.
 }
 
 bool appfw::ExtconHost::isThreadSafe() {
@@ -82,16 +75,14 @@ bool appfw::ExtconHost::isThreadSafe() {
 }
 
 void appfw::ExtconHost::onClientConnected() {
-    m_pConSys->printPreviousMessages(this);
-
     {
         std::lock_guard lock(m_AvailableCommandsMutex);
-        auto &items = m_pConSys->getItemMap();
+        auto &items = m_pConSys->getItemList();
         m_AvailableCommands.clear();
         m_AvailableCommands.reserve(items.size());
 
-        for (const auto &i : items) {
-            m_AvailableCommands.push_back(i.first);
+        for (ConItemBase *pItem : items) {
+            m_AvailableCommands.emplace_back(pItem->getName());
         }
     }
 }
@@ -104,12 +95,11 @@ appfw::ExtconHost::WorkerThread::WorkerThread(ExtconHost &con)
         [&](auto, auto socket) { onConnAccepted(socket); });
     m_Server.setConnClosedCallback(
         [&](auto, auto socket, auto reason) { onConnClosed(socket, reason); });
-    m_Server.setReadyReadCallback([&](auto, auto socket) { onReadyRead(socket); });
+    m_Server.setPayloadCallback(
+        [&](auto, auto &socket, auto &stream, auto) { onPayloadReceived(socket, stream); });
 
-    m_ClientParser.setMagic(EXTCON_MSG_MAGIC, EXTCON_MSG_MAGIC_SIZE);
-    m_ClientParser.setMaxPayloadSize(EXTCON_MAX_PAYLOAD_SIZE);
-    m_ClientParser.setPayloadCallback(
-        [&](appfw::BinaryInputStream &stream, uint8_t *, size_t) { onPayloadReceived(stream); });
+    m_Server.setMagic(EXTCON_MSG_MAGIC, EXTCON_MSG_MAGIC_SIZE);
+    m_Server.setMaxPayloadSize(EXTCON_MAX_PAYLOAD_SIZE);
 
     m_Buffer.resize(MAX_TCP_READ_SIZE);
 }
@@ -118,10 +108,10 @@ appfw::ExtconHost::WorkerThread::~WorkerThread() {
     AFW_ASSERT_REL(!m_bIsThreadRunning);
 }
 
-void appfw::ExtconHost::WorkerThread::start(const IPAddress4 &addr, uint16_t port) {
+void appfw::ExtconHost::WorkerThread::start(const SockAddr &addr) {
     AFW_ASSERT_REL(!m_bIsThreadRunning);
     m_bIsThreadRunning = true;
-    m_Thread = std::thread([=]() { run(addr, port); });
+    m_Thread = std::thread([=]() { run(addr); });
 }
 
 void appfw::ExtconHost::WorkerThread::stop() {
@@ -129,9 +119,16 @@ void appfw::ExtconHost::WorkerThread::stop() {
     m_Thread.join();
 }
 
-void appfw::ExtconHost::WorkerThread::run(const IPAddress4 &addr, uint16_t port) noexcept {
+void appfw::ExtconHost::WorkerThread::run(const SockAddr &addr) noexcept {
+    // Console messages are small, don't let Nagle's algorithm delay them
+    m_Server.getServer().setSocketOptions(addr.isUnix() ? SocketOptions()
+                                                        : SocketOptions().setNoDelay(true));
+
+    // Drop the client if it stops reading
+    m_Server.getServer().setWriteTimeout(WRITE_TIMEOUT);
+
     try {
-        m_Server.startListening(addr, port, 1);
+        m_Server.startListening(addr, 1);
     } catch (const std::exception e) {
         printe("extcon: Failed to start the server: {}", e.what());
         return;
@@ -215,28 +212,54 @@ void appfw::ExtconHost::WorkerThread::sendAvailableCommands() {
 }
 
 void appfw::ExtconHost::WorkerThread::sendQueuedMessages() {
-    std::unique_lock lock(m_Con.m_PrintQueueMutex);
-    auto &queue = m_Con.m_PrintQueue;
-
-    while (!queue.empty()) {
-        PrintMessage msg = std::move(queue.front());
-        queue.pop();
-        lock.unlock();
-
-        BinaryBuffer stream = prepareSendBuffer(EXTCON_OPCODE_PRINT);
-        stream.writeByte((uint8_t)msg.info.type);
-        stream.writeByte((uint8_t)msg.info.color);
-        stream.writeInt64(msg.info.time);
-        stream.writeString(msg.info.tag);
-        stream.writeString(msg.text);
-        sendBuffer(stream);
+    ConsoleSystem *pConSys = m_Con.m_pConSys;
 
-        lock.lock();
+    if (!pConSys) {
+        return;
     }
 
-    if (queue.empty()) {
-        lock.unlock();
-        m_Con.m_PrintQueueEmptyCv.notify_all();
+    ConMsgHistory &history = pConSys->getHistory();
+    uint64_t nextIdx = m_uNextMsgIdx;
+
+    while (nextIdx != history.getNextIndex()) {
+        if (m_pClientSocket->getSendQueueSize() >= MAX_BATCH_SIZE) {
+            // Let the client catch up. Unsent messages stay in the history.
+            break;
+        }
+
+        // Serialize messages while the history is locked and send them together
+        m_SendBatch.clear();
+
+        auto fn = [&](uint64_t idx, const ConMsgInfo &info, std::string_view text) {
+            if (m_SendBatch.size() >= MAX_BATCH_SIZE) {
+                return false;
+            }
+
+            if (idx > nextIdx) {
+                // Removed from the history before they were sent
+                m_Con.m_uDroppedMsgs.fetch_add(idx - nextIdx, std::memory_order_relaxed);
+                nextIdx = idx;
+            }
+
+            BinaryBuffer stream = prepareSendBuffer(EXTCON_OPCODE_PRINT);
+            stream.writeByte((uint8_t)info.type);
+            stream.writeByte((uint8_t)info.color);
+            stream.writeInt64(info.time);
+            stream.writeString(info.tag);
+            stream.writeString(text);
+            finishBuffer(stream);
+
+            m_SendBatch.insert(m_SendBatch.end(), m_Buffer.begin(),
+                               m_Buffer.begin() + stream.getPosition());
+            return true;
+        };
+
+        nextIdx = history.forEach(nextIdx, fn);
+
+        // What doesn't fit into the socket buffer is sent during poll.
+        // Frames are never cut and the batch is either fully queued or the socket is closed.
+        m_pClientSocket->queueWrite(m_SendBatch);
+        m_uNextMsgIdx = nextIdx;
     }
 }
 
@@ -247,11 +270,10 @@ void appfw::ExtconHost::WorkerThread::sendRequestFocus() {
     }
 }
 
-void appfw::ExtconHost::WorkerThread::onConnAccepted(appfw::TcpClientSocket4Ptr socket) noexcept {
+void appfw::ExtconHost::WorkerThread::onConnAccepted(appfw::TcpClientSocketPtr socket) noexcept {
     if (!m_pClientSocket) {
         // Accept the connection
         m_pClientSocket = socket;
-        m_ClientParser.reset();
         m_bIsSocketValid = true;
 
         std::lock_guard lockState(m_Con.m_StateSyncMutex);
@@ -259,18 +281,15 @@ void appfw::ExtconHost::WorkerThread::onConnAccepted(appfw::TcpClientSocket4Ptr
         m_Con.m_bClientFocusRequested = false;
         m_Con.m_bHostFocusRequested = false;
 
-        // Clear msg queue
-        std::lock_guard lockPrint(m_Con.m_PrintQueueMutex);
-        while (!m_Con.m_PrintQueue.empty()) {
-            m_Con.m_PrintQueue.pop();
-        }
+        // Send all saved messages
+        m_uNextMsgIdx = m_Con.m_pConSys ? m_Con.m_pConSys->getHistory().getFirstIndex() : 0;
     } else {
         // Only one client is supported, close the connection
         socket->close();
     }
 }
 
-void appfw::ExtconHost::WorkerThread::onConnClosed(appfw::TcpClientSocket4Ptr socket,
+void appfw::ExtconHost::WorkerThread::onConnClosed(appfw::TcpClientSocketPtr socket,
                                                    appfw::SocketCloseReason reason) noexcept {
     if (m_pClientSocket == socket) {
         m_pClientSocket = nullptr;
@@ -294,6 +313,9 @@ void appfw::ExtconHost::WorkerThread::onConnClosed(appfw::TcpClientSocket4Ptr so
         case appfw::SocketCloseReason::Shutdown:
             reasonStr = "Server is going down";
             break;
+        case appfw::SocketCloseReason::InvalidData:
+            reasonStr = "Received invalid data";
+            break;
         default:
             reasonStr = "Unknown";
         }
@@ -306,38 +328,12 @@ void appfw::ExtconHost::WorkerThread::onConnClosed(appfw::TcpClientSocket4Ptr so
     }
 }
 
-void appfw::ExtconHost::WorkerThread::onReadyRead(appfw::TcpClientSocket4Ptr socket) noexcept {
-    int readSize = 0;
-
-    try {
-        readSize = socket->read(m_Buffer);
-    } catch (const std::exception &e) {
-        m_bIsSocketValid = false;
-        printe("extcon: Read failed: {}", e.what());
+void appfw::ExtconHost::WorkerThread::onPayloadReceived(const appfw::TcpClientSocketPtr &socket,
+                                                        appfw::BinaryInputStream &stream) noexcept {
+    if (socket != m_pClientSocket) {
         return;
     }
 
-    if (readSize <= 0) {
-        m_bIsSocketValid = false;
-        socket->close(appfw::SocketCloseReason::ConnAborted);
-        return;
-    }
-
-    uint32_t bytesParsed = 0;
-    DatagramParser::Error error;
-
-    if (!m_ClientParser.parseData(m_Buffer.data(), readSize, bytesParsed, error)) {
-        m_bIsSocketValid = false;
-        socket->close();
-        printe("extcon: Received invalid data");
-    } else if (bytesParsed != (uint32_t)readSize) {
-        m_bIsSocketValid = false;
-        socket->close();
-        printe("extcon: Not all data was parsed");
-    }
-}
-
-void appfw::ExtconHost::WorkerThread::onPayloadReceived(appfw::BinaryInputStream &stream) noexcept {
     try {
         uint8_t opcode = stream.readByte();
 
@@ -376,11 +372,15 @@ appfw::BinaryBuffer appfw::ExtconHost::WorkerThread::prepareSendBuffer(uint8_t o
     return stream;
 }
 
-void appfw::ExtconHost::WorkerThread::sendBuffer(appfw::BinaryBuffer &stream) {
-    uint32_t packetSize = (uint32_t)stream.getPosition();
-    uint32_t payloadSize = packetSize - EXTCON_MSG_MAGIC_SIZE - sizeof(uint32_t);
+void appfw::ExtconHost::WorkerThread::finishBuffer(appfw::BinaryBuffer &stream) {
+    appfw::binpos packetSize = stream.getPosition();
+    uint32_t payloadSize = (uint32_t)(packetSize - EXTCON_MSG_MAGIC_SIZE - sizeof(uint32_t));
     stream.seekAbsolute(EXTCON_MSG_MAGIC_SIZE);
     stream.writeUInt32(payloadSize);
+    stream.seekAbsolute(packetSize);
+}
 
-    m_pClientSocket->write(appfw::span(m_Buffer.data(), packetSize));
+void appfw::ExtconHost::WorkerThread::sendBuffer(appfw::BinaryBuffer &stream) {
+    finishBuffer(stream);
+    m_pClientSocket->queueWrite(appfw::span(m_Buffer.data(), (size_t)stream.getPosition()));
 }
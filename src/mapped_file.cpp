@@ -0,0 +1,132 @@
+#include <cstring>
+#include <stdexcept>
+#include <fmt/format.h>
+#include <appfw/dbg.h>
+#include "mapped_file.h"
+
+#if PLATFORM_WINDOWS
+#include <appfw/windows.h>
+#elif PLATFORM_UNIX
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#else
+#error
+#endif
+
+appfw::MappedFile::~MappedFile() {
+    if (isOpen()) {
+        close(m_uSize);
+    }
+}
+
+#if PLATFORM_WINDOWS
+
+void appfw::MappedFile::create(const fs::path &path, size_t size) {
+    AFW_ASSERT(!isOpen());
+    HANDLE hFile = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                               CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if (hFile == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error(fmt::format("failed to create {}: error {}", path.u8string(),
+                                             GetLastError()));
+    }
+
+    LARGE_INTEGER fileSize;
+    fileSize.QuadPart = (LONGLONG)size;
+    HANDLE hMapping = CreateFileMappingW(hFile, nullptr, PAGE_READWRITE, fileSize.HighPart,
+                                         fileSize.LowPart, nullptr);
+
+    if (!hMapping) {
+        DWORD error = GetLastError();
+        CloseHandle(hFile);
+        throw std::runtime_error(
+            fmt::format("failed to map {}: error {}", path.u8string(), error));
+    }
+
+    void *pData = MapViewOfFile(hMapping, FILE_MAP_WRITE, 0, 0, size);
+
+    if (!pData) {
+        DWORD error = GetLastError();
+        CloseHandle(hMapping);
+        CloseHandle(hFile);
+        throw std::runtime_error(
+            fmt::format("failed to map {}: error {}", path.u8string(), error));
+    }
+
+    m_hFile = hFile;
+    m_hMapping = hMapping;
+    m_pData = static_cast<uint8_t *>(pData);
+    m_uSize = size;
+}
+
+void appfw::MappedFile::close(size_t fileSize) {
+    AFW_ASSERT(isOpen());
+    AFW_ASSERT(fileSize <= m_uSize);
+    UnmapViewOfFile(m_pData);
+    CloseHandle(m_hMapping);
+
+    LARGE_INTEGER pos;
+    pos.QuadPart = (LONGLONG)fileSize;
+    SetFilePointerEx(m_hFile, pos, nullptr, FILE_BEGIN);
+    SetEndOfFile(m_hFile);
+    CloseHandle(m_hFile);
+
+    m_pData = nullptr;
+    m_uSize = 0;
+    m_hFile = nullptr;
+    m_hMapping = nullptr;
+}
+
+#else
+
+void appfw::MappedFile::create(const fs::path &path, size_t size) {
+    AFW_ASSERT(!isOpen());
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+    if (fd == -1) {
+        throw std::runtime_error(
+            fmt::format("failed to create {}: {}", path.u8string(), std::strerror(errno)));
+    }
+
+    // Allocate the blocks now so writes into the mapping can't fail with SIGBUS later
+#if PLATFORM_LINUX
+    int result = ::posix_fallocate(fd, 0, (off_t)size);
+#else
+    int result = ::ftruncate(fd, (off_t)size) == 0 ? 0 : errno;
+#endif
+
+    if (result != 0) {
+        ::close(fd);
+        throw std::runtime_error(
+            fmt::format("failed to allocate {}: {}", path.u8string(), std::strerror(result)));
+    }
+
+    void *pData = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    if (pData == MAP_FAILED) {
+        int error = errno;
+        ::close(fd);
+        throw std::runtime_error(
+            fmt::format("failed to map {}: {}", path.u8string(), std::strerror(error)));
+    }
+
+    m_fd = fd;
+    m_pData = static_cast<uint8_t *>(pData);
+    m_uSize = size;
+}
+
+void appfw::MappedFile::close(size_t fileSize) {
+    AFW_ASSERT(isOpen());
+    AFW_ASSERT(fileSize <= m_uSize);
+    ::munmap(m_pData, m_uSize);
+    [[maybe_unused]] int result = ::ftruncate(m_fd, (off_t)fileSize);
+    ::close(m_fd);
+
+    m_pData = nullptr;
+    m_uSize = 0;
+    m_fd = -1;
+}
+
+#endif
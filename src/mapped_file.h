@@ -0,0 +1,48 @@
+#ifndef APPFW_MAPPED_FILE_H
+#define APPFW_MAPPED_FILE_H
+#include <cstdint>
+#include <appfw/filesystem.h>
+#include <appfw/platform.h>
+#include <appfw/utils.h>
+
+namespace appfw {
+
+/**
+ * A file of fixed size mapped into memory for writing.
+ * Writes reach the page cache directly and survive a crash of the process.
+ */
+class MappedFile : NoMove {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    /**
+     * Creates (or overwrites) a file of specified size and maps it.
+     * Throws std::runtime_error on failure.
+     */
+    void create(const fs::path &path, size_t size);
+
+    /**
+     * Unmaps the file and truncates it to the specified size.
+     */
+    void close(size_t fileSize);
+
+    inline bool isOpen() const { return m_pData != nullptr; }
+    inline uint8_t *data() const { return m_pData; }
+    inline size_t size() const { return m_uSize; }
+
+private:
+    uint8_t *m_pData = nullptr;
+    size_t m_uSize = 0;
+
+#if PLATFORM_WINDOWS
+    void *m_hFile = nullptr;
+    void *m_hMapping = nullptr;
+#else
+    int m_fd = -1;
+#endif
+};
+
+} // namespace appfw
+
+#endif
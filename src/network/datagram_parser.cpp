@@ -3,6 +3,58 @@
 #include <appfw/dbg.h>
 #include <appfw/network/datagram_parser.h>
 
+//----------------------------------------------------------------
+// DatagramBufferPool
+//----------------------------------------------------------------
+appfw::DatagramBufferPool::DatagramBufferPool(size_t maxBuffers, size_t maxBufferSize)
+    : m_uMaxBuffers(maxBuffers)
+    , m_uMaxBufferSize(maxBufferSize) {}
+
+std::vector<uint8_t> appfw::DatagramBufferPool::acquire(size_t size) {
+    std::vector<uint8_t> buf;
+
+    {
+        std::lock_guard lock(m_Mutex);
+
+        for (size_t i = m_FreeBuffers.size(); i != 0; i--) {
+            if (m_FreeBuffers[i - 1].capacity() >= size) {
+                buf = std::move(m_FreeBuffers[i - 1]);
+                m_FreeBuffers.erase(m_FreeBuffers.begin() + i - 1);
+                break;
+            }
+        }
+    }
+
+    if (buf.size() < size) {
+        buf.resize(size);
+    }
+
+    return buf;
+}
+
+void appfw::DatagramBufferPool::release(std::vector<uint8_t> &&buf) {
+    if (buf.capacity() == 0 || buf.capacity() > m_uMaxBufferSize) {
+        buf = std::vector<uint8_t>();
+        return;
+    }
+
+    std::lock_guard lock(m_Mutex);
+
+    if (m_FreeBuffers.size() < m_uMaxBuffers) {
+        m_FreeBuffers.push_back(std::move(buf));
+    }
+
+    buf = std::vector<uint8_t>();
+}
+
+size_t appfw::DatagramBufferPool::getFreeBufferCount() {
+    std::lock_guard lock(m_Mutex);
+    return m_FreeBuffers.size();
+}
+
+//----------------------------------------------------------------
+// DatagramParser
+//----------------------------------------------------------------
 void appfw::DatagramParser::setMagic(const uint8_t *magic, uint16_t size) {
     AFW_ASSERT(size > 0 && size <= MAX_MAGIC_SIZE);
     std::memcpy(m_Magic, magic, size);
@@ -16,7 +68,15 @@ void appfw::DatagramParser::setMagic(const char *magic, uint16_t size) {
 void appfw::DatagramParser::setMaxPayloadSize(uint32_t size) {
     AFW_ASSERT(size <= MAX_ABSOLUTE_PAYLOAD_SIZE);
     m_uMaxPayloadSize = size;
-    m_ParsedPayload.resize(size);
+}
+
+void appfw::DatagramParser::setRetainedBufferSize(uint32_t size) {
+    m_uRetainedBufferSize = size;
+}
+
+void appfw::DatagramParser::setBufferPool(const std::shared_ptr<DatagramBufferPool> &pool) {
+    releasePayloadBuffer();
+    m_pBufferPool = pool;
 }
 
 void appfw::DatagramParser::setPayloadCallback(const PayloadCallback &cb) {
@@ -27,6 +87,7 @@ void appfw::DatagramParser::reset() {
     m_Stage = Stage::Magic;
     m_uParsedPacketSize = 0;
     m_uParsedPayloadSize = 0;
+    releasePayloadBuffer();
 }
 
 bool appfw::DatagramParser::parseData(const uint8_t *data, uint32_t size, uint32_t &outBytesRead,
@@ -38,12 +99,24 @@ bool appfw::DatagramParser::parseData(const uint8_t *data, uint32_t size, uint32
     while (bytesRead != size) {
         uint32_t readSize = 0; //!< Number of bytes read this iteration
 
+        if (m_Stage == Stage::Magic && m_uParsedPacketSize == 0) {
+            // Start of a packet, try to parse it without copying
+            if (!parseInPlace(data + bytesRead, size - bytesRead, readSize, error)) {
+                return false;
+            }
+
+            if (readSize != 0) {
+                bytesRead += readSize;
+                continue;
+            }
+        }
+
         switch (m_Stage) {
         case Stage::Magic: {
             AFW_ASSERT(m_uParsedPacketSize < m_uMagicSize);
             uint32_t pos = m_uParsedPacketSize;
             uint32_t leftToRead = m_uMagicSize - pos;
-            readSize = std::min(leftToRead, size);
+            readSize = std::min(leftToRead, size - bytesRead);
             std::memcpy(m_ParsedMagic + pos, data + bytesRead, readSize);
             m_uParsedPacketSize += readSize;
 
@@ -63,7 +136,7 @@ bool appfw::DatagramParser::parseData(const uint8_t *data, uint32_t size, uint32
                        m_uParsedPacketSize < m_uMagicSize + sizeof(uint32_t));
             uint32_t pos = m_uParsedPacketSize - m_uMagicSize;
             uint32_t leftToRead = sizeof(uint32_t) - pos;
-            readSize = std::min(leftToRead, size);
+            readSize = std::min(leftToRead, size - bytesRead);
             std::memcpy(m_ParsedPayloadSizeBytes + pos, data + bytesRead, readSize);
             m_uParsedPacketSize += readSize;
 
@@ -72,26 +145,32 @@ bool appfw::DatagramParser::parseData(const uint8_t *data, uint32_t size, uint32
                 std::memcpy(&rawPayloadSize, m_ParsedPayloadSizeBytes, sizeof(uint32_t));
                 m_uParsedPayloadSize = appfw::littleEndianSwap(rawPayloadSize);
 
-                if (m_uParsedPacketSize > m_uMaxPayloadSize) {
+                if (m_uParsedPayloadSize > m_uMaxPayloadSize) {
                     error = Error::PayloadTooLarge;
                     return false;
                 }
 
                 m_Stage = Stage::Payload;
+
+                if (m_uParsedPayloadSize == 0) {
+                    // Nothing else to read
+                    onPayloadParsed(nullptr, 0);
+                    reset();
+                } else {
+                    allocPayloadBuffer();
+                }
             }
             break;
         }
         case Stage::Payload: {
             uint32_t pos = m_uParsedPacketSize - getHeaderSize();
             uint32_t leftToRead = m_uParsedPayloadSize - pos;
-            readSize = std::min(leftToRead, size);
+            readSize = std::min(leftToRead, size - bytesRead);
             std::memcpy(m_ParsedPayload.data() + pos, data + bytesRead, readSize);
             m_uParsedPacketSize += readSize;
 
             if (readSize == leftToRead) {
-                appfw::span<uint8_t> payload(m_ParsedPayload.data(), m_uParsedPayloadSize);
-                appfw::BinaryBuffer binBuf(payload);
-                m_fnPayloadCallback(binBuf, payload.data(), payload.size());
+                onPayloadParsed(m_ParsedPayload.data(), m_uParsedPayloadSize);
                 reset();
             }
             break;
@@ -105,6 +184,67 @@ bool appfw::DatagramParser::parseData(const uint8_t *data, uint32_t size, uint32
     return true;
 }
 
+bool appfw::DatagramParser::parseInPlace(const uint8_t *data, uint32_t size, uint32_t &packetSize,
+                                         Error &error) {
+    packetSize = 0;
+    uint32_t headerSize = getHeaderSize();
+
+    if (size < headerSize) {
+        return true;
+    }
+
+    if (std::memcmp(m_Magic, data, m_uMagicSize)) {
+        error = Error::InvalidMagic;
+        return false;
+    }
+
+    uint32_t rawPayloadSize;
+    std::memcpy(&rawPayloadSize, data + m_uMagicSize, sizeof(uint32_t));
+    uint32_t payloadSize = appfw::littleEndianSwap(rawPayloadSize);
+
+    if (payloadSize > m_uMaxPayloadSize) {
+        error = Error::PayloadTooLarge;
+        return false;
+    }
+
+    if (size - headerSize < payloadSize) {
+        // Packet is split, needs to be reassembled
+        return true;
+    }
+
+    onPayloadParsed(data + headerSize, payloadSize);
+    packetSize = headerSize + payloadSize;
+    return true;
+}
+
+void appfw::DatagramParser::onPayloadParsed(const uint8_t *payload, uint32_t size) {
+    // BinaryBuffer is only used as an input stream so the data is never modified
+    appfw::span<uint8_t> payloadSpan(const_cast<uint8_t *>(payload), size);
+    appfw::BinaryBuffer binBuf(payloadSpan);
+    m_fnPayloadCallback(binBuf, payload, size);
+}
+
+void appfw::DatagramParser::allocPayloadBuffer() {
+    if (m_ParsedPayload.size() >= m_uParsedPayloadSize) {
+        return;
+    }
+
+    if (m_pBufferPool) {
+        m_pBufferPool->release(std::move(m_ParsedPayload));
+        m_ParsedPayload = m_pBufferPool->acquire(m_uParsedPayloadSize);
+    } else {
+        m_ParsedPayload.resize(m_uParsedPayloadSize);
+    }
+}
+
+void appfw::DatagramParser::releasePayloadBuffer() {
+    if (m_pBufferPool) {
+        m_pBufferPool->release(std::move(m_ParsedPayload));
+    } else if (m_ParsedPayload.capacity() > m_uRetainedBufferSize) {
+        m_ParsedPayload = std::vector<uint8_t>();
+    }
+}
+
 std::string_view appfw::DatagramParser::getErrorString(Error error) {
     switch (error) {
     case Error::NoError: return "No error";
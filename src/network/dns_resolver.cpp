@@ -0,0 +1,180 @@
+#include <appfw/network/dns_resolver.h>
+#include <appfw/dbg.h>
+
+appfw::DnsResolver::DnsResolver(unsigned threadCount) {
+    AFW_ASSERT(threadCount > 0);
+
+    for (unsigned i = 0; i < threadCount; i++) {
+        m_Threads.emplace_back([this]() { workerMain(); });
+    }
+}
+
+appfw::DnsResolver::~DnsResolver() {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_bIsStopping = true;
+    }
+
+    m_QueueCv.notify_all();
+
+    for (std::thread &thread : m_Threads) {
+        thread.join();
+    }
+
+    // Fail the rest
+    while (!m_Queue.empty()) {
+        m_Queue.front().promise.set_exception(
+            std::make_exception_ptr(std::runtime_error("resolver was destroyed")));
+        m_Queue.pop();
+    }
+}
+
+void appfw::DnsResolver::setCacheTTL(int time) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_iCacheTTL = time;
+}
+
+void appfw::DnsResolver::setNegativeCacheTTL(int time) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_iNegativeCacheTTL = time;
+}
+
+void appfw::DnsResolver::clearCache() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    for (auto it = m_Cache.begin(); it != m_Cache.end();) {
+        if (it->second.expiry != Clock::time_point::max()) {
+            it = m_Cache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+size_t appfw::DnsResolver::getCacheSize() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Cache.size();
+}
+
+appfw::DnsResolver::ResultFuture appfw::DnsResolver::resolve(const std::string &hostname,
+                                                            const std::string &port,
+                                                            SockType type,
+                                                            AddressFamily family) {
+    std::string key = hostname;
+    key += '\0';
+    key += port;
+    key += '\0';
+    key += (char)type;
+    key += (char)family;
+
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    auto it = m_Cache.find(key);
+
+    if (it != m_Cache.end()) {
+        if (it->second.expiry > Clock::now()) {
+            // Cached or running
+            return it->second.result;
+        }
+
+        m_Cache.erase(it);
+    }
+
+    Request req;
+    req.hostname = hostname;
+    req.port = port;
+    req.type = type;
+    req.family = family;
+
+    CacheEntry entry;
+    entry.result = req.promise.get_future().share();
+    ResultFuture result = entry.result;
+
+    m_Cache.emplace(key, std::move(entry));
+    req.key = std::move(key);
+    m_Queue.push(std::move(req));
+
+    lock.unlock();
+    m_QueueCv.notify_one();
+
+    return result;
+}
+
+void appfw::DnsResolver::resolve(const std::string &hostname, const std::string &port,
+                                 SockType type, AddressFamily family, Callback cb) {
+    m_Callbacks.push_back({resolve(hostname, port, type, family), std::move(cb)});
+}
+
+void appfw::DnsResolver::tick() {
+    // Callbacks may start new lookups
+    for (size_t i = 0; i < m_Callbacks.size();) {
+        if (isFutureReady(m_Callbacks[i].result)) {
+            PendingCallback item = std::move(m_Callbacks[i]);
+            m_Callbacks.erase(m_Callbacks.begin() + i);
+            item.callback(item.result);
+        } else {
+            i++;
+        }
+    }
+
+    Clock::time_point now = Clock::now();
+
+    if (now - m_LastPurgeTime >= std::chrono::milliseconds(PURGE_PERIOD)) {
+        m_LastPurgeTime = now;
+        purgeExpired(now);
+    }
+}
+
+void appfw::DnsResolver::workerMain() {
+    for (;;) {
+        Request req;
+
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_QueueCv.wait(lock, [this]() { return m_bIsStopping || !m_Queue.empty(); });
+
+            if (m_bIsStopping) {
+                return;
+            }
+
+            req = std::move(m_Queue.front());
+            m_Queue.pop();
+        }
+
+        AddrList result;
+        std::exception_ptr error;
+
+        try {
+            result = resolveHostName(req.hostname, req.port, req.type, req.family);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        // Entry must be expirable by the time the future is ready
+        {
+            // Running entries are never removed
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            auto it = m_Cache.find(req.key);
+            AFW_ASSERT(it != m_Cache.end());
+            int ttl = error ? m_iNegativeCacheTTL : m_iCacheTTL;
+            it->second.expiry = Clock::now() + std::chrono::milliseconds(ttl);
+        }
+
+        if (error) {
+            req.promise.set_exception(error);
+        } else {
+            req.promise.set_value(std::move(result));
+        }
+    }
+}
+
+void appfw::DnsResolver::purgeExpired(Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    for (auto it = m_Cache.begin(); it != m_Cache.end();) {
+        if (it->second.expiry <= now) {
+            it = m_Cache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
@@ -0,0 +1,158 @@
+#include <cstring>
+#include <appfw/binary_buffer.h>
+#include <appfw/network/framed_tcp_server.h>
+
+appfw::FramedTcpServer::FramedTcpServer() {
+    m_Server.setConnAcceptedCallback(
+        [this](size_t index, TcpClientSocketPtr socket) { onConnAccepted(index, socket); });
+    m_Server.setConnClosedCallback(
+        [this](size_t index, TcpClientSocketPtr socket, SocketCloseReason reason) {
+            onConnClosed(index, socket, reason);
+        });
+    m_Server.setReadyReadCallback(
+        [this](size_t index, TcpClientSocketPtr socket) { onReadyRead(index, socket); });
+
+    m_pBufferPool = std::make_shared<DatagramBufferPool>();
+}
+
+appfw::FramedTcpServer::~FramedTcpServer() {
+    // Connections must be closed while m_Connections still exists
+    stopListening();
+}
+
+void appfw::FramedTcpServer::setMagic(const uint8_t *magic, uint16_t size) {
+    AFW_ASSERT(size > 0 && size <= DatagramParser::MAX_MAGIC_SIZE);
+    std::memcpy(m_Magic, magic, size);
+    m_uMagicSize = size;
+}
+
+void appfw::FramedTcpServer::setMagic(const char *magic, uint16_t size) {
+    setMagic(reinterpret_cast<const uint8_t *>(magic), size);
+}
+
+void appfw::FramedTcpServer::setMaxPayloadSize(uint32_t size) {
+    AFW_ASSERT(size <= DatagramParser::MAX_ABSOLUTE_PAYLOAD_SIZE);
+    m_uMaxPayloadSize = size;
+}
+
+void appfw::FramedTcpServer::startListening(IPAddress4 ip, uint16_t port, int queueSize) {
+    startListening(SockAddr(ip, port), queueSize);
+}
+
+void appfw::FramedTcpServer::startListening(const SockAddr &addr, int queueSize) {
+    AFW_ASSERT_MSG(m_uMagicSize > 0, "Magic must be set before listening");
+    m_Server.startListening(addr, queueSize);
+}
+
+void appfw::FramedTcpServer::stopListening() {
+    m_Server.stopListening();
+    m_Connections.clear();
+}
+
+void appfw::FramedTcpServer::poll(int time) {
+    m_Server.poll(time);
+}
+
+void appfw::FramedTcpServer::sendPayload(TcpClientSocket &socket,
+                                         appfw::span<const uint8_t> payload) {
+    AFW_ASSERT(m_uMagicSize > 0);
+    AFW_ASSERT(payload.size() <= m_uMaxPayloadSize);
+
+    size_t packetSize = m_uMagicSize + sizeof(uint32_t) + payload.size();
+
+    if (m_SendBuffer.size() < packetSize) {
+        m_SendBuffer.resize(packetSize);
+    }
+
+    BinaryBuffer stream(appfw::span(m_SendBuffer.data(), packetSize));
+    stream.writeBytes(m_Magic, m_uMagicSize);
+    stream.writeUInt32((uint32_t)payload.size());
+    stream.writeBytes(payload.data(), payload.size());
+
+    socket.writeAll(appfw::span<const uint8_t>(m_SendBuffer.data(), packetSize));
+}
+
+void appfw::FramedTcpServer::setConnAcceptedCallback(const ConnAcceptedCallback &fn) {
+    m_fnAcceptedCb = fn;
+}
+
+void appfw::FramedTcpServer::setConnClosedCallback(const ConnClosedCallback &fn) {
+    m_fnClosedCb = fn;
+}
+
+void appfw::FramedTcpServer::setPayloadCallback(const PayloadCallback &fn) {
+    m_fnPayloadCb = fn;
+}
+
+void appfw::FramedTcpServer::onConnAccepted(size_t index, TcpClientSocketPtr socket) {
+    auto conn = std::make_unique<Connection>();
+    Connection *pConn = conn.get();
+    pConn->socket = socket;
+    pConn->index = index;
+    pConn->parser.setMagic(m_Magic, m_uMagicSize);
+    pConn->parser.setMaxPayloadSize(m_uMaxPayloadSize);
+    pConn->parser.setBufferPool(m_pBufferPool);
+    pConn->parser.reset();
+    pConn->parser.setPayloadCallback(
+        [this, pConn](BinaryInputStream &stream, const uint8_t *payload, size_t size) {
+            // Callback may have closed the socket, drop the rest of the data
+            if (pConn->socket->isOpen() && m_fnPayloadCb) {
+                m_fnPayloadCb(pConn->index, pConn->socket, stream,
+                              appfw::span<const uint8_t>(payload, size));
+            }
+        });
+
+    m_Connections.insert({socket.get(), std::move(conn)});
+
+    if (m_fnAcceptedCb) {
+        m_fnAcceptedCb(index, socket);
+    }
+}
+
+void appfw::FramedTcpServer::onConnClosed(size_t index, TcpClientSocketPtr socket,
+                                          SocketCloseReason reason) {
+    if (m_fnClosedCb) {
+        m_fnClosedCb(index, socket, reason);
+    }
+
+    m_Connections.erase(socket.get());
+}
+
+void appfw::FramedTcpServer::onReadyRead(size_t index, TcpClientSocketPtr socket) {
+    auto it = m_Connections.find(socket.get());
+    AFW_ASSERT(it != m_Connections.end());
+    Connection &conn = *it->second;
+    conn.index = index;
+
+    RecvRingBuffer &buf = socket->getRecvBuffer();
+
+    while (socket->isOpen()) {
+        try {
+            socket->receive();
+        } catch (const NetworkErrorException &) {
+            // Socket was closed by receive()
+            return;
+        }
+
+        // Full buffer means there may be more data in the socket
+        bool isFull = buf.full();
+        RecvRingBuffer::ReadView view = buf.readable();
+
+        for (appfw::span<const uint8_t> part : {view.first, view.second}) {
+            uint32_t bytesParsed = 0;
+            DatagramParser::Error error = DatagramParser::Error::NoError;
+
+            if (!part.empty() &&
+                !conn.parser.parseData(part.data(), (uint32_t)part.size(), bytesParsed, error)) {
+                socket->close(SocketCloseReason::InvalidData);
+                return;
+            }
+        }
+
+        buf.consume(view.size());
+
+        if (!isFull) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,280 @@
+#include "io_uring.h"
+
+#if APPFW_IO_URING
+
+#include <algorithm>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/utsname.h>
+#include <unistd.h>
+#include <appfw/dbg.h>
+#include <appfw/network/socket.h>
+
+namespace {
+
+int sysIoUringSetup(unsigned entries, io_uring_params *p) {
+    return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+int sysIoUringRegister(int fd, unsigned opcode, const void *arg, unsigned nrArgs) {
+    return (int)syscall(__NR_io_uring_register, fd, opcode, arg, nrArgs);
+}
+
+bool checkKernelVersion(int reqMajor, int reqMinor) {
+    utsname name;
+
+    if (uname(&name) != 0) {
+        return false;
+    }
+
+    int major = 0, minor = 0;
+
+    if (std::sscanf(name.release, "%d.%d", &major, &minor) != 2) {
+        return false;
+    }
+
+    return major > reqMajor || (major == reqMajor && minor >= reqMinor);
+}
+
+} // namespace
+
+appfw::platsock::IoUring::~IoUring() {
+    if (m_pBufRing) {
+        munmap(m_pBufRing, m_uBufRingSize);
+    }
+
+    if (m_pBufData) {
+        munmap(m_pBufData, (size_t)m_uBufCount * m_uBufSize);
+    }
+
+    if (m_pSqes) {
+        munmap(m_pSqes, m_uSqesSize);
+    }
+
+    if (m_pCqRingPtr && m_pCqRingPtr != m_pSqRingPtr) {
+        munmap(m_pCqRingPtr, m_uCqRingSize);
+    }
+
+    if (m_pSqRingPtr) {
+        munmap(m_pSqRingPtr, m_uSqRingSize);
+    }
+
+    // Closing the ring cancels all pending requests
+    if (m_iRingFd != -1) {
+        ::close(m_iRingFd);
+    }
+}
+
+bool appfw::platsock::IoUring::isSupported() {
+    static const bool isSupported = []() {
+        // Multishot recv was added in 6.0
+        if (!checkKernelVersion(6, 0)) {
+            return false;
+        }
+
+        try {
+            IoUring ring;
+            ring.init(4);
+            ring.registerBufRing(0, 1, 4096);
+            return true;
+        } catch (const std::exception &) {
+            // io_uring is disabled or blocked (e.g. by seccomp)
+            return false;
+        }
+    }();
+
+    return isSupported;
+}
+
+void appfw::platsock::IoUring::init(unsigned entries) {
+    AFW_ASSERT(!isInitialized());
+
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+
+    // Multishot requests produce many completions per submission
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = entries * 4;
+
+    m_iRingFd = sysIoUringSetup(entries, &params);
+
+    if (m_iRingFd < 0) {
+        m_iRingFd = -1;
+        throw SocketErrorException("io_uring_setup() failed");
+    }
+
+    constexpr unsigned REQUIRED_FEATURES =
+        IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG;
+
+    if ((params.features & REQUIRED_FEATURES) != REQUIRED_FEATURES) {
+        throw SocketErrorException("io_uring features not supported", ENOSYS);
+    }
+
+    // Map the rings. Both are in one mapping with IORING_FEAT_SINGLE_MMAP.
+    m_uSqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    m_uCqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    m_uSqRingSize = std::max(m_uSqRingSize, m_uCqRingSize);
+    m_uCqRingSize = m_uSqRingSize;
+
+    void *ringPtr = mmap(nullptr, m_uSqRingSize, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, m_iRingFd, IORING_OFF_SQ_RING);
+
+    if (ringPtr == MAP_FAILED) {
+        throw SocketErrorException("mmap(IORING_OFF_SQ_RING) failed");
+    }
+
+    m_pSqRingPtr = ringPtr;
+    m_pCqRingPtr = ringPtr;
+
+    void *sqesPtr = mmap(nullptr, params.sq_entries * sizeof(io_uring_sqe),
+                         PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_iRingFd,
+                         IORING_OFF_SQES);
+
+    if (sqesPtr == MAP_FAILED) {
+        throw SocketErrorException("mmap(IORING_OFF_SQES) failed");
+    }
+
+    m_pSqes = static_cast<io_uring_sqe *>(sqesPtr);
+    m_uSqesSize = params.sq_entries * sizeof(io_uring_sqe);
+
+    uint8_t *sq = static_cast<uint8_t *>(m_pSqRingPtr);
+    m_pSqHead = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+    m_pSqTail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    m_uSqMask = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    m_pSqArray = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    m_uSqEntries = params.sq_entries;
+    m_uSqLocalTail = *m_pSqTail;
+
+    uint8_t *cq = static_cast<uint8_t *>(m_pCqRingPtr);
+    m_pCqHead = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    m_pCqTail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    m_uCqMask = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    m_pCqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+}
+
+io_uring_sqe *appfw::platsock::IoUring::getSqe() {
+    unsigned head = __atomic_load_n(m_pSqHead, __ATOMIC_ACQUIRE);
+
+    if (m_uSqLocalTail - head >= m_uSqEntries) {
+        // Queue is full
+        submit();
+        head = __atomic_load_n(m_pSqHead, __ATOMIC_ACQUIRE);
+        AFW_ASSERT(m_uSqLocalTail - head < m_uSqEntries);
+    }
+
+    unsigned idx = m_uSqLocalTail & m_uSqMask;
+    io_uring_sqe *sqe = &m_pSqes[idx];
+    std::memset(sqe, 0, sizeof(*sqe));
+    m_pSqArray[idx] = idx;
+    m_uSqLocalTail++;
+    m_uToSubmit++;
+
+    // Publish the entry
+    __atomic_store_n(m_pSqTail, m_uSqLocalTail, __ATOMIC_RELEASE);
+    return sqe;
+}
+
+void appfw::platsock::IoUring::submitAndWait(int timeout) {
+    unsigned flags = IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+    unsigned minComplete = timeout == 0 ? 0 : 1;
+
+    __kernel_timespec ts;
+    io_uring_getevents_arg arg;
+    std::memset(&arg, 0, sizeof(arg));
+    arg.sigmask_sz = _NSIG / 8;
+
+    if (timeout > 0) {
+        ts.tv_sec = timeout / 1000;
+        ts.tv_nsec = (long long)(timeout % 1000) * 1'000'000;
+        arg.ts = reinterpret_cast<uint64_t>(&ts);
+    }
+
+    int result = enter(m_uToSubmit, minComplete, flags, &arg, sizeof(arg));
+
+    if (result < 0 && errno != ETIME && errno != EINTR) {
+        throw SocketErrorException("io_uring_enter() failed");
+    }
+}
+
+void appfw::platsock::IoUring::registerBufRing(uint16_t groupId, unsigned count,
+                                               unsigned size) {
+    AFW_ASSERT(!m_pBufRing);
+    AFW_ASSERT(count > 0 && (count & (count - 1)) == 0 && count <= 32768);
+
+    m_uBufRingSize = count * sizeof(io_uring_buf);
+    void *ringPtr = mmap(nullptr, m_uBufRingSize, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (ringPtr == MAP_FAILED) {
+        throw SocketErrorException("mmap(buf ring) failed");
+    }
+
+    m_pBufRing = static_cast<io_uring_buf_ring *>(ringPtr);
+
+    void *dataPtr = mmap(nullptr, (size_t)count * size, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (dataPtr == MAP_FAILED) {
+        throw SocketErrorException("mmap(buffers) failed");
+    }
+
+    m_pBufData = static_cast<uint8_t *>(dataPtr);
+    m_uBufCount = count;
+    m_uBufSize = size;
+
+    io_uring_buf_reg reg;
+    std::memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = reinterpret_cast<uint64_t>(m_pBufRing);
+    reg.ring_entries = count;
+    reg.bgid = groupId;
+
+    if (sysIoUringRegister(m_iRingFd, IORING_REGISTER_PBUF_RING, &reg, 1) != 0) {
+        throw SocketErrorException("io_uring_register(IORING_REGISTER_PBUF_RING) failed");
+    }
+
+    for (unsigned i = 0; i < count; i++) {
+        returnBuffer((uint16_t)i);
+    }
+}
+
+void appfw::platsock::IoUring::returnBuffer(uint16_t bid) {
+    // The tail is only written by us
+    uint16_t tail = m_pBufRing->tail;
+
+    // Not using bufs: the empty struct in __DECLARE_FLEX_ARRAY has non-zero size in C++
+    io_uring_buf *bufs = reinterpret_cast<io_uring_buf *>(m_pBufRing);
+    io_uring_buf &buf = bufs[tail & (m_uBufCount - 1)];
+    buf.addr = reinterpret_cast<uint64_t>(getBuffer(bid));
+    buf.len = m_uBufSize;
+    buf.bid = bid;
+    __atomic_store_n(&m_pBufRing->tail, (uint16_t)(tail + 1), __ATOMIC_RELEASE);
+    m_uAvailBufs++;
+    AFW_ASSERT(m_uAvailBufs <= m_uBufCount);
+}
+
+int appfw::platsock::IoUring::enter(unsigned toSubmit, unsigned minComplete, unsigned flags,
+                                    void *arg, size_t argSize) {
+    int result = (int)syscall(__NR_io_uring_enter, m_iRingFd, toSubmit, minComplete, flags, arg,
+                              argSize);
+
+    if (result >= 0) {
+        // Kernel consumed the entries
+        AFW_ASSERT((unsigned)result <= m_uToSubmit);
+        m_uToSubmit -= (unsigned)result;
+    }
+
+    return result;
+}
+
+void appfw::platsock::IoUring::submit() {
+    int result = enter(m_uToSubmit, 0, 0, nullptr, 0);
+
+    if (result < 0 && errno != EINTR) {
+        throw SocketErrorException("io_uring_enter() failed");
+    }
+}
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef APPFW_NETWORK_IO_URING_H
+#define APPFW_NETWORK_IO_URING_H
+#include <appfw/utils.h>
+
+#if APPFW_IO_URING
+
+#include <cstdint>
+#include <linux/io_uring.h>
+
+namespace appfw::platsock {
+
+/**
+ * A minimal io_uring wrapper using the raw system calls.
+ * Only used from one thread.
+ */
+class IoUring : NoMove {
+public:
+    IoUring() = default;
+    ~IoUring();
+
+    /**
+     * Checks whether the kernel supports everything needed by the network backend:
+     * multishot accept and recv with provided buffer rings (Linux 6.0+).
+     */
+    static bool isSupported();
+
+    /**
+     * Creates the ring. Throws SocketErrorException on failure.
+     * @param   entries     Size of the submission queue
+     */
+    void init(unsigned entries);
+
+    /**
+     * @return whether init was called
+     */
+    inline bool isInitialized() { return m_iRingFd != -1; }
+
+    /**
+     * Returns a cleared SQE. Submits queued SQEs if the queue is full.
+     */
+    io_uring_sqe *getSqe();
+
+    /**
+     * Submits queued SQEs and waits for at least one completion.
+     * @param   timeout Time to wait in ms (0 - don't wait, -1 - indefinitely)
+     */
+    void submitAndWait(int timeout);
+
+    /**
+     * Calls fn(const io_uring_cqe &) for every available completion and consumes them.
+     * @return  number of completions
+     */
+    template <typename T>
+    unsigned processCompletions(T fn);
+
+    /**
+     * Registers a provided buffer ring.
+     * @param   groupId     Buffer group id
+     * @param   count       Number of buffers, power of 2
+     * @param   size        Size of each buffer
+     */
+    void registerBufRing(uint16_t groupId, unsigned count, unsigned size);
+
+    /**
+     * @return data of a provided buffer
+     */
+    inline uint8_t *getBuffer(uint16_t bid) { return m_pBufData + (size_t)bid * m_uBufSize; }
+
+    /**
+     * Gives a provided buffer back to the kernel.
+     */
+    void returnBuffer(uint16_t bid);
+
+    /**
+     * @return the number of provided buffers available to the kernel
+     */
+    inline unsigned getAvailableBuffers() { return m_uAvailBufs; }
+
+    /**
+     * Marks a buffer as taken by the kernel (when a CQE with IORING_CQE_F_BUFFER arrives).
+     */
+    inline void onBufferUsed() { m_uAvailBufs--; }
+
+private:
+    int m_iRingFd = -1;
+
+    // Submission queue
+    void *m_pSqRingPtr = nullptr;
+    size_t m_uSqRingSize = 0;
+    unsigned *m_pSqTail = nullptr;
+    unsigned *m_pSqHead = nullptr;
+    unsigned m_uSqMask = 0;
+    unsigned *m_pSqArray = nullptr;
+    io_uring_sqe *m_pSqes = nullptr;
+    size_t m_uSqesSize = 0;
+    unsigned m_uSqEntries = 0;
+    unsigned m_uSqLocalTail = 0;
+    unsigned m_uToSubmit = 0;
+
+    // Completion queue
+    void *m_pCqRingPtr = nullptr;
+    size_t m_uCqRingSize = 0;
+    unsigned *m_pCqHead = nullptr;
+    unsigned *m_pCqTail = nullptr;
+    unsigned m_uCqMask = 0;
+    io_uring_cqe *m_pCqes = nullptr;
+
+    // Provided buffers
+    io_uring_buf_ring *m_pBufRing = nullptr;
+    size_t m_uBufRingSize = 0;
+    uint8_t *m_pBufData = nullptr;
+    unsigned m_uBufCount = 0;
+    unsigned m_uBufSize = 0;
+    unsigned m_uAvailBufs = 0;
+
+    int enter(unsigned toSubmit, unsigned minComplete, unsigned flags, void *arg, size_t argSize);
+    void submit();
+};
+
+template <typename T>
+inline unsigned IoUring::processCompletions(T fn) {
+    unsigned head = *m_pCqHead;
+    unsigned tail = __atomic_load_n(m_pCqTail, __ATOMIC_ACQUIRE);
+    unsigned count = 0;
+
+    for (; head != tail; head++, count++) {
+        fn(m_pCqes[head & m_uCqMask]);
+    }
+
+    __atomic_store_n(m_pCqHead, head, __ATOMIC_RELEASE);
+    return count;
+}
+
+} // namespace appfw::platsock
+
+#endif
+
+#endif
@@ -0,0 +1,140 @@
+#include <appfw/appfw.h>
+#include <appfw/network/net_metrics.h>
+
+//----------------------------------------------------------------
+// ConnMetrics
+//----------------------------------------------------------------
+const char *appfw::getCloseReasonName(SocketCloseReason reason) {
+    switch (reason) {
+    case SocketCloseReason::Failure:
+        return "Failure";
+    case SocketCloseReason::ConnAborted:
+        return "ConnAborted";
+    case SocketCloseReason::TimeOut:
+        return "TimeOut";
+    case SocketCloseReason::User:
+        return "User";
+    case SocketCloseReason::Shutdown:
+        return "Shutdown";
+    case SocketCloseReason::InvalidData:
+        return "InvalidData";
+    }
+
+    return "Unknown";
+}
+
+appfw::ConnMetrics::Snapshot appfw::ConnMetrics::getSnapshot() const {
+    Snapshot s;
+    s.uBytesIn = bytesIn.get();
+    s.uBytesOut = bytesOut.get();
+    s.uRecvCalls = recvCalls.get();
+    s.uSendCalls = sendCalls.get();
+    return s;
+}
+
+//----------------------------------------------------------------
+// ServerMetrics
+//----------------------------------------------------------------
+appfw::ServerMetrics::ServerMetrics() {
+    std::lock_guard lock(getListMutex());
+    getList().insert(this);
+}
+
+appfw::ServerMetrics::~ServerMetrics() {
+    std::lock_guard lock(getListMutex());
+    getList().erase(this);
+}
+
+void appfw::ServerMetrics::setName(std::string_view name) {
+    std::lock_guard lock(getListMutex());
+    m_Name = name;
+}
+
+appfw::ServerMetrics::Snapshot appfw::ServerMetrics::getSnapshot() const {
+    Snapshot s;
+    s.uAccepts = accepts.get();
+    s.uRejects = rejects.get();
+
+    for (size_t i = 0; i < SOCKET_CLOSE_REASON_COUNT; i++) {
+        s.uCloses[i] = closes[i].get();
+    }
+
+    s.uConnections = connections.get();
+    s.traffic = traffic.getSnapshot();
+    s.uSendQueueBytes = sendQueueBytes.get();
+    s.uMaxSendQueueBytes = maxSendQueueBytes.get();
+    s.uPolls = polls.get();
+    s.uPollEvents = pollEvents.get();
+    s.uMaxPollEvents = maxPollEvents.get();
+    s.uPollProcessTimeUs = pollProcessTimeUs.get();
+    s.uMaxPollProcessTimeUs = maxPollProcessTimeUs.get();
+    return s;
+}
+
+void appfw::ServerMetrics::reset() {
+    accepts.set(0);
+    rejects.set(0);
+
+    for (MetricCounter &i : closes) {
+        i.set(0);
+    }
+
+    // Connections and send queue size are current values
+    traffic.bytesIn.set(0);
+    traffic.bytesOut.set(0);
+    traffic.recvCalls.set(0);
+    traffic.sendCalls.set(0);
+    maxSendQueueBytes.set(0);
+    polls.set(0);
+    pollEvents.set(0);
+    maxPollEvents.set(0);
+    pollProcessTimeUs.set(0);
+    maxPollProcessTimeUs.set(0);
+}
+
+std::mutex &appfw::ServerMetrics::getListMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::set<appfw::ServerMetrics *> &appfw::ServerMetrics::getList() {
+    static std::set<ServerMetrics *> list;
+    return list;
+}
+
+//----------------------------------------------------------------
+// Console commands
+//----------------------------------------------------------------
+static ConCommand cmd_net_stats("net_stats", "Prints connection and traffic counters of TCP servers", []() {
+    size_t count = 0;
+
+    appfw::ServerMetrics::forEach([&](appfw::ServerMetrics &metrics) {
+        appfw::ServerMetrics::Snapshot s = metrics.getSnapshot();
+        count++;
+
+        printn("{}:", metrics.getName().empty() ? "(not listening)" : metrics.getName());
+        printi("  connections: {}, accepts: {}, rejects: {}", s.uConnections, s.uAccepts,
+               s.uRejects);
+
+        for (size_t i = 0; i < appfw::SOCKET_CLOSE_REASON_COUNT; i++) {
+            if (s.uCloses[i] != 0) {
+                printi("  closed ({}): {}", appfw::getCloseReasonName((appfw::SocketCloseReason)i),
+                       s.uCloses[i]);
+            }
+        }
+
+        printi("  in: {} bytes in {} reads", s.traffic.uBytesIn, s.traffic.uRecvCalls);
+        printi("  out: {} bytes in {} sends", s.traffic.uBytesOut, s.traffic.uSendCalls);
+        printi("  send queue: {} bytes (max {})", s.uSendQueueBytes, s.uMaxSendQueueBytes);
+        printi("  polls: {}, events per poll: {:.2f} avg, {} max", s.uPolls, s.getAvgPollEvents(),
+               s.uMaxPollEvents);
+        printi("  poll processing time: {:.1f} us avg, {} us max", s.getAvgPollProcessTime(),
+               s.uMaxPollProcessTimeUs);
+    });
+
+    printi("Total: {} server{}", count, count == 1 ? "" : "s");
+});
+
+static ConCommand cmd_net_stats_reset("net_stats_reset", "Resets counters of TCP servers", []() {
+    appfw::ServerMetrics::forEach([](appfw::ServerMetrics &metrics) { metrics.reset(); });
+});
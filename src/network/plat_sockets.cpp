@@ -1,3 +1,5 @@
+#include <cstring>
+#include <fmt/format.h>
 #include <appfw/dbg.h>
 #include "plat_sockets.h"
 
@@ -43,7 +45,7 @@ void appfw::platsock::initNetworking() {
 
 appfw::platsock::AcceptResult
 appfw::platsock::acceptConnection(SocketFile fd, SocketFile &remoteSock,
-                                                              SockAddr4 &remoteAddr) {
+                                                              SockAddr &remoteAddr) {
     sockaddr_storage remoteSockAddr;
     memset(&remoteSockAddr, 0, sizeof(remoteSockAddr));
     int remoteAddrSize = sizeof(remoteSockAddr);
@@ -60,15 +62,26 @@ appfw::platsock::acceptConnection(SocketFile fd, SocketFile &remoteSock,
         case WSAECONNRESET: {
             return AcceptResult::BadAccept;
         }
+        case WSAEMFILE:
+        case WSAENOBUFS: {
+            return AcceptResult::NoResources;
+        }
         default: {
             throw SocketErrorException("accept() failed");
         }
         }
     }
 
-    AFW_ASSERT(remoteSockAddr.ss_family == AF_INET);
+    if (!setSocketBlockingMode(sock, false)) {
+        SockFd sockFd(sock);
+        return AcceptResult::BadAccept;
+    }
+
+    // IPv4 clients of dual-stack sockets have IPv4-mapped addresses
     remoteSock = sock;
-    remoteAddr = SockAddr4::fromSockAddrStruct(*reinterpret_cast<sockaddr_in *>(&remoteSockAddr));
+    remoteAddr = SockAddr::fromSockAddrStruct(reinterpret_cast<sockaddr *>(&remoteSockAddr),
+                                              (size_t)remoteAddrSize)
+                     .unmapped();
     return AcceptResult::Accepted;
 }
 
@@ -83,10 +96,32 @@ bool appfw::platsock::setSocketBlockingMode(SocketFile socket, bool block) {
     return ioctlsocket(socket, FIONBIO, &iMode) == 0;
 }
 
+int appfw::platsock::readVec(SocketFile fd, appfw::span<uint8_t> buf1,
+                             appfw::span<uint8_t> buf2) {
+    WSABUF bufs[2];
+    bufs[0].buf = reinterpret_cast<CHAR *>(buf1.data());
+    bufs[0].len = (ULONG)buf1.size();
+    bufs[1].buf = reinterpret_cast<CHAR *>(buf2.data());
+    bufs[1].len = (ULONG)buf2.size();
+
+    DWORD bytesRead = 0;
+    DWORD flags = 0;
+    int result = ::WSARecv(fd, bufs, buf2.empty() ? 1 : 2, &bytesRead, &flags, nullptr, nullptr);
+    return result == 0 ? (int)bytesRead : -1;
+}
+
 int appfw::platsock::poll(pollfd *ufds, unsigned int nfds, int timeout) {
     return ::WSAPoll(ufds, nfds, timeout);
 }
 
+void appfw::platsock::removeUnixSocketFile(const SockAddr &) {
+    // Not supported.
+}
+
+void appfw::platsock::removeStaleUnixSocketFile(const SockAddr &) {
+    // Not supported.
+}
+
 #elif PLATFORM_UNIX
 
 static_assert(std::is_same_v<appfw::SocketFile, int>, "SocketFile != int");
@@ -98,12 +133,18 @@ void appfw::platsock::initNetworking() {
 
 appfw::platsock::AcceptResult
 appfw::platsock::acceptConnection(SocketFile fd, SocketFile &remoteSock,
-                                                              SockAddr4 &remoteAddr) {
+                                                              SockAddr &remoteAddr) {
     sockaddr_storage remoteSockAddr;
     memset(&remoteSockAddr, 0, sizeof(remoteSockAddr));
     socklen_t remoteAddrSize = sizeof(remoteSockAddr);
 
+#if PLATFORM_LINUX
+    // Saves two fcntl calls per connection
+    SocketFile sock = ::accept4(fd, reinterpret_cast<sockaddr *>(&remoteSockAddr),
+                                &remoteAddrSize, SOCK_NONBLOCK | SOCK_CLOEXEC);
+#else
     SocketFile sock = ::accept(fd, reinterpret_cast<sockaddr *>(&remoteSockAddr), &remoteAddrSize);
+#endif
 
     if (sock == NULL_SOCKET) {
         int error = errno;
@@ -114,18 +155,35 @@ appfw::platsock::acceptConnection(SocketFile fd, SocketFile &remoteSock,
         case EWOULDBLOCK: {
             return AcceptResult::WouldBlock;
         }
-        case ECONNABORTED: {
+        case ECONNABORTED:
+        case EINTR:
+        case EPROTO: {
             return AcceptResult::BadAccept;
         }
+        case EMFILE:
+        case ENFILE:
+        case ENOBUFS:
+        case ENOMEM: {
+            return AcceptResult::NoResources;
+        }
         default: {
             throw SocketErrorException("accept() failed");
         }
         }
     }
 
-    AFW_ASSERT(remoteSockAddr.ss_family == AF_INET);
+#if !PLATFORM_LINUX
+    if (!setSocketBlockingMode(sock, false) || ::fcntl(sock, F_SETFD, FD_CLOEXEC) == -1) {
+        SockFd sockFd(sock);
+        return AcceptResult::BadAccept;
+    }
+#endif
+
+    // IPv4 clients of dual-stack sockets have IPv4-mapped addresses
     remoteSock = sock;
-    remoteAddr = SockAddr4::fromSockAddrStruct(*reinterpret_cast<sockaddr_in *>(&remoteSockAddr));
+    remoteAddr = SockAddr::fromSockAddrStruct(reinterpret_cast<sockaddr *>(&remoteSockAddr),
+                                              (size_t)remoteAddrSize)
+                     .unmapped();
     return AcceptResult::Accepted;
 }
 
@@ -147,10 +205,254 @@ bool appfw::platsock::setSocketBlockingMode(SocketFile socket, bool block) {
     return true;
 }
 
+int appfw::platsock::readVec(SocketFile fd, appfw::span<uint8_t> buf1,
+                             appfw::span<uint8_t> buf2) {
+    iovec iov[2];
+    iov[0].iov_base = buf1.data();
+    iov[0].iov_len = buf1.size();
+    iov[1].iov_base = buf2.data();
+    iov[1].iov_len = buf2.size();
+    return (int)::readv(fd, iov, buf2.empty() ? 1 : 2);
+}
+
 int appfw::platsock::poll(pollfd *ufds, unsigned int nfds, int timeout) {
     return ::poll(ufds, nfds, timeout);
 }
 
+void appfw::platsock::removeUnixSocketFile(const SockAddr &addr) {
+    if (!addr.isUnix()) {
+        return;
+    }
+
+    std::string path = addr.getUnixPath();
+
+    if (path.empty() || path[0] == '\0') {
+        // Unnamed or abstract, no file
+        return;
+    }
+
+    struct stat st;
+
+    if (::stat(path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode)) {
+        ::unlink(path.c_str());
+    }
+}
+
+void appfw::platsock::removeStaleUnixSocketFile(const SockAddr &addr) {
+    if (!addr.isUnix()) {
+        return;
+    }
+
+    std::string path = addr.getUnixPath();
+    struct stat st;
+
+    if (path.empty() || path[0] == '\0' || ::stat(path.c_str(), &st) != 0 ||
+        !S_ISSOCK(st.st_mode)) {
+        // Not a socket file
+        return;
+    }
+
+    SocketFile probeFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if (probeFd == NULL_SOCKET) {
+        return;
+    }
+
+    SockFd probe(probeFd);
+
+    // Non-blocking so a live server with a full backlog doesn't block the probe
+    if (!setSocketBlockingMode(probe.get(), false)) {
+        return;
+    }
+
+    if (::connect(probe.get(), addr.getSockAddrStruct(), addr.getSockAddrSize()) != 0 &&
+        errno == ECONNREFUSED) {
+        // Nothing is listening
+        ::unlink(path.c_str());
+    }
+}
+
+int appfw::platsock::sendWithFds(SocketFile fd, appfw::span<const uint8_t> buf,
+                                 appfw::span<const int> fds) {
+    AFW_ASSERT(!buf.empty());
+    AFW_ASSERT(fds.size() <= MAX_PASSED_FDS);
+
+    iovec iov;
+    iov.iov_base = const_cast<uint8_t *>(buf.data());
+    iov.iov_len = buf.size();
+
+    alignas(cmsghdr) uint8_t control[CMSG_SPACE(sizeof(int) * MAX_PASSED_FDS)];
+
+    msghdr msg = {};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+
+    if (!fds.empty()) {
+        msg.msg_control = control;
+        msg.msg_controllen = CMSG_SPACE(sizeof(int) * fds.size());
+
+        cmsghdr *cm = CMSG_FIRSTHDR(&msg);
+        cm->cmsg_level = SOL_SOCKET;
+        cm->cmsg_type = SCM_RIGHTS;
+        cm->cmsg_len = CMSG_LEN(sizeof(int) * fds.size());
+        std::memcpy(CMSG_DATA(cm), fds.data(), sizeof(int) * fds.size());
+    }
+
+    return (int)::sendmsg(fd, &msg, MSG_NOSIGNAL);
+}
+
+int appfw::platsock::readVecWithFds(SocketFile fd, appfw::span<uint8_t> buf1,
+                                    appfw::span<uint8_t> buf2, std::vector<int> &fds) {
+    iovec iov[2];
+    iov[0].iov_base = buf1.data();
+    iov[0].iov_len = buf1.size();
+    iov[1].iov_base = buf2.data();
+    iov[1].iov_len = buf2.size();
+
+    alignas(cmsghdr) uint8_t control[CMSG_SPACE(sizeof(int) * MAX_PASSED_FDS)];
+
+    msghdr msg = {};
+    msg.msg_iov = iov;
+    msg.msg_iovlen = buf2.empty() ? 1 : 2;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    int flags = 0;
+#ifdef MSG_CMSG_CLOEXEC
+    flags |= MSG_CMSG_CLOEXEC;
+#endif
+
+    int result = (int)::recvmsg(fd, &msg, flags);
+
+    if (result < 0) {
+        return result;
+    }
+
+    for (cmsghdr *cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm)) {
+        if (cm->cmsg_level == SOL_SOCKET && cm->cmsg_type == SCM_RIGHTS) {
+            size_t count = (cm->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            size_t pos = fds.size();
+            fds.resize(pos + count);
+            std::memcpy(fds.data() + pos, CMSG_DATA(cm), count * sizeof(int));
+        }
+    }
+
+    // Descriptors that didn't fit (MSG_CTRUNC) were closed by the kernel
+    return result;
+}
+
 #else
 #error "Sockets are not supported on the platform"
 #endif
+
+appfw::platsock::RecvResult appfw::platsock::recvIntoRingBuffer(SocketFile fd, RecvRingBuffer &buf,
+                                                                size_t &bytesRead,
+                                                                std::vector<int> *fds) {
+    bytesRead = 0;
+
+    while (!buf.full()) {
+        RecvRingBuffer::WriteView view = buf.writable();
+#if PLATFORM_UNIX
+        int size = fds ? readVecWithFds(fd, view.first, view.second, *fds)
+                       : readVec(fd, view.first, view.second);
+#else
+        AFW_ASSERT(!fds);
+        int size = readVec(fd, view.first, view.second);
+#endif
+
+        if (size < 0) {
+            return RecvResult::SocketError;
+        } else if (size == 0) {
+            return RecvResult::Eof;
+        }
+
+        buf.commit((size_t)size);
+        bytesRead += (size_t)size;
+
+        if ((size_t)size < view.size()) {
+            // Short read, nothing left in the socket
+            return RecvResult::WouldBlock;
+        }
+    }
+
+    return RecvResult::Full;
+}
+
+int appfw::platsock::pollSingle(SocketFile fd, short events, int timeout) {
+    pollfd pfd = {fd, events, 0};
+    int result = platsock::poll(&pfd, 1, timeout);
+    return result > 0 ? pfd.revents : result;
+}
+
+int appfw::platsock::getNativeFamily(AddressFamily family) {
+    switch (family) {
+    case AddressFamily::IPv4: return AF_INET;
+    case AddressFamily::IPv6: return AF_INET6;
+#if PLATFORM_UNIX
+    case AddressFamily::Unix: return AF_UNIX;
+#endif
+    default: throw std::invalid_argument("unsupported address family");
+    }
+}
+
+namespace {
+
+template <typename T>
+void setSockOpt(appfw::SocketFile fd, int level, int name, const char *optName, T value) {
+    int result = ::setsockopt(fd, level, name, reinterpret_cast<const char *>(&value),
+                              (int)sizeof(value));
+
+    if (result != 0) {
+        throw appfw::SocketErrorException(fmt::format("setsockopt({}) failed", optName));
+    }
+}
+
+} // namespace
+
+void appfw::platsock::applySocketOptions(SocketFile fd, const SocketOptions &opts) {
+    if (opts.noDelay) {
+        setSockOpt<int>(fd, IPPROTO_TCP, TCP_NODELAY, "TCP_NODELAY", *opts.noDelay);
+    }
+
+#ifdef TCP_CORK
+    if (opts.cork) {
+        setSockOpt<int>(fd, IPPROTO_TCP, TCP_CORK, "TCP_CORK", *opts.cork);
+    }
+#endif
+
+    if (opts.sendBufferSize) {
+        setSockOpt<int>(fd, SOL_SOCKET, SO_SNDBUF, "SO_SNDBUF", *opts.sendBufferSize);
+    }
+
+    if (opts.recvBufferSize) {
+        setSockOpt<int>(fd, SOL_SOCKET, SO_RCVBUF, "SO_RCVBUF", *opts.recvBufferSize);
+    }
+
+    if (opts.keepAlive) {
+        setSockOpt<int>(fd, SOL_SOCKET, SO_KEEPALIVE, "SO_KEEPALIVE", *opts.keepAlive);
+    }
+
+#ifdef TCP_KEEPIDLE
+    if (opts.keepAliveIdle) {
+        setSockOpt<int>(fd, IPPROTO_TCP, TCP_KEEPIDLE, "TCP_KEEPIDLE", *opts.keepAliveIdle);
+    }
+#endif
+
+#ifdef TCP_KEEPINTVL
+    if (opts.keepAliveInterval) {
+        setSockOpt<int>(fd, IPPROTO_TCP, TCP_KEEPINTVL, "TCP_KEEPINTVL", *opts.keepAliveInterval);
+    }
+#endif
+
+#ifdef TCP_KEEPCNT
+    if (opts.keepAliveCount) {
+        setSockOpt<int>(fd, IPPROTO_TCP, TCP_KEEPCNT, "TCP_KEEPCNT", *opts.keepAliveCount);
+    }
+#endif
+
+#ifdef SO_BUSY_POLL
+    if (opts.busyPoll) {
+        setSockOpt<int>(fd, SOL_SOCKET, SO_BUSY_POLL, "SO_BUSY_POLL", *opts.busyPoll);
+    }
+#endif
+}
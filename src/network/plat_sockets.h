@@ -1,6 +1,10 @@
 #ifndef APPFW_NETWORK_PLAT_SOCKETS_H
 #define APPFW_NETWORK_PLAT_SOCKETS_H
+#include <vector>
 #include <appfw/network/socket.h>
+#include <appfw/network/recv_ring_buffer.h>
+#include <appfw/network/socket_options.h>
+#include <appfw/timer.h>
 
 #if PLATFORM_WINDOWS
 
@@ -16,7 +20,12 @@
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <sys/time.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <sys/stat.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netinet/udp.h>
 #include <netdb.h>
 #include <arpa/inet.h>
 #include <poll.h>
@@ -29,9 +38,18 @@ namespace appfw::platsock {
 
 enum class AcceptResult
 {
-    BadAccept,  //!< Connection closed before accept
-    WouldBlock, //!< Nothing left to accept
-    Accepted,   //!< Accepted
+    BadAccept,   //!< Connection closed before accept
+    WouldBlock,  //!< Nothing left to accept
+    NoResources, //!< Out of file descriptors or memory, try again later
+    Accepted,    //!< Accepted
+};
+
+enum class RecvResult
+{
+    WouldBlock,  //!< Everything available was read
+    Eof,         //!< Connection was closed by the other side
+    Full,        //!< Buffer is full, there may be more data
+    SocketError, //!< Read failed, check the error (may be EWOULDBLOCK)
 };
 
 /**
@@ -41,9 +59,9 @@ void initNetworking();
 
 /**
  * Attempts to accept a connection.
- * Returns true if successfully
+ * The accepted socket is non-blocking and not inherited by child processes.
  */
-AcceptResult acceptConnection(SocketFile fd, SocketFile &remoteSock, SockAddr4 &remoteAddr);
+AcceptResult acceptConnection(SocketFile fd, SocketFile &remoteSock, SockAddr &remoteAddr);
 
 /**
  * Sets socket mode to blocking or non-blocking.
@@ -53,11 +71,113 @@ AcceptResult acceptConnection(SocketFile fd, SocketFile &remoteSock, SockAddr4 &
  */
 bool setSocketBlockingMode(SocketFile socket, bool block);
 
+/**
+ * @return the native address family
+ */
+int getNativeFamily(AddressFamily family);
+
+/**
+ * Applies set socket options. Options not supported by the platform are ignored.
+ * Throws SocketErrorException on failure.
+ */
+void applySocketOptions(SocketFile fd, const SocketOptions &opts);
+
+/**
+ * Reads into two buffers with a single call. See readv(2).
+ * @return  Number of bytes read, 0 on EOF or -1 on error
+ */
+int readVec(SocketFile fd, appfw::span<uint8_t> buf1, appfw::span<uint8_t> buf2);
+
+/**
+ * Reads from the socket into the ring buffer until it would block, EOF or the buffer is full.
+ * A short read is treated as the socket being drained.
+ * @param   bytesRead   Number of bytes read
+ * @param   fds         If not null, passed file descriptors are appended to it (Unix only)
+ */
+RecvResult recvIntoRingBuffer(SocketFile fd, RecvRingBuffer &buf, size_t &bytesRead,
+                              std::vector<int> *fds = nullptr);
+
+/**
+ * Removes the file of a Unix domain socket address if it is a socket.
+ * Does nothing for other addresses.
+ */
+void removeUnixSocketFile(const SockAddr &addr);
+
+/**
+ * Removes the file of a Unix domain socket address if it is a socket
+ * that nothing listens on (left by a server that didn't stop cleanly).
+ * Files of live servers are kept so bind fails instead of taking the path over.
+ */
+void removeStaleUnixSocketFile(const SockAddr &addr);
+
+#if PLATFORM_UNIX
+/**
+ * Sends data with file descriptors attached (SCM_RIGHTS).
+ * @return  Number of bytes sent or -1 on error
+ */
+int sendWithFds(SocketFile fd, appfw::span<const uint8_t> buf, appfw::span<const int> fds);
+
+/**
+ * Reads into two buffers and receives passed file descriptors (SCM_RIGHTS).
+ * Received descriptors are appended to fds.
+ * @return  Number of bytes read, 0 on EOF or -1 on error
+ */
+int readVecWithFds(SocketFile fd, appfw::span<uint8_t> buf1, appfw::span<uint8_t> buf2,
+                   std::vector<int> &fds);
+#endif
+
 /**
  * See poll(2)
  */
 int poll(pollfd *ufds, unsigned int nfds, int timeout);
 
+/**
+ * Waits for events on a single socket.
+ * @return  revents, 0 on time out or -1 on error
+ */
+int pollSingle(SocketFile fd, short events, int timeout);
+
+/**
+ * Sends all data in the buffer. If the socket would block, waits until it is writable.
+ * @param   timeout Maximum total time to wait in ms (0 - infinite)
+ * @param   writeFn Function that writes data and returns number of bytes sent (0 if would block)
+ * @return  false on time out
+ */
+template <typename TWriteFn>
+bool writeAllWithTimeout(SocketFile fd, appfw::span<const uint8_t> buf, int timeout,
+                         TWriteFn writeFn);
+
+template <typename TWriteFn>
+inline bool writeAllWithTimeout(SocketFile fd, appfw::span<const uint8_t> buf, int timeout,
+                                TWriteFn writeFn) {
+    size_t sent = 0;
+    Timer timer;
+
+    while (sent != buf.size()) {
+        int size = writeFn(buf.subspan(sent));
+        sent += (size_t)size;
+
+        if (size == 0 && sent != buf.size()) {
+            // Socket buffer is full, wait instead of spinning
+            int waitTime = -1;
+
+            if (timeout > 0) {
+                waitTime = timeout - (int)timer.ms();
+
+                if (waitTime <= 0) {
+                    return false;
+                }
+            }
+
+            if (pollSingle(fd, POLLOUT, waitTime) < 0) {
+                throw SocketErrorException("poll() failed");
+            }
+        }
+    }
+
+    return true;
+}
+
 } // namespace appfw::platsock
 
 
@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <cstring>
+#include <appfw/network/recv_ring_buffer.h>
+
+appfw::RecvRingBuffer::RecvRingBuffer(size_t capacity) {
+    setCapacity(capacity);
+}
+
+void appfw::RecvRingBuffer::setCapacity(size_t capacity) {
+    AFW_ASSERT(capacity > 0);
+    m_uCapacity = capacity;
+    m_Data.clear();
+    m_Data.shrink_to_fit();
+    clear();
+}
+
+appfw::RecvRingBuffer::ReadView appfw::RecvRingBuffer::readable() const {
+    ReadView view;
+
+    if (m_uSize == 0) {
+        return view;
+    }
+
+    size_t firstSize = std::min(m_uSize, m_uCapacity - m_uHead);
+    view.first = appfw::span<const uint8_t>(m_Data.data() + m_uHead, firstSize);
+    view.second = appfw::span<const uint8_t>(m_Data.data(), m_uSize - firstSize);
+    return view;
+}
+
+void appfw::RecvRingBuffer::consume(size_t n) {
+    AFW_ASSERT(n <= m_uSize);
+    m_uSize -= n;
+
+    if (m_uSize == 0) {
+        // Start from the beginning so next data is contiguous
+        m_uHead = 0;
+    } else {
+        m_uHead = (m_uHead + n) % m_uCapacity;
+    }
+}
+
+size_t appfw::RecvRingBuffer::read(appfw::span<uint8_t> buf) {
+    ReadView view = readable();
+    size_t firstSize = std::min(buf.size(), view.first.size());
+    size_t secondSize = std::min(buf.size() - firstSize, view.second.size());
+    std::memcpy(buf.data(), view.first.data(), firstSize);
+    std::memcpy(buf.data() + firstSize, view.second.data(), secondSize);
+    consume(firstSize + secondSize);
+    return firstSize + secondSize;
+}
+
+appfw::RecvRingBuffer::WriteView appfw::RecvRingBuffer::writable() {
+    if (m_Data.empty()) {
+        m_Data.resize(m_uCapacity);
+    }
+
+    WriteView view;
+    size_t tail = (m_uHead + m_uSize) % m_uCapacity;
+    size_t freeSize = freeSpace();
+
+    if (freeSize == 0) {
+        return view;
+    }
+
+    size_t firstSize = std::min(freeSize, m_uCapacity - tail);
+    view.first = appfw::span<uint8_t>(m_Data.data() + tail, firstSize);
+    view.second = appfw::span<uint8_t>(m_Data.data(), freeSize - firstSize);
+    return view;
+}
+
+void appfw::RecvRingBuffer::commit(size_t n) {
+    AFW_ASSERT(n <= freeSpace());
+    m_uSize += n;
+}
+
+void appfw::RecvRingBuffer::clear() {
+    m_uHead = 0;
+    m_uSize = 0;
+}
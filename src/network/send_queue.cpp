@@ -0,0 +1,236 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <fmt/format.h>
+#include "send_queue.h"
+#include "plat_sockets.h"
+
+#if PLATFORM_LINUX
+#include <sys/sendfile.h>
+#endif
+
+namespace {
+
+//! Size of chunks read from files when sendfile is not available
+constexpr size_t FILE_BUF_SIZE = 64 * 1024;
+
+//! Maximum size transferred by sendfile(2) in one call
+constexpr uint64_t MAX_SENDFILE_SIZE = 0x7ffff000;
+
+} // namespace
+
+//----------------------------------------------------------------
+// SendQueue::File
+//----------------------------------------------------------------
+struct appfw::platsock::SendQueue::File {
+#if PLATFORM_UNIX
+    int fd = -1;
+#else
+    std::ifstream stream;
+#endif
+
+    uint64_t offset = 0;
+    uint64_t remaining = 0;
+    bool bUseSendfile = PLATFORM_LINUX;
+
+    File() = default;
+    File(const File &) = delete;
+    File &operator=(const File &) = delete;
+
+#if PLATFORM_UNIX
+    ~File() {
+        if (fd != -1) {
+            ::close(fd);
+        }
+    }
+#endif
+
+    //! Reads from the current offset. @returns number of bytes read
+    size_t read(appfw::span<uint8_t> buf);
+};
+
+size_t appfw::platsock::SendQueue::File::read(appfw::span<uint8_t> buf) {
+    size_t size = (size_t)std::min<uint64_t>(buf.size(), remaining);
+
+#if PLATFORM_UNIX
+    ssize_t result = 0;
+
+    do {
+        result = ::pread(fd, buf.data(), size, (off_t)offset);
+    } while (result < 0 && errno == EINTR);
+
+    if (result < 0) {
+        throw std::runtime_error(fmt::format("sendFile: read failed: {}", std::strerror(errno)));
+    }
+#else
+    stream.seekg((std::streamoff)offset);
+    stream.read(reinterpret_cast<char *>(buf.data()), (std::streamsize)size);
+    std::streamsize result = stream.gcount();
+    stream.clear();
+#endif
+
+    if (result == 0 && size != 0) {
+        throw std::runtime_error("sendFile: file was truncated");
+    }
+
+    return (size_t)result;
+}
+
+//----------------------------------------------------------------
+// SendQueue
+//----------------------------------------------------------------
+appfw::platsock::SendQueue::SendQueue() = default;
+
+appfw::platsock::SendQueue::~SendQueue() = default;
+
+void appfw::platsock::SendQueue::push(appfw::span<const uint8_t> buf) {
+    if (buf.empty()) {
+        return;
+    }
+
+    // Append to the last data entry to avoid many small sends
+    if (m_Entries.empty() || m_Entries.back().file) {
+        m_Entries.emplace_back();
+    }
+
+    std::vector<uint8_t> &data = m_Entries.back().data;
+    data.insert(data.end(), buf.begin(), buf.end());
+    m_uSize += buf.size();
+}
+
+void appfw::platsock::SendQueue::pushFile(const fs::path &path, uint64_t offset,
+                                          uint64_t length) {
+    auto file = std::make_unique<File>();
+    uint64_t fileSize = 0;
+
+#if PLATFORM_UNIX
+    file->fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (file->fd == -1) {
+        throw std::runtime_error(
+            fmt::format("sendFile: failed to open {}: {}", path.u8string(), std::strerror(errno)));
+    }
+
+    struct stat st;
+
+    if (::fstat(file->fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        throw std::runtime_error(fmt::format("sendFile: {} is not a file", path.u8string()));
+    }
+
+    fileSize = (uint64_t)st.st_size;
+#else
+    file->stream.open(path, std::ios::in | std::ios::binary);
+
+    if (!file->stream.is_open()) {
+        throw std::runtime_error(fmt::format("sendFile: failed to open {}", path.u8string()));
+    }
+
+    file->stream.seekg(0, std::ios::end);
+    fileSize = (uint64_t)file->stream.tellg();
+#endif
+
+    if (offset > fileSize) {
+        throw std::out_of_range("sendFile: offset is past the end of the file");
+    }
+
+    length = std::min(length, fileSize - offset);
+
+    if (length == 0) {
+        return;
+    }
+
+    file->offset = offset;
+    file->remaining = length;
+
+    Entry &entry = m_Entries.emplace_back();
+    entry.file = std::move(file);
+    m_uSize += length;
+}
+
+bool appfw::platsock::SendQueue::flush(SocketFile fd, uint64_t &bytesSent) {
+    bytesSent = 0;
+
+    while (!m_Entries.empty()) {
+        Entry &entry = m_Entries.front();
+        int64_t size = entry.file ? sendFile(fd, *entry.file) : sendData(fd, entry);
+
+        if (size < 0) {
+            return false;
+        }
+
+        bytesSent += (uint64_t)size;
+        m_uSize -= (uint64_t)size;
+
+        bool isDone = entry.file ? entry.file->remaining == 0
+                                 : entry.dataOffset == entry.data.size();
+
+        if (isDone) {
+            m_Entries.pop_front();
+        } else if (size == 0) {
+            // Would block
+            break;
+        }
+    }
+
+    return true;
+}
+
+void appfw::platsock::SendQueue::clear() {
+    m_Entries.clear();
+    m_uSize = 0;
+}
+
+int64_t appfw::platsock::SendQueue::sendData(SocketFile fd, Entry &entry) {
+    appfw::span<const uint8_t> buf = appfw::span<const uint8_t>(entry.data).subspan(entry.dataOffset);
+    int size = ::send(fd, reinterpret_cast<const char *>(buf.data()), (int)buf.size(), 0);
+
+    if (size < 0) {
+        return -1;
+    }
+
+    entry.dataOffset += (size_t)size;
+    return size;
+}
+
+int64_t appfw::platsock::SendQueue::sendFile(SocketFile fd, File &file) {
+#if PLATFORM_LINUX
+    if (file.bUseSendfile) {
+        off_t offset = (off_t)file.offset;
+        ssize_t size = ::sendfile(fd, file.fd, &offset, (size_t)std::min(file.remaining, MAX_SENDFILE_SIZE));
+
+        if (size < 0 && (errno == EINVAL || errno == ENOSYS)) {
+            // The file doesn't support mmap-like operations
+            file.bUseSendfile = false;
+            return sendFileBuffered(fd, file);
+        } else if (size < 0) {
+            return -1;
+        } else if (size == 0) {
+            throw std::runtime_error("sendFile: file was truncated");
+        }
+
+        file.offset += (uint64_t)size;
+        file.remaining -= (uint64_t)size;
+        return size;
+    }
+#endif
+
+    return sendFileBuffered(fd, file);
+}
+
+int64_t appfw::platsock::SendQueue::sendFileBuffered(SocketFile fd, File &file) {
+    if (m_FileBuf.empty()) {
+        m_FileBuf.resize(FILE_BUF_SIZE);
+    }
+
+    // Unsent part is read again next time
+    size_t readSize = file.read(m_FileBuf);
+    int size = ::send(fd, reinterpret_cast<const char *>(m_FileBuf.data()), (int)readSize, 0);
+
+    if (size < 0) {
+        return -1;
+    }
+
+    file.offset += (uint64_t)size;
+    file.remaining -= (uint64_t)size;
+    return size;
+}
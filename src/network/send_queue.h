@@ -0,0 +1,77 @@
+#ifndef APPFW_NETWORK_SEND_QUEUE_H
+#define APPFW_NETWORK_SEND_QUEUE_H
+#include <deque>
+#include <memory>
+#include <vector>
+#include <appfw/filesystem.h>
+#include <appfw/network/socket.h>
+#include <appfw/span.h>
+#include <appfw/utils.h>
+
+namespace appfw::platsock {
+
+/**
+ * Data and file ranges waiting to be sent over a non-blocking socket.
+ * Files are sent with sendfile(2) on Linux and with buffered copies elsewhere.
+ */
+class SendQueue : NoMove {
+public:
+    SendQueue();
+    ~SendQueue();
+
+    /**
+     * @return whether there is nothing to send
+     */
+    inline bool isEmpty() { return m_Entries.empty(); }
+
+    /**
+     * @return number of bytes waiting to be sent
+     */
+    inline uint64_t getSize() { return m_uSize; }
+
+    /**
+     * Copies data into the queue.
+     */
+    void push(appfw::span<const uint8_t> buf);
+
+    /**
+     * Opens a file and queues a range of it.
+     * Throws if the file can't be opened or the range is outside of it.
+     */
+    void pushFile(const fs::path &path, uint64_t offset, uint64_t length);
+
+    /**
+     * Sends queued data until the socket would block or the queue is empty.
+     * Throws std::runtime_error if a file can't be read.
+     * @param   bytesSent   Number of bytes sent
+     * @return  false on socket error (check errno or WSAGetLastError, may be EWOULDBLOCK)
+     */
+    bool flush(SocketFile fd, uint64_t &bytesSent);
+
+    /**
+     * Removes everything from the queue.
+     */
+    void clear();
+
+private:
+    struct File;
+
+    struct Entry {
+        std::vector<uint8_t> data;
+        size_t dataOffset = 0;
+        std::unique_ptr<File> file;
+    };
+
+    std::deque<Entry> m_Entries;
+    uint64_t m_uSize = 0;
+    std::vector<uint8_t> m_FileBuf;
+
+    //! Sends the front entry. @returns bytes sent or -1 on error
+    int64_t sendData(SocketFile fd, Entry &entry);
+    int64_t sendFile(SocketFile fd, File &file);
+    int64_t sendFileBuffered(SocketFile fd, File &file);
+};
+
+} // namespace appfw::platsock
+
+#endif
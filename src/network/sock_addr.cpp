@@ -28,8 +28,222 @@ appfw::SockAddr4 appfw::SockAddr4::fromSockAddrStruct(const sockaddr_in &sa) {
     return SockAddr4{ip, port};
 }
 
-std::list<appfw::SockAddr4> appfw::resolveHostName(const std::string &hostname,
-                                                   const std::string &port, SockType type) {
+//----------------------------------------------------------------
+// SockAddr
+//----------------------------------------------------------------
+static_assert(appfw::SockAddr::STORAGE_SIZE >= sizeof(sockaddr_storage), "STORAGE_SIZE is too small");
+static_assert(alignof(sockaddr_storage) <= 8, "SockAddr storage is underaligned");
+
+appfw::SockAddr::SockAddr(const SockAddr4 &addr) {
+    sockaddr_in sa = addr.toSockAddrStruct();
+    std::memcpy(m_Storage, &sa, sizeof(sa));
+    m_iSize = sizeof(sa);
+    m_Family = AddressFamily::IPv4;
+}
+
+appfw::SockAddr::SockAddr(IPAddress4 ip, uint16_t port)
+    : SockAddr(SockAddr4{ip, port}) {}
+
+appfw::SockAddr::SockAddr(const IPAddress6 &ip, uint16_t port, uint32_t scopeId) {
+    sockaddr_in6 sa = {};
+    sa.sin6_family = AF_INET6;
+    sa.sin6_port = htons(port);
+    sa.sin6_scope_id = scopeId;
+    std::memcpy(&sa.sin6_addr, ip.addr.data(), ip.addr.size());
+    std::memcpy(m_Storage, &sa, sizeof(sa));
+    m_iSize = sizeof(sa);
+    m_Family = AddressFamily::IPv6;
+}
+
+appfw::SockAddr appfw::SockAddr::fromUnixPath([[maybe_unused]] std::string_view path) {
+#if PLATFORM_UNIX
+    SockAddr addr;
+    sockaddr_un sa = {};
+
+    // Pathname must be null-terminated, abstract name is not
+    bool isAbstract = !path.empty() && path[0] == '\0';
+    size_t maxSize = sizeof(sa.sun_path) - (isAbstract ? 0 : 1);
+
+    if (path.empty() || path.size() > maxSize) {
+        throw std::invalid_argument("invalid Unix socket path length");
+    }
+
+    sa.sun_family = AF_UNIX;
+    std::memcpy(sa.sun_path, path.data(), path.size());
+    std::memcpy(addr.m_Storage, &sa, sizeof(sa));
+    addr.m_iSize = (int)(offsetof(sockaddr_un, sun_path) + path.size() + (isAbstract ? 0 : 1));
+    addr.m_Family = AddressFamily::Unix;
+    return addr;
+#else
+    throw std::logic_error("Unix domain sockets are not supported on the platform");
+#endif
+}
+
+uint16_t appfw::SockAddr::getPort() const {
+    switch (m_Family) {
+    case AddressFamily::IPv4:
+        return ntohs(reinterpret_cast<const sockaddr_in *>(m_Storage)->sin_port);
+    case AddressFamily::IPv6:
+        return ntohs(reinterpret_cast<const sockaddr_in6 *>(m_Storage)->sin6_port);
+    default:
+        return 0;
+    }
+}
+
+appfw::SockAddr4 appfw::SockAddr::toSockAddr4() const {
+    AFW_ASSERT(isIPv4());
+    return SockAddr4::fromSockAddrStruct(*reinterpret_cast<const sockaddr_in *>(m_Storage));
+}
+
+appfw::IPAddress6 appfw::SockAddr::getIPAddress6() const {
+    AFW_ASSERT(isIPv6());
+    IPAddress6 ip;
+    std::memcpy(ip.addr.data(), &reinterpret_cast<const sockaddr_in6 *>(m_Storage)->sin6_addr,
+                ip.addr.size());
+    return ip;
+}
+
+uint32_t appfw::SockAddr::getScopeId() const {
+    AFW_ASSERT(isIPv6());
+    return reinterpret_cast<const sockaddr_in6 *>(m_Storage)->sin6_scope_id;
+}
+
+std::string appfw::SockAddr::getUnixPath() const {
+    AFW_ASSERT(isUnix());
+#if PLATFORM_UNIX
+    const sockaddr_un *sa = reinterpret_cast<const sockaddr_un *>(m_Storage);
+    size_t size = m_iSize - offsetof(sockaddr_un, sun_path);
+
+    if (size > 0 && sa->sun_path[0] != '\0') {
+        // Pathname, may or may not include the null terminator
+        size = strnlen(sa->sun_path, size);
+    }
+
+    return std::string(sa->sun_path, size);
+#else
+    return std::string();
+#endif
+}
+
+appfw::SockAddr appfw::SockAddr::unmapped() const {
+    if (isIPv6()) {
+        IPAddress6 ip = getIPAddress6();
+
+        if (ip.isV4Mapped()) {
+            return SockAddr(ip.toV4Mapped(), getPort());
+        }
+    }
+
+    return *this;
+}
+
+std::string appfw::SockAddr::toString() const {
+    switch (m_Family) {
+    case AddressFamily::IPv4: {
+        return toSockAddr4().toString();
+    }
+    case AddressFamily::IPv6: {
+        char buf[INET6_ADDRSTRLEN] = {};
+        const sockaddr_in6 *sa = reinterpret_cast<const sockaddr_in6 *>(m_Storage);
+        ::inet_ntop(AF_INET6, const_cast<in6_addr *>(&sa->sin6_addr), buf, sizeof(buf));
+        return fmt::format("[{}]:{}", buf, getPort());
+    }
+    case AddressFamily::Unix: {
+        std::string path = getUnixPath();
+
+        if (!path.empty() && path[0] == '\0') {
+            path[0] = '@';
+        }
+
+        return "unix:" + path;
+    }
+    default: {
+        return "<unspec>";
+    }
+    }
+}
+
+appfw::SockAddr appfw::SockAddr::fromSockAddrStruct(const sockaddr *sa, size_t size) {
+    SockAddr addr;
+
+    if (sa->sa_family == AF_INET && size >= sizeof(sockaddr_in)) {
+        addr.m_Family = AddressFamily::IPv4;
+        addr.m_iSize = sizeof(sockaddr_in);
+    } else if (sa->sa_family == AF_INET6 && size >= sizeof(sockaddr_in6)) {
+        addr.m_Family = AddressFamily::IPv6;
+        addr.m_iSize = sizeof(sockaddr_in6);
+#if PLATFORM_UNIX
+    } else if (sa->sa_family == AF_UNIX && size >= offsetof(sockaddr_un, sun_path) &&
+               size <= sizeof(sockaddr_un)) {
+        // Unnamed sockets only have the family
+        addr.m_Family = AddressFamily::Unix;
+        addr.m_iSize = (int)size;
+#endif
+    } else {
+        return addr;
+    }
+
+    std::memcpy(addr.m_Storage, sa, addr.m_iSize);
+    return addr;
+}
+
+//----------------------------------------------------------------
+// resolveHostName
+//----------------------------------------------------------------
+std::list<appfw::SockAddr> appfw::resolveHostName(const std::string &hostname,
+                                                  const std::string &port, SockType type,
+                                                  AddressFamily family) {
+    platsock::initNetworking();
+
+    addrinfo hints;
+    std::memset(&hints, 0, sizeof hints);
+
+    if (family == AddressFamily::IPv4) {
+        hints.ai_family = AF_INET;
+    } else if (family == AddressFamily::IPv6) {
+        hints.ai_family = AF_INET6;
+    } else {
+        hints.ai_family = AF_UNSPEC;
+    }
+
+    if (type == SockType::TCP) {
+        hints.ai_socktype = SOCK_STREAM;
+    } else if (type == SockType::UDP) {
+        hints.ai_socktype = SOCK_DGRAM;
+    }
+
+    struct addrinfo *servinfo = nullptr;
+
+    try {
+        int result = getaddrinfo(hostname.c_str(), port.c_str(), &hints, &servinfo);
+        if (result != 0) {
+#if PLATFORM_WINDOWS
+            throw SocketErrorException("getaddrinfo() failed");
+#else
+            throw std::runtime_error(gai_strerror(result));
+#endif
+        }
+
+        std::list<SockAddr> list;
+
+        for (addrinfo *p = servinfo; p != NULL; p = p->ai_next) {
+            SockAddr addr = SockAddr::fromSockAddrStruct(p->ai_addr, p->ai_addrlen);
+
+            if (addr.getFamily() != AddressFamily::Unspec) {
+                list.push_back(addr);
+            }
+        }
+
+        freeaddrinfo(servinfo);
+        return list;
+    } catch (...) {
+        freeaddrinfo(servinfo);
+        throw;
+    }
+}
+
+std::list<appfw::SockAddr4> appfw::resolveHostName4(const std::string &hostname,
+                                                    const std::string &port, SockType type) {
     platsock::initNetworking();
 
     addrinfo hints;
@@ -1,6 +1,22 @@
 #include <fmt/format.h>
 #include <appfw/network/socket.h>
 #include "plat_sockets.h"
+#include "io_uring.h"
+
+bool appfw::isNetBackendSupported(NetBackend backend) {
+    switch (backend) {
+    case NetBackend::Poll:
+        return true;
+    case NetBackend::IoUring:
+#if APPFW_IO_URING
+        return platsock::IoUring::isSupported();
+#else
+        return false;
+#endif
+    }
+
+    return false;
+}
 
 //----------------------------------------------------------------
 // SockFd
@@ -0,0 +1,280 @@
+#include <appfw/network/tcp_client.h>
+#include "plat_sockets.h"
+
+void appfw::TcpClient::setSocketOptions(const SocketOptions &opts) {
+    m_SocketOptions = opts;
+
+    if (m_Status != NetClientStatus::Closed) {
+        platsock::applySocketOptions(m_fd.get(), m_SocketOptions);
+    }
+}
+
+void appfw::TcpClient::connect(const SockAddr &addr, int timeout) {
+    if (m_Status != NetClientStatus::Closed) {
+        throw std::logic_error("already connected");
+    }
+
+    try {
+        platsock::initNetworking();
+
+        int result = 0;
+        m_Addr = addr;
+        m_RecvBuffer.clear();
+
+        // Open the socket
+        {
+            SocketFile sockfd =
+                ::socket(platsock::getNativeFamily(addr.getFamily()), SOCK_STREAM, 0);
+
+            if (sockfd == NULL_SOCKET) {
+                throw SocketErrorException("socket() failed");
+            }
+
+            m_fd.set(sockfd);
+            m_Status = NetClientStatus::Connecting;
+        }
+
+        // Set non-blocking mode
+        if (!platsock::setSocketBlockingMode(m_fd.get(), false)) {
+            throw SocketErrorException("setSocketBlockingMode(false) failed");
+        }
+
+        // Apply options before connecting so they affect the handshake
+        platsock::applySocketOptions(m_fd.get(), m_SocketOptions);
+
+        // Connect
+        result = ::connect(m_fd.get(), addr.getSockAddrStruct(), addr.getSockAddrSize());
+        if (result == 0) {
+            m_Status = NetClientStatus::Connected;
+        } else {
+#if PLATFORM_WINDOWS
+            int error = WSAGetLastError();
+
+            if (error != WSAEWOULDBLOCK) {
+                close(SocketCloseReason::Failure);
+                throw SocketErrorException("connect() failed", error);
+            }
+#elif PLATFORM_UNIX
+            int error = errno;
+
+            if (error != EINPROGRESS) {
+                close(SocketCloseReason::Failure);
+                throw SocketErrorException("connect() failed", error);
+            }
+#else
+#error
+#endif
+        }
+
+        m_iTimeOut = timeout;
+        m_Timer.start();
+    } catch (...) {
+        close(SocketCloseReason::Failure);
+        throw;
+    }
+}
+
+bool appfw::TcpClient::updateStatus(int time) {
+    if (m_Status == NetClientStatus::Closed) {
+        throw std::logic_error("not connecting or not connected");
+    }
+
+    AFW_ASSERT(m_fd.get() != 0);
+
+    if (m_Status == NetClientStatus::Connecting) {
+        // Don't wait past the connection time-out
+        int timeLeft = std::max(m_iTimeOut - (int)m_Timer.ms(), 0);
+        time = time == -1 ? timeLeft : std::min(time, timeLeft);
+    }
+
+    int revents = platsock::pollSingle(m_fd.get(), getPollEvents(), time);
+
+    if (revents < 0) {
+        // Error
+        auto ex = SocketErrorException("poll() failed");
+        close(SocketCloseReason::Failure);
+        throw ex;
+    }
+
+    return processPollEvents(revents);
+}
+
+void appfw::TcpClient::close() {
+    close(SocketCloseReason::User);
+}
+
+void appfw::TcpClient::close(SocketCloseReason reason) {
+    if (m_Status != NetClientStatus::Closed) {
+        m_CloseReason = reason;
+    }
+
+    m_fd.close();
+    m_Status = NetClientStatus::Closed;
+    m_Addr = SockAddr();
+}
+
+short appfw::TcpClient::getPollEvents() {
+    return m_Status == NetClientStatus::Connecting ? POLLOUT : POLLIN;
+}
+
+bool appfw::TcpClient::processPollEvents(int revents) {
+    if (m_Status == NetClientStatus::Connecting) {
+        if (revents == 0) {
+            // Still connecting
+            checkConnectTimeOut();
+            return false;
+        }
+
+        // Get the result
+        int error = 0;
+#if PLATFORM_WINDOWS
+        int errorLen = sizeof(error);
+#else
+        socklen_t errorLen = sizeof(error);
+#endif
+        int getResult = ::getsockopt(m_fd.get(), SOL_SOCKET, SO_ERROR,
+                                     reinterpret_cast<char *>(&error), &errorLen);
+
+        if (getResult != 0) {
+            auto ex = SocketErrorException("getsockopt() failed");
+            close(SocketCloseReason::Failure);
+            throw ex;
+        }
+
+        if (error == 0) {
+            // Connection established
+            m_Status = NetClientStatus::Connected;
+            return false;
+        }
+
+#if PLATFORM_WINDOWS
+        if (error == WSAETIMEDOUT) {
+            m_iTimeOut = 0;
+        } else if (error != WSAEWOULDBLOCK) {
+            close(SocketCloseReason::Failure);
+            throw SocketErrorException("connect() failed", error);
+        }
+#elif PLATFORM_UNIX
+        if (error == ETIMEDOUT) {
+            m_iTimeOut = 0;
+        } else if (error != EINPROGRESS) {
+            close(SocketCloseReason::Failure);
+            throw SocketErrorException("connect() failed", error);
+        }
+#else
+#error
+#endif
+
+        checkConnectTimeOut();
+    } else if (m_Status == NetClientStatus::Connected) {
+        // New data, connection closed or an error. Reading will tell which one.
+        return (revents & (POLLIN | POLLHUP | POLLERR)) != 0;
+    }
+
+    return false;
+}
+
+void appfw::TcpClient::checkConnectTimeOut() {
+    if (m_Timer.ms() >= m_iTimeOut) {
+        m_Timer.stop();
+        close(SocketCloseReason::TimeOut);
+        throw ConnectionTimedOutException();
+    }
+}
+
+int appfw::TcpClient::read(appfw::span<uint8_t> buf) {
+    int size = ::recv(m_fd.get(), reinterpret_cast<char *>(buf.data()), (int)buf.size(), 0);
+
+    if (size >= 0) {
+        return size;
+    } else {
+        return handleError("recv");
+    }
+}
+
+size_t appfw::TcpClient::receive() {
+    return receiveInternal(nullptr);
+}
+
+#if PLATFORM_UNIX
+size_t appfw::TcpClient::receiveWithFds(std::vector<int> &fds) {
+    return receiveInternal(&fds);
+}
+
+int appfw::TcpClient::writeWithFds(appfw::span<const uint8_t> buf, appfw::span<const int> fds) {
+    int size = platsock::sendWithFds(m_fd.get(), buf, fds);
+
+    if (size >= 0) {
+        return size;
+    } else {
+        return handleError("sendmsg");
+    }
+}
+#endif
+
+size_t appfw::TcpClient::receiveInternal(std::vector<int> *fds) {
+    size_t bytesRead = 0;
+
+    switch (platsock::recvIntoRingBuffer(m_fd.get(), m_RecvBuffer, bytesRead, fds)) {
+    case platsock::RecvResult::Eof: {
+        close(SocketCloseReason::ConnAborted);
+        break;
+    }
+    case platsock::RecvResult::SocketError: {
+        handleError("readv");
+        break;
+    }
+    default: {
+        break;
+    }
+    }
+
+    return bytesRead;
+}
+
+int appfw::TcpClient::write(appfw::span<const uint8_t> buf) {
+    int size = ::send(m_fd.get(), reinterpret_cast<const char *>(buf.data()), (int)buf.size(), 0);
+
+    if (size >= 0) {
+        return size;
+    } else {
+        return handleError("send");
+    }
+}
+
+void appfw::TcpClient::writeAll(appfw::span<const uint8_t> buf) {
+    bool isSent = platsock::writeAllWithTimeout(m_fd.get(), buf, m_iWriteTimeout,
+                                                [this](auto data) { return write(data); });
+
+    if (!isSent) {
+        close(SocketCloseReason::TimeOut);
+        throw ConnectionTimedOutException("write timed out");
+    }
+}
+
+int appfw::TcpClient::handleError(std::string_view callName) {
+#if PLATFORM_WINDOWS
+    int error = WSAGetLastError();
+
+    if (error != WSAEWOULDBLOCK) {
+        close(SocketCloseReason::Failure);
+        throw SocketErrorException(std::string(callName) + "() failed", error);
+    }
+
+    return 0;
+
+#elif PLATFORM_UNIX
+    int error = errno;
+
+    static_assert(EAGAIN == EWOULDBLOCK, "EAGAIN and EWOULDBLOCK are different");
+
+    if (error != EWOULDBLOCK) {
+        close(SocketCloseReason::Failure);
+        throw SocketErrorException(std::string(callName) + "() failed", error);
+    }
+
+    return 0;
+#else
+#error
+#endif
+}
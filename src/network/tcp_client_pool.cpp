@@ -0,0 +1,206 @@
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include <appfw/network/tcp_client_pool.h>
+#include "plat_sockets.h"
+
+//----------------------------------------------------------------
+// TcpClientPool::Data
+//----------------------------------------------------------------
+struct appfw::TcpClientPool::Data {
+    struct ClientEntry {
+        TcpClientPtr client;
+        TimerWheel::TimerId connectTimer = TimerWheel::NULL_TIMER;
+        bool bIsConnecting = true; //!< Connected callback wasn't called yet
+        bool bIsRemoved = false;   //!< Closed callback was called
+    };
+
+    //! Same indexes as m_Clients
+    std::vector<pollfd> m_PollList;
+    std::vector<ClientEntry> m_Clients;
+};
+
+//----------------------------------------------------------------
+// TcpClientPool
+//----------------------------------------------------------------
+appfw::TcpClientPool::TcpClientPool() {
+    m_Data = std::make_unique<Data>();
+}
+
+appfw::TcpClientPool::~TcpClientPool() = default;
+
+appfw::TcpClientPtr appfw::TcpClientPool::connect(const SockAddr &addr, int timeout) {
+    auto client = std::make_shared<TcpClient>();
+    client->connect(addr, timeout);
+    add(client);
+    return client;
+}
+
+void appfw::TcpClientPool::add(TcpClientPtr client) {
+    if (client->getStatus() == NetClientStatus::Closed) {
+        throw std::logic_error("client is not connecting or connected");
+    }
+
+    Data::ClientEntry entry;
+    entry.client = client;
+
+    if (client->getStatus() == NetClientStatus::Connecting) {
+        // Client is owned by the pool until the timer is cancelled
+        TcpClient *pClient = client.get();
+        int timeLeft = std::max(pClient->m_iTimeOut - (int)pClient->m_Timer.ms(), 0);
+
+        entry.connectTimer = m_Timers.add(timeLeft, [pClient]() {
+            pClient->m_Timer.stop();
+            pClient->close(SocketCloseReason::TimeOut);
+        });
+    }
+
+    // Connected sockets are writable right away so the callback is called in the next poll
+    m_Data->m_PollList.push_back({client->m_fd.get(), POLLOUT, 0});
+    m_Data->m_Clients.push_back(std::move(entry));
+}
+
+size_t appfw::TcpClientPool::getClientCount() {
+    return m_Data->m_Clients.size();
+}
+
+appfw::TcpClientPtr appfw::TcpClientPool::getClient(size_t idx) {
+    return m_Data->m_Clients[idx].client;
+}
+
+void appfw::TcpClientPool::poll(int time) {
+    // Wake up when the next timer expires
+    m_Timers.update();
+    int pollTime = m_Timers.getTimeout(time);
+
+    if (m_Data->m_PollList.empty()) {
+        // WSAPoll doesn't accept an empty list
+        if (pollTime > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(pollTime));
+        }
+    } else {
+        int num = platsock::poll(m_Data->m_PollList.data(), (unsigned)m_Data->m_PollList.size(),
+                                 pollTime);
+
+        if (num < 0) {
+            throw SocketErrorException("poll() failed");
+        }
+
+        // Clients added in callbacks are checked in the next poll
+        size_t count = m_Data->m_PollList.size();
+
+        for (size_t i = 0; i < count && num > 0; i++) {
+            int revents = m_Data->m_PollList[i].revents;
+
+            if (revents != 0) {
+                processEvents(i, revents);
+                num--;
+            }
+        }
+    }
+
+    // Close timed out connections
+    m_Timers.update();
+
+    removeClosedClients();
+}
+
+void appfw::TcpClientPool::processEvents(size_t idx, int revents) {
+    Data::ClientEntry &entry = m_Data->m_Clients[idx];
+    TcpClientPtr client = entry.client;
+
+    if (client->getStatus() == NetClientStatus::Closed) {
+        // Closed by a callback or a timer
+        return;
+    }
+
+    bool isReadyRead = false;
+
+    try {
+        isReadyRead = client->processPollEvents(revents);
+    } catch (const NetworkErrorException &) {
+        // Client is closed with the reason of the error
+        return;
+    }
+
+    if (entry.bIsConnecting && client->getStatus() == NetClientStatus::Connected) {
+        entry.bIsConnecting = false;
+
+        if (entry.connectTimer != TimerWheel::NULL_TIMER) {
+            m_Timers.cancel(entry.connectTimer);
+            entry.connectTimer = TimerWheel::NULL_TIMER;
+        }
+
+        m_Data->m_PollList[idx].events = POLLIN;
+
+        if (m_fnConnectedCb) {
+            try {
+                m_fnConnectedCb(idx, client);
+            } catch (...) {
+                AFW_ASSERT_REL_MSG(false, "Callback must not throw");
+                std::abort();
+            }
+        }
+    }
+
+    if (isReadyRead && client->getStatus() == NetClientStatus::Connected && m_fnReadyReadCb) {
+        try {
+            m_fnReadyReadCb(idx, client);
+        } catch (...) {
+            AFW_ASSERT_REL_MSG(false, "Callback must not throw");
+            std::abort();
+        }
+    }
+}
+
+void appfw::TcpClientPool::removeClosedClients() {
+    auto &clients = m_Data->m_Clients;
+    auto &pollList = m_Data->m_PollList;
+    bool isCallbackCalled;
+
+    // Callbacks can close clients that were already checked
+    do {
+        isCallbackCalled = false;
+
+        for (size_t i = 0; i < clients.size(); i++) {
+            if (!clients[i].bIsRemoved && clients[i].client->getStatus() == NetClientStatus::Closed) {
+                clients[i].bIsRemoved = true;
+                onClientClosed(i);
+                isCallbackCalled = true;
+            }
+        }
+    } while (isCallbackCalled);
+
+    // Remove them in one pass to keep it linear
+    size_t newSize = 0;
+
+    for (size_t i = 0; i < clients.size(); i++) {
+        if (clients[i].bIsRemoved) {
+            if (clients[i].connectTimer != TimerWheel::NULL_TIMER) {
+                m_Timers.cancel(clients[i].connectTimer);
+            }
+        } else {
+            if (newSize != i) {
+                clients[newSize] = std::move(clients[i]);
+                pollList[newSize] = pollList[i];
+            }
+
+            newSize++;
+        }
+    }
+
+    clients.resize(newSize);
+    pollList.resize(newSize);
+}
+
+void appfw::TcpClientPool::onClientClosed(size_t idx) {
+    if (m_fnClosedCb) {
+        try {
+            auto &client = m_Data->m_Clients[idx].client;
+            m_fnClosedCb(idx, client, client->getCloseReason());
+        } catch (...) {
+            AFW_ASSERT_REL_MSG(false, "Callback must not throw");
+            std::abort();
+        }
+    }
+}
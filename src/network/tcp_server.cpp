@@ -0,0 +1,1117 @@
+#include <cstring>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+#include <appfw/network/tcp_server.h>
+#include "plat_sockets.h"
+#include "io_uring.h"
+#include "send_queue.h"
+
+namespace {
+
+#if APPFW_IO_URING
+constexpr unsigned URING_ENTRIES = 256;
+constexpr uint16_t URING_BUF_GROUP = 0;
+constexpr unsigned URING_BUF_COUNT = 256;
+constexpr unsigned URING_BUF_SIZE = 8192;
+
+//! Operation is stored in the low byte of user_data, socket id in the rest
+enum UringOp : uint8_t
+{
+    URING_OP_ACCEPT = 1,
+    URING_OP_RECV,
+    URING_OP_POLL_OUT,
+    URING_OP_CANCEL,
+};
+
+inline uint64_t makeUringUserData(uint64_t id, UringOp op) {
+    return (id << 8) | op;
+}
+#endif
+
+} // namespace
+
+//----------------------------------------------------------------
+// TcpServer::Data
+//----------------------------------------------------------------
+struct appfw::TcpServer::Data {
+    std::vector<pollfd> m_PollList;
+    std::vector<TcpClientSocketPtr> m_Sockets;
+
+    //! Started when the wait of the current poll ends
+    Timer m_ProcessTimer;
+    unsigned m_uPollEvents = 0;
+
+    //! Accepted connections that aren't closing
+    size_t m_uOpenConnections = 0;
+
+    //! Closed to free a descriptor for a connection that is dropped when they run out
+    SockFd m_ReserveFd;
+    bool m_bIsAcceptPaused = false;
+    TimerWheel::TimerId m_AcceptBackoffTimer = TimerWheel::NULL_TIMER;
+
+    void openReserveFd();
+
+#if APPFW_IO_URING
+    platsock::IoUring m_Ring;
+    bool m_bIsAcceptArmed = false;
+    uint64_t m_uNextSocketId = 1;
+    std::unordered_map<uint64_t, TcpClientSocket *> m_UringSockets;
+
+    void armAccept(SocketFile fd);
+    void armRecv(TcpClientSocket &socket);
+    void armPollOut(TcpClientSocket &socket);
+    void cancelRequest(TcpClientSocket &socket, UringOp op);
+#endif
+};
+
+//----------------------------------------------------------------
+// TcpClientSocket::UringState
+//----------------------------------------------------------------
+struct appfw::TcpClientSocket::UringState {
+#if APPFW_IO_URING
+    //! Part of a provided buffer
+    struct Chunk {
+        uint16_t bid;
+        uint32_t offset;
+        uint32_t size;
+    };
+
+    platsock::IoUring *pRing = nullptr;
+    uint64_t id = 0;
+    bool bIsRecvArmed = false;
+    bool bIsPollOutArmed = false;
+    bool bIsWritable = false;
+    bool bHasNewData = false;
+    bool bIsEof = false;
+    int iError = 0;
+    std::deque<Chunk> chunks;
+
+    //! @returns whether receive() has something to report
+    inline bool hasPendingData() { return !chunks.empty() || bIsEof || iError != 0; }
+
+    //! Copies received data into buf and returns consumed buffers to the kernel.
+    size_t read(appfw::span<uint8_t> buf);
+
+    //! Returns all buffers to the kernel.
+    void releaseChunks();
+#endif
+};
+
+void appfw::TcpServer::Data::openReserveFd() {
+    if (m_ReserveFd.get() == 0) {
+        SocketFile fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+
+        if (fd != NULL_SOCKET) {
+            m_ReserveFd.set(fd);
+        }
+    }
+}
+
+#if APPFW_IO_URING
+void appfw::TcpServer::Data::armAccept(SocketFile fd) {
+    io_uring_sqe *sqe = m_Ring.getSqe();
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = fd;
+    sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+    sqe->accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+    sqe->user_data = makeUringUserData(0, URING_OP_ACCEPT);
+    m_bIsAcceptArmed = true;
+}
+
+void appfw::TcpServer::Data::armRecv(TcpClientSocket &socket) {
+    io_uring_sqe *sqe = m_Ring.getSqe();
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = socket.m_fd.get();
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = URING_BUF_GROUP;
+    sqe->user_data = makeUringUserData(socket.m_pUring->id, URING_OP_RECV);
+    socket.m_pUring->bIsRecvArmed = true;
+}
+
+void appfw::TcpServer::Data::armPollOut(TcpClientSocket &socket) {
+    io_uring_sqe *sqe = m_Ring.getSqe();
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = socket.m_fd.get();
+    sqe->poll32_events = POLLOUT;
+    sqe->user_data = makeUringUserData(socket.m_pUring->id, URING_OP_POLL_OUT);
+    socket.m_pUring->bIsPollOutArmed = true;
+}
+
+void appfw::TcpServer::Data::cancelRequest(TcpClientSocket &socket, UringOp op) {
+    // The request holds a reference to the socket so it must be cancelled to close it
+    io_uring_sqe *sqe = m_Ring.getSqe();
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->addr = makeUringUserData(socket.m_pUring->id, op);
+    sqe->user_data = makeUringUserData(0, URING_OP_CANCEL);
+}
+
+size_t appfw::TcpClientSocket::UringState::read(appfw::span<uint8_t> buf) {
+    size_t bytesRead = 0;
+
+    while (bytesRead < buf.size() && !chunks.empty()) {
+        Chunk &chunk = chunks.front();
+        size_t size = std::min<size_t>(chunk.size, buf.size() - bytesRead);
+        std::memcpy(buf.data() + bytesRead, pRing->getBuffer(chunk.bid) + chunk.offset, size);
+        bytesRead += size;
+        chunk.offset += (uint32_t)size;
+        chunk.size -= (uint32_t)size;
+
+        if (chunk.size == 0) {
+            pRing->returnBuffer(chunk.bid);
+            chunks.pop_front();
+        }
+    }
+
+    return bytesRead;
+}
+
+void appfw::TcpClientSocket::UringState::releaseChunks() {
+    for (Chunk &chunk : chunks) {
+        pRing->returnBuffer(chunk.bid);
+    }
+
+    chunks.clear();
+}
+#endif
+
+//----------------------------------------------------------------
+// TcpServer
+//----------------------------------------------------------------
+appfw::TcpServer::TcpServer() = default;
+
+appfw::TcpServer::~TcpServer() {
+    stopListening();
+}
+
+void appfw::TcpServer::startListening(IPAddress4 ip, uint16_t port, int queueSize) {
+    startListening(SockAddr(ip, port), queueSize);
+}
+
+void appfw::TcpServer::startListening(const SockAddr &addr, int queueSize) {
+    if (isListening()) {
+        throw std::logic_error("already listening");
+    }
+
+    try {
+        platsock::initNetworking();
+
+        int result = 0;
+        m_ListenAddr = addr;
+
+        // Open the socket
+        {
+            SocketFile sockfd =
+                ::socket(platsock::getNativeFamily(addr.getFamily()), SOCK_STREAM, 0);
+
+            if (sockfd == NULL_SOCKET) {
+                throw SocketErrorException("socket() failed");
+            }
+
+            m_fd.set(sockfd);
+        }
+
+        // Set non-blocking mode
+        if (!platsock::setSocketBlockingMode(m_fd.get(), false)) {
+            throw SocketErrorException("setSocketBlockingMode(false) failed");
+        }
+
+        // Buffer sizes must be set before listen() to affect the window of accepted sockets
+        platsock::applySocketOptions(m_fd.get(), m_SocketOptions);
+
+        // Accept IPv4 clients on IPv6 socket. Defaults differ between platforms.
+        if (addr.isIPv6()) {
+            int v6Only = m_bIPv6Only;
+            result = ::setsockopt(m_fd.get(), IPPROTO_IPV6, IPV6_V6ONLY,
+                                  reinterpret_cast<const char *>(&v6Only), sizeof(v6Only));
+            if (result != 0) {
+                throw SocketErrorException("setsockopt(IPV6_V6ONLY) failed");
+            }
+        }
+
+#if PLATFORM_UNIX
+        // Allow restarting while connections closed by the server are in TIME_WAIT.
+        // On Windows SO_REUSEADDR allows stealing the port so it's not used.
+        if (!addr.isUnix()) {
+            int reuseAddr = 1;
+            result = ::setsockopt(m_fd.get(), SOL_SOCKET, SO_REUSEADDR, &reuseAddr,
+                                  sizeof(reuseAddr));
+            if (result != 0) {
+                throw SocketErrorException("setsockopt(SO_REUSEADDR) failed");
+            }
+        }
+#endif
+
+        // Remove the file left by previous server
+        platsock::removeStaleUnixSocketFile(addr);
+
+        // Bind it
+        result = ::bind(m_fd.get(), addr.getSockAddrStruct(), addr.getSockAddrSize());
+        if (result != 0) {
+            throw SocketErrorException("bind() failed");
+        }
+
+        m_bOwnsUnixSocketFile = addr.isUnix();
+
+        // Start listening 
+        result = ::listen(m_fd.get(), queueSize);
+        if (result != 0) {
+            throw SocketErrorException("listen() failed");
+        }
+
+        // Create internal data instance
+        m_Data = std::make_unique<Data>();
+        m_ActiveBackend = NetBackend::Poll;
+        m_Metrics.setName(addr.toString());
+
+        // Push server socket into poll list
+        m_Data->m_PollList.push_back({m_fd.get(), POLLIN, 0});
+        m_Data->openReserveFd();
+
+#if APPFW_IO_URING
+        // Unix sockets need recvmsg for fd passing
+        if (m_Backend == NetBackend::IoUring && !addr.isUnix() &&
+            isNetBackendSupported(NetBackend::IoUring)) {
+            m_Data->m_Ring.init(URING_ENTRIES);
+            m_Data->m_Ring.registerBufRing(URING_BUF_GROUP, URING_BUF_COUNT, URING_BUF_SIZE);
+            m_Data->armAccept(m_fd.get());
+            m_ActiveBackend = NetBackend::IoUring;
+        }
+#endif
+    } catch (...) {
+        stopListening();
+        throw;
+    }
+}
+
+void appfw::TcpServer::stopListening() {
+    if (isListening()) {
+        // Close all active connections. Data is not created if startListening failed.
+        for (size_t i = 0; m_Data && i < m_Data->m_Sockets.size(); i++) {
+            m_Data->m_Sockets[i]->close(SocketCloseReason::Shutdown);
+            removeConnection(i);
+        }
+
+        if (m_Data && m_Data->m_AcceptBackoffTimer != TimerWheel::NULL_TIMER) {
+            m_Timers.cancel(m_Data->m_AcceptBackoffTimer);
+        }
+
+        m_Data.reset();
+        m_fd.close();
+
+        if (m_bOwnsUnixSocketFile) {
+            platsock::removeUnixSocketFile(m_ListenAddr);
+            m_bOwnsUnixSocketFile = false;
+        }
+    }
+}
+
+void appfw::TcpServer::poll(int time) {
+    if (!isListening()) {
+        throw std::logic_error("not listening");
+    }
+
+    // Wait for sockets with queued data to become writable
+    uint64_t sendQueueBytes = 0;
+
+    for (size_t i = 0; i < m_Data->m_Sockets.size(); i++) {
+        updateSendQueue(i);
+        sendQueueBytes += m_Data->m_Sockets[i]->getSendQueueSize();
+    }
+
+    m_Metrics.sendQueueBytes.set(sendQueueBytes);
+    m_Metrics.maxSendQueueBytes.setMax(sendQueueBytes);
+
+    if (m_ActiveBackend == NetBackend::IoUring) {
+        pollIoUring(time);
+    } else {
+        pollSockets(time);
+    }
+
+    // Close timed out connections
+    m_Timers.update();
+
+    // Remove closed sockets
+    for (size_t i = m_Data->m_Sockets.size(); i != 0; i--) {
+        if (!m_Data->m_Sockets[i - 1]->isOpen()) {
+            removeConnection(i - 1);
+
+            // Remove socket from lists
+            m_Data->m_Sockets.erase(m_Data->m_Sockets.begin() + i - 1);
+            m_Data->m_PollList.erase(m_Data->m_PollList.begin() + i);
+        }
+    }
+
+    uint64_t processTime = (uint64_t)m_Data->m_ProcessTimer.us();
+    m_Metrics.polls.add(1);
+    m_Metrics.pollEvents.add(m_Data->m_uPollEvents);
+    m_Metrics.maxPollEvents.setMax(m_Data->m_uPollEvents);
+    m_Metrics.pollProcessTimeUs.add(processTime);
+    m_Metrics.maxPollProcessTimeUs.setMax(processTime);
+    m_Metrics.connections.set(m_Data->m_Sockets.size());
+}
+
+void appfw::TcpServer::pollSockets(int time) {
+    AFW_ASSERT(m_Data->m_PollList.size() >= 1);
+
+    // Wake up when the next timer expires
+    m_Timers.update();
+    int pollTime = m_Timers.getTimeout(time);
+
+    int num = appfw::platsock::poll(m_Data->m_PollList.data(), (unsigned)m_Data->m_PollList.size(), pollTime);
+    m_Data->m_ProcessTimer.start();
+    m_Data->m_uPollEvents = num > 0 ? (unsigned)num : 0;
+
+    if (num < 0) {
+        // Error, most likely unrecoverable
+        auto ex = SocketErrorException("poll() failed");
+        stopListening();
+        throw ex;
+    } else if (num > 0) {
+        // Check for new connections
+        {
+            int revents = m_Data->m_PollList[0].revents;
+
+            if (revents & POLLERR || revents & POLLHUP || revents & POLLNVAL) {
+                // Listen socket failed
+                auto ex = SocketErrorException("listen socket failed");
+                stopListening();
+                throw ex;
+            }
+
+            if (revents & POLLIN) {
+                // Accept new connections
+                acceptConnections();
+                num--;
+            }
+        }
+
+        // Read data
+        for (size_t i = 1; i < m_Data->m_PollList.size() && num > 0; i++) {
+            int revents = m_Data->m_PollList[i].revents;
+            if (revents & POLLHUP) {
+                m_Data->m_Sockets[i - 1]->close(SocketCloseReason::ConnAborted);
+                num--;
+            } else if (revents & POLLERR || revents & POLLNVAL) {
+                m_Data->m_Sockets[i - 1]->close(SocketCloseReason::Failure);
+                num--;
+            } else if (revents & (POLLIN | POLLOUT)) {
+                TcpClientSocket &socket = *m_Data->m_Sockets[i - 1];
+
+                if (revents & POLLOUT) {
+                    onReadyWrite(i - 1);
+                }
+
+                if (revents & POLLIN) {
+                    if (socket.m_IdleTimer != TimerWheel::NULL_TIMER) {
+                        m_Timers.reschedule(socket.m_IdleTimer, m_iIdleTimeout);
+                    }
+
+                    if (socket.isOpen()) {
+                        onReadyRead(i - 1);
+                    }
+                }
+                num--;
+            }
+        }
+    }
+}
+
+void appfw::TcpServer::pollIoUring([[maybe_unused]] int time) {
+#if APPFW_IO_URING
+    Data &data = *m_Data;
+    platsock::IoUring &ring = data.m_Ring;
+    bool hasPendingData = false;
+
+    // Multishot requests stop on errors or when provided buffers run out
+    if (!data.m_bIsAcceptArmed && !data.m_bIsAcceptPaused) {
+        data.armAccept(m_fd.get());
+    }
+
+    for (const TcpClientSocketPtr &socket : data.m_Sockets) {
+        TcpClientSocket::UringState &state = *socket->m_pUring;
+
+        if (!state.bIsRecvArmed && !state.bIsEof && state.iError == 0 &&
+            ring.getAvailableBuffers() > 0) {
+            data.armRecv(*socket);
+        }
+
+        // Data that wasn't read is reported again like with level-triggered poll
+        hasPendingData = hasPendingData || (state.hasPendingData() && socket->isOpen());
+    }
+
+    // Wake up when the next timer expires
+    m_Timers.update();
+    int pollTime = hasPendingData ? 0 : m_Timers.getTimeout(time);
+
+    try {
+        ring.submitAndWait(pollTime);
+    } catch (...) {
+        // Unrecoverable
+        stopListening();
+        throw;
+    }
+
+    m_Data->m_ProcessTimer.start();
+    m_Data->m_uPollEvents = ring.processCompletions([&](const io_uring_cqe &cqe) {
+        uint64_t id = cqe.user_data >> 8;
+        bool hasMore = cqe.flags & IORING_CQE_F_MORE;
+        bool hasBuffer = cqe.flags & IORING_CQE_F_BUFFER;
+        uint16_t bid = (uint16_t)(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+
+        if (hasBuffer) {
+            ring.onBufferUsed();
+        }
+
+        switch ((UringOp)(cqe.user_data & 0xFF)) {
+        case URING_OP_ACCEPT: {
+            data.m_bIsAcceptArmed = hasMore;
+
+            if (cqe.res >= 0) {
+                sockaddr_storage sa;
+                socklen_t saLen = sizeof(sa);
+
+                if (::getpeername(cqe.res, reinterpret_cast<sockaddr *>(&sa), &saLen) != 0) {
+                    // Connection was already reset
+                    SockFd fd(cqe.res);
+                    break;
+                }
+
+                SockAddr addr = SockAddr::fromSockAddrStruct(reinterpret_cast<sockaddr *>(&sa), saLen);
+                acceptConnection(cqe.res, addr.unmapped());
+            } else if (cqe.res == -EMFILE || cqe.res == -ENFILE || cqe.res == -ENOBUFS ||
+                       cqe.res == -ENOMEM) {
+                // Accept is re-armed on next poll if the connection was dropped
+                dropPendingConnection();
+            }
+
+            break;
+        }
+        case URING_OP_RECV: {
+            auto it = data.m_UringSockets.find(id);
+
+            if (it == data.m_UringSockets.end()) {
+                // Socket was removed
+                if (hasBuffer) {
+                    ring.returnBuffer(bid);
+                }
+
+                break;
+            }
+
+            TcpClientSocket::UringState &state = *it->second->m_pUring;
+            state.bIsRecvArmed = state.bIsRecvArmed && hasMore;
+
+            if (cqe.res > 0 && hasBuffer) {
+                state.chunks.push_back({bid, 0, (uint32_t)cqe.res});
+                state.bHasNewData = true;
+            } else {
+                if (hasBuffer) {
+                    ring.returnBuffer(bid);
+                }
+
+                if (cqe.res == 0) {
+                    state.bIsEof = true;
+                } else if (cqe.res != -ENOBUFS) {
+                    // Out of buffers is not an error, it will be re-armed later
+                    state.iError = -cqe.res;
+                }
+            }
+
+            break;
+        }
+        case URING_OP_POLL_OUT: {
+            auto it = data.m_UringSockets.find(id);
+
+            if (it != data.m_UringSockets.end()) {
+                // Errors are reported by the next send
+                TcpClientSocket::UringState &state = *it->second->m_pUring;
+                state.bIsPollOutArmed = false;
+                state.bIsWritable = true;
+            }
+
+            break;
+        }
+        default: {
+            break;
+        }
+        }
+    });
+
+    // Report received data and writable sockets
+    for (size_t i = 0; i < data.m_Sockets.size(); i++) {
+        TcpClientSocket &socket = *data.m_Sockets[i];
+        TcpClientSocket::UringState &state = *socket.m_pUring;
+
+        if (state.bIsWritable) {
+            state.bIsWritable = false;
+            onReadyWrite(i);
+        }
+
+        if (state.bHasNewData) {
+            state.bHasNewData = false;
+
+            if (socket.m_IdleTimer != TimerWheel::NULL_TIMER) {
+                m_Timers.reschedule(socket.m_IdleTimer, m_iIdleTimeout);
+            }
+        }
+
+        if (state.hasPendingData() && socket.isOpen()) {
+            onReadyRead(i);
+        }
+    }
+#endif
+}
+
+size_t appfw::TcpServer::getConnectedClients() {
+    return m_Data->m_Sockets.size();
+}
+
+appfw::TcpClientSocketPtr appfw::TcpServer::getSocket(size_t idx) {
+    return m_Data->m_Sockets[idx];
+}
+
+void appfw::TcpServer::sendToAll(appfw::span<uint8_t> buf) {
+    for (size_t i = 0; i < m_Data->m_Sockets.size(); i++) {
+        m_Data->m_Sockets[i]->writeAll(buf);
+    }
+}
+
+void appfw::TcpServer::setConnAcceptedCallback(const ConnAcceptedCallback &fn) {
+    m_fnAcceptedCb = fn;
+}
+
+void appfw::TcpServer::setConnClosedCallback(const ConnClosedCallback &fn) {
+    m_fnClosedCb = fn;
+}
+
+void appfw::TcpServer::setReadyReadCallback(const ReadyReadCallback &fn) {
+    m_fnReadyReadCb = fn;
+}
+
+void appfw::TcpServer::acceptConnections() {
+    SocketFile sock = 0;
+    SockAddr addr;
+
+    // Listen socket stays readable if the budget runs out
+    for (int i = 0; m_iAcceptBudget == 0 || i < m_iAcceptBudget; i++) {
+        switch (platsock::acceptConnection(m_fd.get(), sock, addr)) {
+        case platsock::AcceptResult::Accepted: {
+            acceptConnection(sock, addr);
+            break;
+        }
+        case platsock::AcceptResult::BadAccept: {
+            // Ignore this one
+            break;
+        }
+        case platsock::AcceptResult::WouldBlock: {
+            // Try again on next poll
+            return;
+        }
+        case platsock::AcceptResult::NoResources: {
+            // The connection stays pending and keeps the listen socket readable
+            if (!dropPendingConnection()) {
+                return;
+            }
+
+            break;
+        }
+        }
+    }
+}
+
+void appfw::TcpServer::acceptConnection(SocketFile sock, const SockAddr &addr) {
+    // Socket is already non-blocking (accept4 or IORING_OP_ACCEPT flags)
+    if (m_uMaxClients != 0 && m_Data->m_uOpenConnections >= m_uMaxClients) {
+        rejectConnection(sock);
+        return;
+    }
+
+    try {
+        platsock::applySocketOptions(sock, m_SocketOptions);
+    } catch (const SocketErrorException &) {
+        // Drop the connection
+        SockFd fd(sock);
+        return;
+    }
+
+    size_t index = m_Data->m_Sockets.size();
+    m_Data->m_Sockets.push_back(std::make_shared<TcpClientSocket>());
+
+    auto &socket = m_Data->m_Sockets[index];
+    socket->m_fd.set(sock);
+    socket->m_RemoteAddr = addr;
+    socket->m_iWriteTimeout = m_iWriteTimeout;
+    socket->m_pServerMetrics = &m_Metrics;
+    socket->m_pOpenConnections = &m_Data->m_uOpenConnections;
+    m_Data->m_uOpenConnections++;
+    m_Metrics.accepts.add(1);
+
+    if (m_iIdleTimeout > 0) {
+        // Socket is removed before the server so the pointer outlives the timer
+        TcpClientSocket *pSocket = socket.get();
+        socket->m_IdleTimer = m_Timers.add(m_iIdleTimeout, [pSocket]() {
+            pSocket->m_IdleTimer = TimerWheel::NULL_TIMER;
+            pSocket->close(SocketCloseReason::TimeOut);
+        });
+    }
+
+    // Add it to poll list
+    m_Data->m_PollList.push_back({sock, POLLIN, 0});
+
+#if APPFW_IO_URING
+    if (m_ActiveBackend == NetBackend::IoUring) {
+        socket->m_pUring = std::make_unique<TcpClientSocket::UringState>();
+        socket->m_pUring->pRing = &m_Data->m_Ring;
+        socket->m_pUring->id = m_Data->m_uNextSocketId++;
+        m_Data->m_UringSockets[socket->m_pUring->id] = socket.get();
+
+        if (m_Data->m_Ring.getAvailableBuffers() > 0) {
+            m_Data->armRecv(*socket);
+        }
+    }
+#endif
+
+    try {
+        m_fnAcceptedCb(index, socket);
+    } catch (...) {
+        AFW_ASSERT_REL_MSG(false, "Callback must not throw");
+        std::abort();
+    }
+}
+
+void appfw::TcpServer::rejectConnection(SocketFile sock) {
+    SockFd fd(sock);
+
+    if (!m_RejectMessage.empty()) {
+        // Best effort, the socket buffer is empty so it usually fits
+        ::send(fd.get(), reinterpret_cast<const char *>(m_RejectMessage.data()),
+               (int)m_RejectMessage.size(), 0);
+    }
+
+    m_Metrics.rejects.add(1);
+}
+
+bool appfw::TcpServer::dropPendingConnection() {
+    Data &data = *m_Data;
+    bool isDropped = false;
+
+    if (data.m_ReserveFd.get() != 0) {
+        // Free a descriptor to accept the connection and close it
+        data.m_ReserveFd.close();
+
+        SocketFile sock = 0;
+        SockAddr addr;
+
+        switch (platsock::acceptConnection(m_fd.get(), sock, addr)) {
+        case platsock::AcceptResult::Accepted: {
+            rejectConnection(sock);
+            isDropped = true;
+            break;
+        }
+        case platsock::AcceptResult::BadAccept:
+        case platsock::AcceptResult::WouldBlock: {
+            // Connection is already gone
+            data.openReserveFd();
+            return false;
+        }
+        case platsock::AcceptResult::NoResources: {
+            // Out of memory or system-wide file limit
+            break;
+        }
+        }
+
+        data.openReserveFd();
+    }
+
+    if (!isDropped || data.m_ReserveFd.get() == 0) {
+        // Can't make progress, stop polling the listen socket for a while
+        pauseAccepting();
+        return false;
+    }
+
+    return true;
+}
+
+void appfw::TcpServer::pauseAccepting() {
+    Data &data = *m_Data;
+
+    if (data.m_bIsAcceptPaused) {
+        return;
+    }
+
+    data.m_bIsAcceptPaused = true;
+    data.m_PollList[0].events = 0;
+    data.m_AcceptBackoffTimer = m_Timers.add(ACCEPT_BACKOFF_TIME, [this]() {
+        Data &data = *m_Data;
+        data.m_AcceptBackoffTimer = TimerWheel::NULL_TIMER;
+        data.m_bIsAcceptPaused = false;
+        data.m_PollList[0].events = POLLIN;
+        data.openReserveFd();
+    });
+}
+
+void appfw::TcpServer::onReadyRead(size_t idx) {
+    try {
+        m_fnReadyReadCb(idx, m_Data->m_Sockets[idx]);
+    } catch (...) {
+        AFW_ASSERT_REL_MSG(false, "Callback must not throw");
+        std::abort();
+    }
+}
+
+void appfw::TcpServer::onReadyWrite(size_t idx) {
+    TcpClientSocket &socket = *m_Data->m_Sockets[idx];
+
+    if (!socket.isOpen()) {
+        return;
+    }
+
+    try {
+        socket.flushSendQueue();
+    } catch (const std::exception &) {
+        // Socket is closed on socket errors but not when a file can't be read
+        socket.close(SocketCloseReason::Failure);
+    }
+}
+
+void appfw::TcpServer::updateSendQueue(size_t idx) {
+    TcpClientSocket &socket = *m_Data->m_Sockets[idx];
+    bool hasQueue = socket.isOpen() && socket.getSendQueueSize() != 0;
+    m_Data->m_PollList[idx + 1].events = hasQueue ? POLLIN | POLLOUT : POLLIN;
+
+    if (!hasQueue || socket.m_iWriteTimeout == 0) {
+        if (socket.m_WriteTimer != TimerWheel::NULL_TIMER) {
+            m_Timers.cancel(socket.m_WriteTimer);
+            socket.m_WriteTimer = TimerWheel::NULL_TIMER;
+        }
+    } else if (socket.m_WriteTimer == TimerWheel::NULL_TIMER) {
+        // Socket is removed before the server so the pointer outlives the timer
+        TcpClientSocket *pSocket = &socket;
+        socket.m_WriteTimer = m_Timers.add(socket.m_iWriteTimeout, [pSocket]() {
+            pSocket->m_WriteTimer = TimerWheel::NULL_TIMER;
+            pSocket->close(SocketCloseReason::TimeOut);
+        });
+    } else if (socket.m_bHasSendProgress) {
+        m_Timers.reschedule(socket.m_WriteTimer, socket.m_iWriteTimeout);
+    }
+
+    socket.m_bHasSendProgress = false;
+
+#if APPFW_IO_URING
+    if (hasQueue && socket.m_pUring && !socket.m_pUring->bIsPollOutArmed) {
+        m_Data->armPollOut(socket);
+    }
+#endif
+}
+
+void appfw::TcpServer::onConnectionClosed(size_t idx) {
+    try {
+        auto &socket = m_Data->m_Sockets[idx];
+        m_fnClosedCb(idx, socket, socket->m_CloseReason);
+    } catch (...) {
+        AFW_ASSERT_REL_MSG(false, "Callback must not throw");
+        std::abort();
+    }
+}
+
+void appfw::TcpServer::removeConnection(size_t idx) {
+    TcpClientSocket &socket = *m_Data->m_Sockets[idx];
+
+    if (socket.m_IdleTimer != TimerWheel::NULL_TIMER) {
+        m_Timers.cancel(socket.m_IdleTimer);
+        socket.m_IdleTimer = TimerWheel::NULL_TIMER;
+    }
+
+    if (socket.m_WriteTimer != TimerWheel::NULL_TIMER) {
+        m_Timers.cancel(socket.m_WriteTimer);
+        socket.m_WriteTimer = TimerWheel::NULL_TIMER;
+    }
+
+    // Close queued files
+    socket.m_pSendQueue.reset();
+
+#if APPFW_IO_URING
+    if (socket.m_pUring) {
+        if (socket.m_pUring->bIsRecvArmed) {
+            m_Data->cancelRequest(socket, URING_OP_RECV);
+            socket.m_pUring->bIsRecvArmed = false;
+        }
+
+        if (socket.m_pUring->bIsPollOutArmed) {
+            m_Data->cancelRequest(socket, URING_OP_POLL_OUT);
+            socket.m_pUring->bIsPollOutArmed = false;
+        }
+
+        socket.m_pUring->releaseChunks();
+        m_Data->m_UringSockets.erase(socket.m_pUring->id);
+        socket.m_pUring.reset();
+    }
+#endif
+
+    socket.m_fd.close();
+    socket.m_pServerMetrics = nullptr;
+    socket.m_pOpenConnections = nullptr;
+    m_Metrics.closes[(size_t)socket.m_CloseReason].add(1);
+    onConnectionClosed(idx);
+}
+
+//----------------------------------------------------------------
+// TcpClientSocket
+//----------------------------------------------------------------
+appfw::TcpClientSocket::TcpClientSocket() = default;
+
+appfw::TcpClientSocket::~TcpClientSocket() = default;
+
+int appfw::TcpClientSocket::read(appfw::span<uint8_t> buf) {
+#if APPFW_IO_URING
+    if (m_pUring) {
+        size_t size = m_pUring->read(buf);
+
+        if (size == 0 && m_pUring->iError != 0) {
+            close(SocketCloseReason::Failure);
+            throw SocketErrorException("recv() failed", m_pUring->iError);
+        }
+
+        onDataReceived(size);
+        return (int)size;
+    }
+#endif
+
+    int size = ::recv(m_fd.get(), reinterpret_cast<char *>(buf.data()), (int)buf.size(), 0);
+
+    if (size >= 0) {
+        onDataReceived((size_t)size);
+        return size;
+    } else {
+        return handleError("recv");
+    }
+}
+
+void appfw::TcpClientSocket::setSocketOptions(const SocketOptions &opts) {
+    platsock::applySocketOptions(m_fd.get(), opts);
+}
+
+size_t appfw::TcpClientSocket::receive() {
+    return receiveInternal(nullptr);
+}
+
+#if PLATFORM_UNIX
+size_t appfw::TcpClientSocket::receiveWithFds(std::vector<int> &fds) {
+    return receiveInternal(&fds);
+}
+
+int appfw::TcpClientSocket::writeWithFds(appfw::span<const uint8_t> buf,
+                                         appfw::span<const int> fds) {
+    int size = platsock::sendWithFds(m_fd.get(), buf, fds);
+
+    if (size >= 0) {
+        onDataSent((size_t)size);
+        return size;
+    } else {
+        return handleError("sendmsg");
+    }
+}
+#endif
+
+size_t appfw::TcpClientSocket::receiveInternal(std::vector<int> *fds) {
+    size_t bytesRead = 0;
+
+#if APPFW_IO_URING
+    if (m_pUring) {
+        if (fds) {
+            throw std::logic_error("fd passing is not supported by io_uring backend");
+        }
+
+        RecvRingBuffer::WriteView view = m_RecvBuffer.writable();
+        bytesRead = m_pUring->read(view.first);
+
+        if (bytesRead == view.first.size()) {
+            bytesRead += m_pUring->read(view.second);
+        }
+
+        m_RecvBuffer.commit(bytesRead);
+        onDataReceived(bytesRead);
+
+        if (m_pUring->chunks.empty()) {
+            if (m_pUring->iError != 0) {
+                close(SocketCloseReason::Failure);
+                throw SocketErrorException("recv() failed", m_pUring->iError);
+            } else if (m_pUring->bIsEof) {
+                close(SocketCloseReason::ConnAborted);
+            }
+        }
+
+        return bytesRead;
+    }
+#endif
+
+    platsock::RecvResult result = platsock::recvIntoRingBuffer(m_fd.get(), m_RecvBuffer, bytesRead, fds);
+    onDataReceived(bytesRead);
+
+    switch (result) {
+    case platsock::RecvResult::Eof: {
+        close(SocketCloseReason::ConnAborted);
+        break;
+    }
+    case platsock::RecvResult::SocketError: {
+        handleError("readv");
+        break;
+    }
+    default: {
+        break;
+    }
+    }
+
+    return bytesRead;
+}
+
+int appfw::TcpClientSocket::write(appfw::span<const uint8_t> buf) {
+    if (!flushSendQueue()) {
+        // Queued data must be sent first
+        return 0;
+    }
+
+    int size = ::send(m_fd.get(), reinterpret_cast<const char *>(buf.data()), (int)buf.size(), 0);
+
+    if (size >= 0) {
+        onDataSent((size_t)size);
+        return size;
+    } else {
+        return handleError("send");
+    }
+}
+
+void appfw::TcpClientSocket::writeAll(appfw::span<const uint8_t> buf) {
+    bool isSent = platsock::writeAllWithTimeout(m_fd.get(), buf, m_iWriteTimeout,
+                                                [this](auto data) { return write(data); });
+
+    if (!isSent) {
+        close(SocketCloseReason::TimeOut);
+        throw ConnectionTimedOutException("write timed out");
+    }
+}
+
+void appfw::TcpClientSocket::queueWrite(appfw::span<const uint8_t> buf) {
+    size_t sent = (size_t)write(buf);
+
+    if (sent != buf.size()) {
+        if (!m_pSendQueue) {
+            m_pSendQueue = std::make_unique<platsock::SendQueue>();
+        }
+
+        m_pSendQueue->push(buf.subspan(sent));
+    }
+}
+
+void appfw::TcpClientSocket::sendFile(const fs::path &path, uint64_t offset, uint64_t length) {
+    if (!m_pSendQueue) {
+        m_pSendQueue = std::make_unique<platsock::SendQueue>();
+    }
+
+    m_pSendQueue->pushFile(path, offset, length);
+    flushSendQueue();
+}
+
+uint64_t appfw::TcpClientSocket::getSendQueueSize() {
+    return m_pSendQueue ? m_pSendQueue->getSize() : 0;
+}
+
+bool appfw::TcpClientSocket::flushSendQueue() {
+    if (!m_pSendQueue || m_pSendQueue->isEmpty()) {
+        return true;
+    }
+
+    uint64_t bytesSent = 0;
+    bool isOk = false;
+
+    try {
+        isOk = m_pSendQueue->flush(m_fd.get(), bytesSent);
+    } catch (...) {
+        // File can't be read, the stream is broken
+        close(SocketCloseReason::Failure);
+        throw;
+    }
+
+    m_bHasSendProgress = m_bHasSendProgress || bytesSent != 0;
+    onDataSent(bytesSent);
+
+    if (!isOk) {
+        handleError("send");
+    }
+
+    return m_pSendQueue->isEmpty();
+}
+
+void appfw::TcpClientSocket::onDataReceived(size_t size) {
+    if (size != 0) {
+        m_Metrics.bytesIn.add(size);
+        m_Metrics.recvCalls.add(1);
+
+        if (m_pServerMetrics) {
+            m_pServerMetrics->traffic.bytesIn.add(size);
+            m_pServerMetrics->traffic.recvCalls.add(1);
+        }
+    }
+}
+
+void appfw::TcpClientSocket::onDataSent(size_t size) {
+    if (size != 0) {
+        m_Metrics.bytesOut.add(size);
+        m_Metrics.sendCalls.add(1);
+
+        if (m_pServerMetrics) {
+            m_pServerMetrics->traffic.bytesOut.add(size);
+            m_pServerMetrics->traffic.sendCalls.add(1);
+        }
+    }
+}
+
+int appfw::TcpClientSocket::handleError(std::string_view callName) {
+#if PLATFORM_WINDOWS
+    int error = WSAGetLastError();
+
+    switch (error) {
+    case WSAEWOULDBLOCK: {
+        return 0;
+    }
+    case WSAECONNABORTED: {
+        close(SocketCloseReason::ConnAborted);
+        break;
+    }
+    case WSAENETRESET:
+    case WSAETIMEDOUT: {
+        close(SocketCloseReason::TimeOut);
+        break;
+    }
+    default: {
+        close(SocketCloseReason::Failure);
+    }
+    }
+
+    throw SocketErrorException(std::string(callName) + "() failed", error);
+#elif PLATFORM_UNIX
+    int error = errno;
+
+    static_assert(EAGAIN == EWOULDBLOCK, "EAGAIN and EWOULDBLOCK are different");
+
+    switch (errno) {
+    case EWOULDBLOCK: {
+        return 0;
+    }
+    case ECONNREFUSED: {
+        close(SocketCloseReason::ConnAborted);
+        break;
+    }
+
+    default: {
+        close(SocketCloseReason::Failure);
+    }
+    }
+
+    throw SocketErrorException(std::string(callName) + "() failed", error);
+#else
+#error
+#endif
+}
@@ -0,0 +1,442 @@
+#include <cstring>
+#include <appfw/network/udp_socket4.h>
+#include "plat_sockets.h"
+
+#if PLATFORM_LINUX && defined(UDP_SEGMENT) && defined(UDP_GRO)
+#define APPFW_UDP_GSO 1
+#else
+#define APPFW_UDP_GSO 0
+#endif
+
+namespace {
+
+#if PLATFORM_WINDOWS
+inline int getLastError() { return WSAGetLastError(); }
+inline bool isWouldBlock(int error) { return error == WSAEWOULDBLOCK; }
+inline bool isTruncated(int error) { return error == WSAEMSGSIZE; }
+#elif PLATFORM_UNIX
+inline int getLastError() { return errno; }
+inline bool isWouldBlock(int error) { return error == EWOULDBLOCK || error == EAGAIN; }
+inline bool isTruncated(int) { return false; }
+#else
+#error
+#endif
+
+#if APPFW_UDP_GSO
+//! Maximum number of segments the kernel accepts in a UDP_SEGMENT message
+constexpr size_t MAX_GSO_SEGMENTS = 64;
+
+//! Errors of a UDP_SEGMENT message the kernel can't send (old kernel, no checksum offload)
+inline bool isGsoRejected(int error) {
+    return error == EINVAL || error == EIO || error == ENOPROTOOPT || error == EOPNOTSUPP;
+}
+#endif
+
+//! @returns whether the message must be split into datagrams in software
+inline bool needsSoftwareSplit(const appfw::UdpMessage4 &msg) {
+    if (msg.segmentSize == 0 || msg.size <= msg.segmentSize) {
+        return false;
+    }
+
+#if APPFW_UDP_GSO
+    return (msg.size + msg.segmentSize - 1) / msg.segmentSize > MAX_GSO_SEGMENTS;
+#else
+    return true;
+#endif
+}
+
+} // namespace
+
+//----------------------------------------------------------------
+// UdpBatch4::Data
+//----------------------------------------------------------------
+#if PLATFORM_LINUX
+struct appfw::UdpBatch4::Data {
+    //! Size of control buffer of a message. Fits UDP_SEGMENT and UDP_GRO.
+    static constexpr size_t CONTROL_SIZE = CMSG_SPACE(sizeof(int));
+
+    std::vector<mmsghdr> m_Headers;
+    std::vector<iovec> m_Iovecs;
+    std::vector<sockaddr_in> m_Addrs;
+    std::vector<uint8_t> m_Control;
+
+    Data(UdpBatch4 &batch) {
+        size_t count = batch.capacity();
+        m_Headers.resize(count);
+        m_Iovecs.resize(count);
+        m_Addrs.resize(count);
+        m_Control.resize(count * CONTROL_SIZE);
+
+        // Pointers never change, only lengths are updated before every call
+        for (size_t i = 0; i < count; i++) {
+            m_Iovecs[i].iov_base = batch.getBuffer(i).data();
+            m_Iovecs[i].iov_len = batch.bufferSize();
+
+            msghdr &hdr = m_Headers[i].msg_hdr;
+            std::memset(&hdr, 0, sizeof(hdr));
+            hdr.msg_name = &m_Addrs[i];
+            hdr.msg_namelen = sizeof(sockaddr_in);
+            hdr.msg_iov = &m_Iovecs[i];
+            hdr.msg_iovlen = 1;
+            hdr.msg_control = m_Control.data() + i * CONTROL_SIZE;
+            hdr.msg_controllen = 0;
+        }
+    }
+};
+#else
+struct appfw::UdpBatch4::Data {
+    Data(UdpBatch4 &) {}
+};
+#endif
+
+//----------------------------------------------------------------
+// UdpBatch4
+//----------------------------------------------------------------
+appfw::UdpBatch4::UdpBatch4(size_t count, size_t bufferSize) {
+    AFW_ASSERT(count > 0 && bufferSize > 0);
+    m_Buffer.resize(count * bufferSize);
+    m_Messages.resize(count);
+    m_uBufferSize = bufferSize;
+    m_Data = std::make_unique<Data>(*this);
+}
+
+appfw::UdpBatch4::~UdpBatch4() = default;
+
+bool appfw::UdpBatch4::push(const SockAddr4 &addr, appfw::span<const uint8_t> data,
+                            uint16_t segmentSize) {
+    if (full() || data.size() > m_uBufferSize) {
+        return false;
+    }
+
+    UdpMessage4 &msg = m_Messages[m_uSize];
+    msg.addr = addr;
+    msg.size = data.size();
+    msg.segmentSize = segmentSize;
+    std::memcpy(getBuffer(m_uSize).data(), data.data(), data.size());
+    m_uSize++;
+    return true;
+}
+
+void appfw::UdpBatch4::setSize(size_t size) {
+    AFW_ASSERT(size <= capacity());
+    m_uSize = size;
+}
+
+//----------------------------------------------------------------
+// UdpSocket4
+//----------------------------------------------------------------
+appfw::UdpSocket4::UdpSocket4() = default;
+
+appfw::UdpSocket4::~UdpSocket4() {
+    close();
+}
+
+void appfw::UdpSocket4::open(const SockAddr4 &addr) {
+    if (isOpen()) {
+        throw std::logic_error("already open");
+    }
+
+    try {
+        platsock::initNetworking();
+
+        // Open the socket
+        {
+            SocketFile sockfd = ::socket(PF_INET, SOCK_DGRAM, 0);
+
+            if (sockfd == NULL_SOCKET) {
+                throw SocketErrorException("socket() failed");
+            }
+
+            m_fd.set(sockfd);
+        }
+
+        // Set non-blocking mode
+        if (!platsock::setSocketBlockingMode(m_fd.get(), false)) {
+            throw SocketErrorException("setSocketBlockingMode(false) failed");
+        }
+
+        // Bind it
+        sockaddr_in sa = addr.toSockAddrStruct();
+        if (::bind(m_fd.get(), reinterpret_cast<sockaddr *>(&sa), sizeof(sa)) != 0) {
+            throw SocketErrorException("bind() failed");
+        }
+
+        // Get the actual port
+        sockaddr_in localAddr = {};
+#if PLATFORM_WINDOWS
+        int addrLen = sizeof(localAddr);
+#else
+        socklen_t addrLen = sizeof(localAddr);
+#endif
+        if (::getsockname(m_fd.get(), reinterpret_cast<sockaddr *>(&localAddr), &addrLen) != 0) {
+            throw SocketErrorException("getsockname() failed");
+        }
+
+        m_LocalAddr = SockAddr4::fromSockAddrStruct(localAddr);
+    } catch (...) {
+        close();
+        throw;
+    }
+}
+
+void appfw::UdpSocket4::close() {
+    m_fd.close();
+    m_LocalAddr = SockAddr4();
+}
+
+void appfw::UdpSocket4::setSocketOptions(const SocketOptions &opts) {
+    platsock::applySocketOptions(m_fd.get(), opts);
+}
+
+bool appfw::UdpSocket4::setGroEnabled([[maybe_unused]] bool enable) {
+#if APPFW_UDP_GSO
+    int value = enable;
+    return ::setsockopt(m_fd.get(), IPPROTO_UDP, UDP_GRO, &value, sizeof(value)) == 0;
+#else
+    return false;
+#endif
+}
+
+bool appfw::UdpSocket4::poll(int time) {
+    pollfd pfd = {m_fd.get(), POLLIN, 0};
+    int result = platsock::poll(&pfd, 1, time);
+
+    if (result < 0) {
+        throw SocketErrorException("poll() failed");
+    }
+
+    return result > 0;
+}
+
+bool appfw::UdpSocket4::sendTo(const SockAddr4 &addr, appfw::span<const uint8_t> data) {
+    sockaddr_in sa = addr.toSockAddrStruct();
+    int result = (int)::sendto(m_fd.get(), reinterpret_cast<const char *>(data.data()),
+                               (int)data.size(), 0, reinterpret_cast<sockaddr *>(&sa), sizeof(sa));
+
+    if (result < 0) {
+        int error = getLastError();
+
+        if (isWouldBlock(error)) {
+            return false;
+        }
+
+        throw SocketErrorException("sendto() failed", error);
+    }
+
+    return true;
+}
+
+bool appfw::UdpSocket4::receiveFrom(appfw::span<uint8_t> buf, size_t &size, SockAddr4 &addr) {
+    sockaddr_in sa = {};
+#if PLATFORM_WINDOWS
+    int addrLen = sizeof(sa);
+#else
+    socklen_t addrLen = sizeof(sa);
+#endif
+    int result = (int)::recvfrom(m_fd.get(), reinterpret_cast<char *>(buf.data()),
+                                 (int)buf.size(), 0, reinterpret_cast<sockaddr *>(&sa), &addrLen);
+
+    if (result < 0) {
+        int error = getLastError();
+
+        if (isWouldBlock(error)) {
+            return false;
+        } else if (isTruncated(error)) {
+            // Buffer is filled with the beginning of the datagram
+            result = (int)buf.size();
+        } else {
+            throw SocketErrorException("recvfrom() failed", error);
+        }
+    }
+
+    size = (size_t)result;
+    addr = SockAddr4::fromSockAddrStruct(sa);
+    return true;
+}
+
+bool appfw::UdpSocket4::sendSegments(const SockAddr4 &addr, appfw::span<const uint8_t> buf,
+                                     size_t segmentSize) {
+    // Once the first segment is sent, the message counts as sent and
+    // segments that would block are dropped like the network would.
+    if (!sendTo(addr, buf.first(segmentSize))) {
+        return false;
+    }
+
+    for (size_t pos = segmentSize; pos < buf.size(); pos += segmentSize) {
+        size_t segSize = std::min<size_t>(segmentSize, buf.size() - pos);
+
+        if (!sendTo(addr, buf.subspan(pos, segSize))) {
+            break;
+        }
+    }
+
+    return true;
+}
+
+#if PLATFORM_LINUX
+
+size_t appfw::UdpSocket4::sendBatch(UdpBatch4 &batch, size_t offset) {
+    AFW_ASSERT(offset <= batch.size());
+    UdpBatch4::Data &data = *batch.m_Data;
+
+    for (size_t i = offset; i < batch.size(); i++) {
+        const UdpMessage4 &msg = batch.m_Messages[i];
+        msghdr &hdr = data.m_Headers[i].msg_hdr;
+        data.m_Addrs[i] = msg.addr.toSockAddrStruct();
+        data.m_Iovecs[i].iov_len = msg.size;
+        hdr.msg_namelen = sizeof(sockaddr_in);
+        hdr.msg_controllen = 0;
+
+#if APPFW_UDP_GSO
+        if (msg.segmentSize != 0 && msg.size > msg.segmentSize && !needsSoftwareSplit(msg)) {
+            hdr.msg_controllen = CMSG_SPACE(sizeof(uint16_t));
+            cmsghdr *cm = CMSG_FIRSTHDR(&hdr);
+            cm->cmsg_level = IPPROTO_UDP;
+            cm->cmsg_type = UDP_SEGMENT;
+            cm->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+            std::memcpy(CMSG_DATA(cm), &msg.segmentSize, sizeof(uint16_t));
+        }
+#endif
+    }
+
+    size_t sent = offset;
+
+    while (sent < batch.size()) {
+        const UdpMessage4 &msg = batch.m_Messages[sent];
+
+        if (needsSoftwareSplit(msg)) {
+            if (!sendSegments(msg.addr, batch.getData(sent), msg.segmentSize)) {
+                break;
+            }
+
+            sent++;
+            continue;
+        }
+
+        // Send messages up to the next one that is split in software
+        size_t end = sent + 1;
+
+        while (end < batch.size() && !needsSoftwareSplit(batch.m_Messages[end])) {
+            end++;
+        }
+
+        int result = ::sendmmsg(m_fd.get(), data.m_Headers.data() + sent,
+                                (unsigned)(end - sent), 0);
+
+        if (result < 0) {
+            // Error is reported for the first message only
+            int error = getLastError();
+
+            if (isWouldBlock(error)) {
+                break;
+            }
+
+#if APPFW_UDP_GSO
+            if (data.m_Headers[sent].msg_hdr.msg_controllen != 0 && isGsoRejected(error)) {
+                // Kernel can't segment it, do it in software
+                if (!sendSegments(msg.addr, batch.getData(sent), msg.segmentSize)) {
+                    break;
+                }
+
+                sent++;
+                continue;
+            }
+#endif
+
+            throw SocketErrorException("sendmmsg() failed", error);
+        }
+
+        sent += (size_t)result;
+    }
+
+    return sent - offset;
+}
+
+size_t appfw::UdpSocket4::receiveBatch(UdpBatch4 &batch) {
+    UdpBatch4::Data &data = *batch.m_Data;
+    size_t count = batch.capacity();
+    batch.clear();
+
+    for (size_t i = 0; i < count; i++) {
+        msghdr &hdr = data.m_Headers[i].msg_hdr;
+        data.m_Iovecs[i].iov_len = batch.bufferSize();
+        hdr.msg_namelen = sizeof(sockaddr_in);
+        hdr.msg_controllen = UdpBatch4::Data::CONTROL_SIZE;
+        hdr.msg_flags = 0;
+    }
+
+    int result = ::recvmmsg(m_fd.get(), data.m_Headers.data(), (unsigned)count, 0, nullptr);
+
+    if (result < 0) {
+        int error = getLastError();
+
+        if (isWouldBlock(error)) {
+            return 0;
+        }
+
+        throw SocketErrorException("recvmmsg() failed", error);
+    }
+
+    for (size_t i = 0; i < (size_t)result; i++) {
+        UdpMessage4 &msg = batch.m_Messages[i];
+        msghdr &hdr = data.m_Headers[i].msg_hdr;
+        msg.addr = SockAddr4::fromSockAddrStruct(data.m_Addrs[i]);
+        msg.size = data.m_Headers[i].msg_len;
+        msg.segmentSize = 0;
+
+#if APPFW_UDP_GSO
+        for (cmsghdr *cm = CMSG_FIRSTHDR(&hdr); cm; cm = CMSG_NXTHDR(&hdr, cm)) {
+            if (cm->cmsg_level == IPPROTO_UDP && cm->cmsg_type == UDP_GRO) {
+                int segmentSize = 0;
+                std::memcpy(&segmentSize, CMSG_DATA(cm), sizeof(segmentSize));
+                msg.segmentSize = (uint16_t)segmentSize;
+            }
+        }
+#endif
+    }
+
+    batch.setSize((size_t)result);
+    return (size_t)result;
+}
+
+#else
+
+size_t appfw::UdpSocket4::sendBatch(UdpBatch4 &batch, size_t offset) {
+    AFW_ASSERT(offset <= batch.size());
+    size_t sent = offset;
+
+    for (; sent < batch.size(); sent++) {
+        const UdpMessage4 &msg = batch.m_Messages[sent];
+        appfw::span<const uint8_t> buf = batch.getData(sent);
+
+        if (!needsSoftwareSplit(msg)) {
+            if (!sendTo(msg.addr, buf)) {
+                break;
+            }
+        } else if (!sendSegments(msg.addr, buf, msg.segmentSize)) {
+            // No GSO, split in software
+            break;
+        }
+    }
+
+    return sent - offset;
+}
+
+size_t appfw::UdpSocket4::receiveBatch(UdpBatch4 &batch) {
+    batch.clear();
+
+    for (size_t i = 0; i < batch.capacity(); i++) {
+        UdpMessage4 &msg = batch.m_Messages[i];
+
+        if (!receiveFrom(batch.getBuffer(i), msg.size, msg.addr)) {
+            break;
+        }
+
+        msg.segmentSize = 0;
+        batch.m_uSize++;
+    }
+
+    return batch.size();
+}
+
+#endif
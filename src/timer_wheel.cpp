@@ -0,0 +1,268 @@
+#include <algorithm>
+#include <climits>
+#include <appfw/dbg.h>
+#include <appfw/timer_wheel.h>
+
+#if COMPILER_MSVC
+#include <intrin.h>
+#endif
+
+namespace {
+
+//! @returns the index of the highest set bit. x must not be 0.
+inline unsigned highestBit(uint64_t x) {
+#if COMPILER_MSVC
+    unsigned long idx;
+    _BitScanReverse64(&idx, x);
+    return (unsigned)idx;
+#else
+    return 63 - (unsigned)__builtin_clzll(x);
+#endif
+}
+
+//! @returns the index of the lowest set bit. x must not be 0.
+inline unsigned lowestBit(uint64_t x) {
+#if COMPILER_MSVC
+    unsigned long idx;
+    _BitScanForward64(&idx, x);
+    return (unsigned)idx;
+#else
+    return (unsigned)__builtin_ctzll(x);
+#endif
+}
+
+} // namespace
+
+appfw::TimerWheel::TimerWheel() {
+    m_StartTime = std::chrono::steady_clock::now();
+    std::fill(std::begin(m_Heads), std::end(m_Heads), NIL);
+    std::fill(std::begin(m_Tails), std::end(m_Tails), NIL);
+}
+
+uint64_t appfw::TimerWheel::getRealTime() const {
+    auto elapsed = std::chrono::steady_clock::now() - m_StartTime;
+    return (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+}
+
+appfw::TimerWheel::TimerId appfw::TimerWheel::add(int64_t delay, Callback cb) {
+    uint32_t idx;
+
+    if (m_uFreeHead != NIL) {
+        idx = m_uFreeHead;
+        m_uFreeHead = m_Entries[idx].next;
+    } else {
+        AFW_ASSERT(m_Entries.size() < NIL);
+        idx = (uint32_t)m_Entries.size();
+        m_Entries.emplace_back();
+    }
+
+    Entry &entry = m_Entries[idx];
+    entry.callback = std::move(cb);
+    entry.expiry = std::min(m_uTime + (uint64_t)std::max<int64_t>(delay, 1), MAX_TIME);
+    link(idx);
+    m_uActiveCount++;
+
+    return makeId(idx, entry.generation);
+}
+
+bool appfw::TimerWheel::cancel(TimerId id) {
+    uint32_t idx = findEntry(id);
+
+    if (idx == NIL) {
+        return false;
+    }
+
+    unlink(idx);
+
+    Entry &entry = m_Entries[idx];
+    entry.callback = nullptr;
+    entry.generation = entry.generation == UINT32_MAX ? 1 : entry.generation + 1;
+    entry.next = m_uFreeHead;
+    m_uFreeHead = idx;
+    m_uActiveCount--;
+    return true;
+}
+
+bool appfw::TimerWheel::reschedule(TimerId id, int64_t delay) {
+    uint32_t idx = findEntry(id);
+
+    if (idx == NIL) {
+        return false;
+    }
+
+    unlink(idx);
+    m_Entries[idx].expiry = std::min(m_uTime + (uint64_t)std::max<int64_t>(delay, 1), MAX_TIME);
+    link(idx);
+    return true;
+}
+
+bool appfw::TimerWheel::isActive(TimerId id) const {
+    return findEntry(id) != NIL;
+}
+
+void appfw::TimerWheel::advance(uint64_t time) {
+    time = std::min(time, MAX_TIME);
+
+    if (time <= m_uTime) {
+        return;
+    }
+
+    for (;;) {
+        uint64_t eventTime = getNextEventTime();
+
+        if (eventTime > time) {
+            break;
+        }
+
+        m_uTime = eventTime;
+
+        // Move timers from higher levels whose slot begins now
+        for (unsigned level = LEVELS - 1; level >= 1; level--) {
+            unsigned shift = level * SLOT_BITS;
+
+            if ((eventTime & ((1ull << shift) - 1)) == 0) {
+                cascade(level, (unsigned)(eventTime >> shift) & (SLOTS - 1));
+            }
+        }
+
+        fire((unsigned)eventTime & (SLOTS - 1));
+    }
+
+    m_uTime = time;
+}
+
+int appfw::TimerWheel::getTimeout(int maxTime) const {
+    uint64_t eventTime = getNextEventTime();
+
+    if (eventTime == NO_EVENT) {
+        return maxTime;
+    }
+
+    uint64_t timeout = eventTime - m_uTime;
+
+    if (maxTime >= 0 && timeout > (uint64_t)maxTime) {
+        return maxTime;
+    }
+
+    return (int)std::min<uint64_t>(timeout, INT_MAX);
+}
+
+uint32_t appfw::TimerWheel::findEntry(TimerId id) const {
+    uint32_t idx = (uint32_t)id;
+    uint32_t generation = (uint32_t)(id >> 32);
+
+    if (idx >= m_Entries.size()) {
+        return NIL;
+    }
+
+    const Entry &entry = m_Entries[idx];
+
+    if (entry.generation != generation || entry.slot == NIL) {
+        return NIL;
+    }
+
+    return idx;
+}
+
+void appfw::TimerWheel::link(uint32_t idx) {
+    Entry &entry = m_Entries[idx];
+
+    // Level is chosen by the highest bit that differs from the current time.
+    // All higher bits are equal so the slot is always ahead of the current one.
+    uint64_t diff = entry.expiry ^ m_uTime;
+    unsigned level = diff == 0 ? 0 : highestBit(diff) / SLOT_BITS;
+    AFW_ASSERT(level < LEVELS);
+    unsigned slotInLevel = (unsigned)(entry.expiry >> (level * SLOT_BITS)) & (SLOTS - 1);
+    uint32_t slot = level * SLOTS + slotInLevel;
+
+    entry.slot = slot;
+    entry.prev = m_Tails[slot];
+    entry.next = NIL;
+
+    if (entry.prev != NIL) {
+        m_Entries[entry.prev].next = idx;
+    } else {
+        m_Heads[slot] = idx;
+    }
+
+    m_Tails[slot] = idx;
+    m_Occupied[level] |= 1ull << slotInLevel;
+}
+
+void appfw::TimerWheel::unlink(uint32_t idx) {
+    Entry &entry = m_Entries[idx];
+    AFW_ASSERT(entry.slot != NIL);
+
+    if (entry.prev != NIL) {
+        m_Entries[entry.prev].next = entry.next;
+    } else {
+        m_Heads[entry.slot] = entry.next;
+    }
+
+    if (entry.next != NIL) {
+        m_Entries[entry.next].prev = entry.prev;
+    } else {
+        m_Tails[entry.slot] = entry.prev;
+    }
+
+    if (m_Heads[entry.slot] == NIL) {
+        m_Occupied[entry.slot / SLOTS] &= ~(1ull << (entry.slot % SLOTS));
+    }
+
+    entry.prev = NIL;
+    entry.next = NIL;
+    entry.slot = NIL;
+}
+
+void appfw::TimerWheel::cascade(unsigned level, unsigned slot) {
+    uint32_t globalSlot = level * SLOTS + slot;
+
+    // Entries always move to a lower level
+    while (m_Heads[globalSlot] != NIL) {
+        uint32_t idx = m_Heads[globalSlot];
+        unlink(idx);
+        link(idx);
+    }
+}
+
+void appfw::TimerWheel::fire(unsigned slot) {
+    // New timers always expire later so they never get into this slot
+    while (m_Heads[slot] != NIL) {
+        uint32_t idx = m_Heads[slot];
+        AFW_ASSERT(m_Entries[idx].expiry == m_uTime);
+
+        Callback cb = std::move(m_Entries[idx].callback);
+        cancel(makeId(idx, m_Entries[idx].generation));
+        cb();
+    }
+}
+
+uint64_t appfw::TimerWheel::getNextEventTime() const {
+    uint64_t result = NO_EVENT;
+
+    for (unsigned level = 0; level < LEVELS; level++) {
+        if (!m_Occupied[level]) {
+            continue;
+        }
+
+        // Slots up to the current one are always empty
+        unsigned shift = level * SLOT_BITS;
+        unsigned curSlot = (unsigned)(m_uTime >> shift) & (SLOTS - 1);
+        uint64_t mask = curSlot == SLOTS - 1 ? 0 : m_Occupied[level] & (~0ull << (curSlot + 1));
+
+        if (level == 0 && (m_Occupied[0] & (1ull << curSlot))) {
+            // Cascaded timers that expire right now
+            return m_uTime;
+        }
+
+        if (!mask) {
+            continue;
+        }
+
+        uint64_t blockStart = (m_uTime >> (shift + SLOT_BITS)) << (shift + SLOT_BITS);
+        uint64_t eventTime = blockStart + ((uint64_t)lowestBit(mask) << shift);
+        result = std::min(result, eventTime);
+    }
+
+    return result;
+}
@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include <appfw/console/binary_log.h>
+#include <doctest/doctest.h>
+
+static std::vector<std::string> readTexts(const fs::path &path) {
+    appfw::BinaryLogReader reader(path);
+    appfw::BinaryLogReader::Record record;
+    std::vector<std::string> texts;
+
+    while (reader.readRecord(record)) {
+        texts.emplace_back(record.text);
+    }
+
+    return texts;
+}
+
+TEST_CASE("appfw::BinaryLogSink") {
+    fs::path workdir = fs::temp_directory_path() / "appfw_binary_log_test";
+    fs::remove_all(workdir);
+    fs::create_directories(workdir);
+
+    appfw::FileSystem filesystem;
+    filesystem.addSearchPath(workdir, "logs");
+
+    appfw::BinaryLogSink::Options options;
+    options.dir = "logs:sub";
+    options.prefix = "test";
+
+    SUBCASE("Write and read") {
+        fs::path path;
+
+        {
+            appfw::BinaryLogSink sink(filesystem, options);
+            path = sink.getSegmentPath();
+            CHECK(path.parent_path() == workdir / "sub");
+            CHECK(fs::file_size(path) == options.segmentSize);
+
+            appfw::ConMsgInfo info;
+            info.setType(appfw::ConMsgType::Warn).setColor(appfw::ConMsgColor::Red).setTag("tag");
+            info.time = 1234;
+            sink.print(info, "first");
+            sink.print(appfw::ConMsgInfo().setTag("other"), "");
+        }
+
+        // Truncated on close
+        CHECK(fs::file_size(path) == sizeof(appfw::BinaryLogFileHeader) +
+                                         2 * sizeof(appfw::BinaryLogRecordHeader) + 3 + 5 + 5);
+
+        appfw::BinaryLogReader reader(path);
+        CHECK(reader.getHeader().uSegmentIdx == 0);
+
+        appfw::BinaryLogReader::Record record;
+        REQUIRE(reader.readRecord(record));
+        CHECK(record.type == appfw::ConMsgType::Warn);
+        CHECK(record.color == appfw::ConMsgColor::Red);
+        CHECK(record.time == 1234);
+        CHECK(record.tag == "tag");
+        CHECK(record.text == "first");
+
+        REQUIRE(reader.readRecord(record));
+        CHECK(record.tag == "other");
+        CHECK(record.text == "");
+        CHECK(!reader.readRecord(record));
+    }
+
+    SUBCASE("Rotation") {
+        options.segmentSize = 1024;
+        options.maxSegments = 3;
+        std::vector<std::string> expected;
+
+        {
+            appfw::BinaryLogSink sink(filesystem, options);
+
+            for (int i = 0; i < 200; i++) {
+                std::string text = "message " + std::to_string(i);
+                sink.print(appfw::ConMsgInfo(), text);
+                expected.push_back(text);
+            }
+
+            // Messages larger than a segment are truncated
+            sink.print(appfw::ConMsgInfo(), std::string(2000, 'a'));
+            CHECK(sink.isOpen());
+        }
+
+        std::set<std::string> files = filesystem.getFileList("logs:sub");
+        REQUIRE(files.size() == 3);
+
+        // Last segments contain the last messages in order
+        std::vector<std::string> texts;
+
+        for (const std::string &name : files) {
+            std::vector<std::string> segmentTexts = readTexts(workdir / "sub" / name);
+            texts.insert(texts.end(), segmentTexts.begin(), segmentTexts.end());
+        }
+
+        REQUIRE(texts.size() > 1);
+        CHECK(texts.back().size() < 1024);
+        texts.pop_back();
+        CHECK(std::equal(texts.rbegin(), texts.rend(), expected.rbegin()));
+    }
+
+    SUBCASE("Tiny segment") {
+        // Room for 4 bytes of tag and text
+        options.segmentSize = sizeof(appfw::BinaryLogFileHeader) + sizeof(appfw::BinaryLogRecordHeader) + 4;
+        std::string longTag(100, 't');
+
+        {
+            appfw::BinaryLogSink sink(filesystem, options);
+            sink.print(appfw::ConMsgInfo().setTag(longTag.c_str()), "text");
+            sink.print(appfw::ConMsgInfo().setTag("ab"), "text");
+            CHECK(sink.isOpen());
+        }
+
+        std::set<std::string> files = filesystem.getFileList("logs:sub");
+        std::vector<std::pair<std::string, std::string>> records;
+
+        for (const std::string &name : files) {
+            appfw::BinaryLogReader reader(workdir / "sub" / name);
+            appfw::BinaryLogReader::Record record;
+
+            while (reader.readRecord(record)) {
+                records.emplace_back(record.tag, record.text);
+            }
+        }
+
+        // Tag is truncated before the text
+        REQUIRE(records.size() == 2);
+        CHECK(records[0].first == "tttt");
+        CHECK(records[0].second == "");
+        CHECK(records[1].first == "ab");
+        CHECK(records[1].second == "te");
+    }
+
+    SUBCASE("Invalid file") {
+        CHECK_THROWS(appfw::BinaryLogReader(workdir / "not_found.blog"));
+    }
+
+    fs::remove_all(workdir);
+}
@@ -43,3 +43,47 @@ TEST_CASE("appfw::CmdString::parseString") {
         }
     }
 }
+
+TEST_CASE("appfw::CmdString arguments") {
+    using appfw::CmdString;
+
+    SUBCASE("Quoted arguments") {
+        auto parsed = CmdString::parse("set \"a b; c\" d;x");
+        REQUIRE(parsed.size() == 2);
+        CHECK(parsed[0].getArgs() == std::vector<std::string>{"set", "a b; c", "d"});
+        CHECK(parsed[1][0] == "x");
+    }
+
+    SUBCASE("More arguments than stored inline") {
+        std::string str;
+        std::vector<std::string> expected;
+
+        for (size_t i = 0; i < CmdString::INLINE_ARG_COUNT * 3; i++) {
+            expected.push_back("arg" + std::to_string(i));
+            str += expected.back() + " ";
+        }
+
+        auto parsed = CmdString::parse(str);
+        REQUIRE(parsed.size() == 1);
+        REQUIRE(parsed[0].size() == expected.size());
+        CHECK(parsed[0].getArgs() == expected);
+        CHECK(parsed[0][expected.size() - 1] == expected.back());
+
+        std::vector<std::string> iterated(parsed[0].begin(), parsed[0].end());
+        CHECK(iterated == expected);
+    }
+
+    SUBCASE("Callback reuses the command") {
+        std::vector<std::string> names;
+        CmdString::parse("a 1; b 2; c", [&](CmdString &cmd) { names.emplace_back(cmd[0]); });
+        CHECK(names == std::vector<std::string>{"a", "b", "c"});
+    }
+
+    SUBCASE("Construction and copy") {
+        CmdString cmd = {"echo", "hello world"};
+        CmdString copy = cmd;
+        cmd.clear();
+        CHECK(cmd.empty());
+        CHECK(copy.toString() == "\"echo\" \"hello world\"");
+    }
+}
@@ -0,0 +1,46 @@
+#include <cstdint>
+#include <string>
+#include <appfw/console/con_deferred_msg.h>
+#include <doctest/doctest.h>
+
+TEST_CASE("appfw::ConDeferredMsg") {
+    SUBCASE("Capturable types") {
+        CHECK(appfw::ConDeferredMsg::canCapture<>());
+        CHECK(appfw::ConDeferredMsg::canCapture<int, double, char, bool, uint64_t>());
+        CHECK(!appfw::ConDeferredMsg::canCapture<const char *>());
+        CHECK(!appfw::ConDeferredMsg::canCapture<int, std::string>());
+    }
+
+    SUBCASE("Format") {
+        appfw::ConDeferredMsg msg;
+        CHECK(msg.isEmpty());
+
+        std::string format = "{} {} {} {:.2f} {}";
+        REQUIRE(msg.capture(format, (uint8_t)1, (int64_t)-2, 'c', 3.14159, true));
+        format = "overwritten";
+        CHECK(!msg.isEmpty());
+
+        appfw::ConDeferredMsg copy;
+        copy = msg;
+        CHECK(copy.format() == "1 -2 c 3.14 true");
+    }
+
+    SUBCASE("No arguments") {
+        appfw::ConDeferredMsg msg;
+        REQUIRE(msg.capture("Hello {{}}"));
+        CHECK(msg.format() == "Hello {}");
+    }
+
+    SUBCASE("Too large") {
+        appfw::ConDeferredMsg msg;
+        std::string format(appfw::ConDeferredMsg::MAX_DATA_SIZE, 'a');
+        CHECK(!msg.capture(format, 1));
+        CHECK(msg.isEmpty());
+    }
+
+    SUBCASE("Invalid format") {
+        appfw::ConDeferredMsg msg;
+        REQUIRE(msg.capture("{} {}", 1));
+        CHECK_THROWS(msg.format());
+    }
+}
@@ -0,0 +1,113 @@
+#include <atomic>
+#include <string>
+#include <thread>
+#include <appfw/console/con_item.h>
+#include <doctest/doctest.h>
+
+TEST_CASE("appfw::ConVar") {
+    SUBCASE("Relaxed value") {
+        appfw::ConVar<int> cvar("test_relaxed_int", 1, "");
+        CHECK(cvar.getValueRelaxed() == 1);
+
+        cvar.setValue(2);
+        CHECK(cvar.getValue() == 2);
+        CHECK(cvar.getValueRelaxed() == 2);
+
+        // Rejected value is not published
+        cvar.setCallback([](const int &, const int &newVal) { return newVal >= 0; });
+        CHECK(cvar.setValue(-1) == appfw::VarSetResult::CallbackRejected);
+        CHECK(cvar.getValueRelaxed() == 2);
+
+        CHECK(cvar.setStringValue("5") == appfw::VarSetResult::Success);
+        CHECK(cvar.getValueRelaxed() == 5);
+    }
+
+    SUBCASE("Relaxed string value") {
+        appfw::ConVar<std::string> cvar("test_relaxed_str", "first", "");
+        auto pOld = cvar.getValueRelaxed();
+        CHECK(*pOld == "first");
+
+        cvar.setValue("second");
+        CHECK(*cvar.getValueRelaxed() == "second");
+
+        // Old copy stays valid while it's referenced
+        CHECK(*pOld == "first");
+    }
+
+    SUBCASE("Reads from other threads") {
+        appfw::ConVar<std::string> strCvar("test_relaxed_thread_str", "0", "");
+        appfw::ConVar<double> dblCvar("test_relaxed_thread_dbl", 0, "");
+        std::atomic_bool isRunning = true;
+        std::atomic_bool isValid = true;
+
+        std::thread reader([&]() {
+            while (isRunning) {
+                auto pStr = strCvar.getValueRelaxed();
+                double value = dblCvar.getValueRelaxed();
+
+                if (pStr->size() != (size_t)(pStr->front() - '0' + 1) || value < 0 || value > 9) {
+                    isValid = false;
+                }
+            }
+        });
+
+        for (int i = 0; i < 10000; i++) {
+            int n = i % 10;
+            strCvar.setValue(std::string(n + 1, (char)('0' + n)));
+            dblCvar.setValue(n);
+        }
+
+        isRunning = false;
+        reader.join();
+        CHECK(isValid);
+        CHECK(*strCvar.getValueRelaxed() == "9999999999");
+    }
+
+    SUBCASE("Change subscriptions") {
+        appfw::ConVar<int> cvar("test_sub_int", 0, "");
+        int callCount1 = 0;
+        int callCount2 = 0;
+        int lastValue = -1;
+
+        uint64_t id1 = cvar.subscribe([&](appfw::ConVarBase &changed) {
+            CHECK(&changed == &cvar);
+            lastValue = cvar.getValue();
+            callCount1++;
+        });
+
+        cvar.subscribe([&](appfw::ConVarBase &) { callCount2++; });
+
+        // Changes are coalesced until the next notification
+        for (int i = 1; i <= 100; i++) {
+            cvar.setValue(i);
+        }
+
+        CHECK(callCount1 == 0);
+        appfw::ConVarBase::notifySubscribers();
+        CHECK(callCount1 == 1);
+        CHECK(callCount2 == 1);
+        CHECK(lastValue == 100);
+
+        // Nothing changed
+        appfw::ConVarBase::notifySubscribers();
+        cvar.setValue(100);
+        appfw::ConVarBase::notifySubscribers();
+        CHECK(callCount1 == 1);
+
+        cvar.unsubscribe(id1);
+        cvar.setValue(5);
+        appfw::ConVarBase::notifySubscribers();
+        CHECK(callCount1 == 1);
+        CHECK(callCount2 == 2);
+
+        // Changed cvar is destroyed before the notification
+        {
+            appfw::ConVar<std::string> tempCvar("test_sub_temp", "", "");
+            tempCvar.subscribe([&](appfw::ConVarBase &) { callCount2++; });
+            tempCvar.setValue("changed");
+        }
+
+        appfw::ConVarBase::notifySubscribers();
+        CHECK(callCount2 == 2);
+    }
+}
@@ -0,0 +1,85 @@
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include <appfw/console/con_item_index.h>
+#include <doctest/doctest.h>
+
+namespace {
+
+class TestItem : public appfw::ConItemBase {
+public:
+    TestItem(std::string_view name)
+        : ConItemBase(name, "") {}
+
+    appfw::ConItemType getType() override { return appfw::ConItemType::ConCommand; }
+};
+
+} // namespace
+
+TEST_CASE("appfw::ConItemIndex") {
+    appfw::ConItemIndex index;
+
+    SUBCASE("Insert and find") {
+        TestItem a("a"), b("b"), b2("b");
+        CHECK(index.insert(&b));
+        CHECK(index.insert(&a));
+        CHECK(!index.insert(&b2));
+        CHECK(index.size() == 2);
+
+        CHECK(index.find("a") == &a);
+        CHECK(index.find("b") == &b);
+        CHECK(index.find("c") == nullptr);
+        CHECK(index.find("") == nullptr);
+
+        CHECK(index.getSortedItems() == std::vector<appfw::ConItemBase *>{&a, &b});
+
+        CHECK(!index.erase(&b2));
+        CHECK(index.erase(&b));
+        CHECK(!index.erase(&b));
+        CHECK(index.find("b") == nullptr);
+        CHECK(index.find("a") == &a);
+        CHECK(index.size() == 1);
+    }
+
+    SUBCASE("Many items") {
+        constexpr int ITEM_COUNT = 5000;
+        std::vector<std::string> names;
+        std::vector<std::unique_ptr<TestItem>> items;
+
+        for (int i = 0; i < ITEM_COUNT; i++) {
+            names.push_back("item_" + std::to_string(i));
+        }
+
+        for (int i = 0; i < ITEM_COUNT; i++) {
+            items.push_back(std::make_unique<TestItem>(names[i]));
+            REQUIRE(index.insert(items[i].get()));
+        }
+
+        // Erase every third item to exercise backward-shift deletion
+        for (int i = 0; i < ITEM_COUNT; i += 3) {
+            REQUIRE(index.erase(items[i].get()));
+        }
+
+        bool isFound = true;
+
+        for (int i = 0; i < ITEM_COUNT; i++) {
+            appfw::ConItemBase *pExpected = i % 3 == 0 ? nullptr : items[i].get();
+            isFound = isFound && index.find(names[i]) == pExpected;
+        }
+
+        CHECK(isFound);
+
+        auto &sorted = index.getSortedItems();
+        CHECK(sorted.size() == ITEM_COUNT - (ITEM_COUNT + 2) / 3);
+        CHECK(std::is_sorted(sorted.begin(), sorted.end(), [](auto *pLhs, auto *pRhs) {
+            return pLhs->getName() < pRhs->getName();
+        }));
+
+        for (auto &pItem : items) {
+            index.erase(pItem.get());
+        }
+
+        CHECK(index.size() == 0);
+    }
+}
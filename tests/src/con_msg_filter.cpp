@@ -0,0 +1,68 @@
+#include <appfw/console/con_msg_filter.h>
+#include <doctest/doctest.h>
+
+TEST_CASE("appfw::ConMsgFilter") {
+    using appfw::ConMsgType;
+    appfw::ConMsgFilter filter("test", "test_con_min_level");
+    ConMsgType oldLevel = appfw::ConMsgFilter::getGlobalLevel();
+
+    SUBCASE("Global level") {
+        appfw::ConMsgFilter::setGlobalLevel(ConMsgType::Debug);
+        CHECK(filter.isEnabled(ConMsgType::WTF));
+        CHECK(filter.isEnabled(ConMsgType::Debug));
+
+        appfw::ConMsgFilter::setGlobalLevel(ConMsgType::Warn);
+        CHECK(filter.isEnabled(ConMsgType::Error));
+        CHECK(filter.isEnabled(ConMsgType::Warn));
+        CHECK(!filter.isEnabled(ConMsgType::Notice));
+        CHECK(!filter.isEnabled(ConMsgType::Debug));
+        CHECK(filter.isEnabled(ConMsgType::Input));
+
+        appfw::ConMsgFilter::setGlobalLevel(ConMsgType::WTF);
+        CHECK(filter.isEnabled(ConMsgType::WTF));
+        CHECK(!filter.isEnabled(ConMsgType::Fatal));
+    }
+
+    SUBCASE("Module level") {
+        appfw::ConVar<int> &cvar = filter.getLevelCvar();
+        CHECK(cvar.getName() == "test_con_min_level");
+        CHECK(cvar.getValue() == -1);
+
+        // Overrides the global level both ways
+        appfw::ConMsgFilter::setGlobalLevel(ConMsgType::Warn);
+        REQUIRE(cvar.setStringValue("6") == appfw::VarSetResult::Success);
+        CHECK(filter.isEnabled(ConMsgType::Debug));
+
+        appfw::ConMsgFilter::setGlobalLevel(ConMsgType::Debug);
+        REQUIRE(cvar.setStringValue("2") == appfw::VarSetResult::Success);
+        CHECK(filter.isEnabled(ConMsgType::Error));
+        CHECK(!filter.isEnabled(ConMsgType::Warn));
+        CHECK(filter.isEnabled(ConMsgType::Input));
+
+        // Changes of the global level don't affect it
+        appfw::ConMsgFilter::setGlobalLevel(ConMsgType::Info);
+        CHECK(!filter.isEnabled(ConMsgType::Warn));
+
+        // Out of range values are rejected
+        CHECK(cvar.setStringValue("7") == appfw::VarSetResult::CallbackRejected);
+        CHECK(cvar.setStringValue("-2") == appfw::VarSetResult::CallbackRejected);
+        CHECK(cvar.getValue() == 2);
+        CHECK(!filter.isEnabled(ConMsgType::Warn));
+
+        // -1 falls back to the global level
+        REQUIRE(cvar.setStringValue("-1") == appfw::VarSetResult::Success);
+        CHECK(filter.isEnabled(ConMsgType::Info));
+        CHECK(!filter.isEnabled(ConMsgType::Debug));
+
+        appfw::ConMsgFilter::setGlobalLevel(ConMsgType::Debug);
+        CHECK(filter.isEnabled(ConMsgType::Debug));
+    }
+
+    SUBCASE("Compile-time floor") {
+        CHECK(appfw::isConMsgTypeCompiled(ConMsgType::WTF));
+        CHECK(appfw::isConMsgTypeCompiled(appfw::CON_MIN_LEVEL));
+        CHECK(appfw::isConMsgTypeCompiled(ConMsgType::Input));
+    }
+
+    appfw::ConMsgFilter::setGlobalLevel(oldLevel);
+}
@@ -0,0 +1,90 @@
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+#include <appfw/console/con_msg_history.h>
+#include <doctest/doctest.h>
+
+static std::vector<std::string> getMessages(appfw::ConMsgHistory &history, uint64_t idx = 0) {
+    std::vector<std::string> list;
+    history.forEach(idx, [&](uint64_t, const appfw::ConMsgInfo &, std::string_view msg) {
+        list.emplace_back(msg);
+        return true;
+    });
+    return list;
+}
+
+TEST_CASE("appfw::ConMsgHistory") {
+    SUBCASE("Size") {
+        CHECK_THROWS_AS(appfw::ConMsgHistory(appfw::ConMsgHistory::MIN_SIZE - 1),
+                        std::invalid_argument);
+        appfw::ConMsgHistory history(appfw::ConMsgHistory::MIN_SIZE);
+        CHECK(history.getSize() == appfw::ConMsgHistory::MIN_SIZE);
+    }
+
+    SUBCASE("Push and read") {
+        appfw::ConMsgHistory history;
+        appfw::ConMsgInfo info;
+        info.setType(appfw::ConMsgType::Warn).setTag("tag");
+
+        std::string_view saved = history.push(info, "first");
+        CHECK(saved == "first");
+        history.push(appfw::ConMsgInfo(), "");
+        history.push(appfw::ConMsgInfo(), "third");
+
+        CHECK(history.getCount() == 3);
+        CHECK(history.getFirstIndex() == 0);
+        CHECK(history.getNextIndex() == 3);
+        CHECK(getMessages(history) == std::vector<std::string>{"first", "", "third"});
+        CHECK(getMessages(history, 2) == std::vector<std::string>{"third"});
+        CHECK(getMessages(history, 3).empty());
+
+        history.forEach(0, [&](uint64_t idx, const appfw::ConMsgInfo &msgInfo, std::string_view) {
+            CHECK(idx == 0);
+            CHECK(msgInfo.type == appfw::ConMsgType::Warn);
+            CHECK(std::string_view(msgInfo.tag) == "tag");
+            return false;
+        });
+
+        history.clear();
+        CHECK(history.getCount() == 0);
+        CHECK(history.getFirstIndex() == 3);
+        CHECK(getMessages(history).empty());
+    }
+
+    SUBCASE("Truncation") {
+        appfw::ConMsgHistory history(appfw::ConMsgHistory::MIN_SIZE);
+        std::string big(2 * appfw::ConMsgHistory::MIN_SIZE, 'a');
+        std::string_view saved = history.push(appfw::ConMsgInfo(), big);
+        CHECK(!saved.empty());
+        CHECK(saved.size() < appfw::ConMsgHistory::MIN_SIZE);
+        CHECK(history.getCount() == 1);
+
+        history.push(appfw::ConMsgInfo(), "small");
+        CHECK(getMessages(history) == std::vector<std::string>{"small"});
+    }
+
+    SUBCASE("Wrapping") {
+        appfw::ConMsgHistory history(appfw::ConMsgHistory::MIN_SIZE + 13);
+        std::deque<std::string> expected;
+        std::mt19937 rnd(1234);
+        size_t maxLength = 300;
+
+        for (int i = 0; i < 5000; i++) {
+            std::string msg(rnd() % maxLength, (char)('a' + i % 26));
+            msg += std::to_string(i);
+            history.push(appfw::ConMsgInfo(), msg);
+            expected.push_back(msg);
+
+            // Oldest messages are removed
+            while (expected.size() > history.getCount()) {
+                expected.pop_front();
+            }
+
+            REQUIRE(history.getNextIndex() == (uint64_t)i + 1);
+            REQUIRE(history.getFirstIndex() == i + 1 - expected.size());
+            REQUIRE(getMessages(history) ==
+                    std::vector<std::string>(expected.begin(), expected.end()));
+        }
+    }
+}
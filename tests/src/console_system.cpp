@@ -0,0 +1,160 @@
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <appfw/console/console_system.h>
+#include <doctest/doctest.h>
+
+namespace {
+
+class TestReceiver : public appfw::IConsoleReceiver {
+public:
+    explicit TestReceiver(bool threadSafe)
+        : m_bThreadSafe(threadSafe) {}
+
+    void onAdd(appfw::ConsoleSystem *) override {}
+    void onRemove(appfw::ConsoleSystem *) override {}
+
+    void print(const appfw::ConMsgInfo &, std::string_view msg) override {
+        std::lock_guard lock(m_Mutex);
+        m_Msgs.emplace_back(msg);
+    }
+
+    bool isThreadSafe() override { return m_bThreadSafe; }
+
+    std::vector<std::string> getMsgs() {
+        std::lock_guard lock(m_Mutex);
+        return m_Msgs;
+    }
+
+private:
+    bool m_bThreadSafe;
+    std::mutex m_Mutex;
+    std::vector<std::string> m_Msgs;
+};
+
+//! Prints "<producer> <idx>" messages from another thread
+void printFromThread(appfw::ConsoleSystem &conSys, int producer, int count) {
+    std::thread thread([&]() {
+        for (int i = 0; i < count; i++) {
+            conSys.print(appfw::ConMsgInfo(), std::to_string(producer) + " " + std::to_string(i));
+        }
+    });
+
+    thread.join();
+}
+
+//! Checks that messages of each producer are in order and returns the count per producer
+std::vector<int> checkOrder(const std::vector<std::string> &msgs, int producerCount) {
+    std::vector<int> next(producerCount, 0);
+
+    for (const std::string &msg : msgs) {
+        size_t space = msg.find(' ');
+        REQUIRE(space != std::string::npos);
+        int producer = std::stoi(msg.substr(0, space));
+        int idx = std::stoi(msg.substr(space + 1));
+        REQUIRE(producer < producerCount);
+        CHECK(idx == next[producer]);
+        next[producer] = idx + 1;
+    }
+
+    return next;
+}
+
+} // namespace
+
+TEST_CASE("appfw::ConsoleSystem message queue") {
+    constexpr size_t QUEUE_SIZE = 4;
+
+    SUBCASE("Drop policy") {
+        appfw::ConsoleSystem conSys(QUEUE_SIZE);
+        TestReceiver recv(false);
+        conSys.addConsoleReceiver(&recv);
+        conSys.setQueueFullPolicy(appfw::ConQueueFullPolicy::Drop);
+
+        printFromThread(conSys, 0, 10);
+        CHECK(recv.getMsgs().empty());
+        CHECK(conSys.getDroppedMsgCount() == 10 - QUEUE_SIZE);
+
+        // First messages are kept
+        conSys.processMsgQueue();
+        CHECK(recv.getMsgs() == std::vector<std::string>{"0 0", "0 1", "0 2", "0 3"});
+        conSys.removeConsoleReceiver(&recv);
+    }
+
+    SUBCASE("Block policy, thread-safe output") {
+        appfw::ConsoleSystem conSys(QUEUE_SIZE);
+        TestReceiver recv(true);
+        conSys.addConsoleReceiver(&recv);
+
+        // Producer drains the queue itself
+        printFromThread(conSys, 0, 100);
+        conSys.processMsgQueue();
+        CHECK(recv.getMsgs().size() == 100);
+        CHECK(checkOrder(recv.getMsgs(), 1)[0] == 100);
+        CHECK(conSys.getDroppedMsgCount() == 0);
+        conSys.removeConsoleReceiver(&recv);
+    }
+
+    SUBCASE("Block policy, main thread is stalled") {
+        appfw::ConsoleSystem conSys(QUEUE_SIZE);
+        TestReceiver recv(false);
+        conSys.addConsoleReceiver(&recv);
+
+        // Producer gives up after MAX_QUEUE_BLOCK_TIME for each message
+        auto start = std::chrono::steady_clock::now();
+        printFromThread(conSys, 0, QUEUE_SIZE + 2);
+        CHECK(std::chrono::steady_clock::now() - start >= 2 * appfw::ConsoleSystem::MAX_QUEUE_BLOCK_TIME);
+        CHECK(conSys.getDroppedMsgCount() == 2);
+
+        conSys.processMsgQueue();
+        CHECK(recv.getMsgs().size() == QUEUE_SIZE);
+        conSys.removeConsoleReceiver(&recv);
+    }
+
+    SUBCASE("Sink thread") {
+        constexpr int PRODUCER_COUNT = 4;
+        constexpr int MSG_COUNT = 1000;
+
+        appfw::ConsoleSystem conSys(QUEUE_SIZE);
+        TestReceiver unsafeRecv(false);
+        conSys.addConsoleReceiver(&unsafeRecv);
+        CHECK_THROWS_AS(conSys.startSinkThread(), std::logic_error);
+        conSys.removeConsoleReceiver(&unsafeRecv);
+
+        TestReceiver recv(true);
+        conSys.addConsoleReceiver(&recv);
+        conSys.startSinkThread();
+        REQUIRE(conSys.isSinkThreadRunning());
+
+        // Main thread goes through the queue too
+        conSys.print(appfw::ConMsgInfo(), std::string_view("main"));
+
+        std::vector<std::thread> threads;
+
+        for (int i = 0; i < PRODUCER_COUNT; i++) {
+            threads.emplace_back([&conSys, i]() {
+                for (int j = 0; j < MSG_COUNT; j++) {
+                    conSys.print(appfw::ConMsgInfo(), std::to_string(i) + " " + std::to_string(j));
+                }
+            });
+        }
+
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+
+        conSys.stopSinkThread();
+        CHECK(!conSys.isSinkThreadRunning());
+
+        std::vector<std::string> msgs = recv.getMsgs();
+        REQUIRE(msgs.size() == PRODUCER_COUNT * MSG_COUNT + 1);
+        CHECK(msgs[0] == "main");
+        msgs.erase(msgs.begin());
+
+        // Each producer's messages keep their order
+        CHECK(checkOrder(msgs, PRODUCER_COUNT) == std::vector<int>(PRODUCER_COUNT, MSG_COUNT));
+        CHECK(conSys.getDroppedMsgCount() == 0);
+        conSys.removeConsoleReceiver(&recv);
+    }
+}
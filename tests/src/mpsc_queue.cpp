@@ -0,0 +1,82 @@
+#include <string>
+#include <thread>
+#include <vector>
+#include <appfw/mpsc_queue.h>
+#include <doctest/doctest.h>
+
+TEST_CASE("appfw::MPSCQueue") {
+    SUBCASE("Capacity") {
+        appfw::MPSCQueue<int> queue(5);
+        CHECK(queue.capacity() == 8);
+
+        for (int i = 0; i < 8; i++) {
+            int item = i;
+            CHECK(queue.tryPush(std::move(item)));
+        }
+
+        int item = 8;
+        CHECK(!queue.tryPush(std::move(item)));
+        CHECK(queue.sizeApprox() == 8);
+
+        for (int i = 0; i < 8; i++) {
+            REQUIRE(queue.tryPop(item));
+            CHECK(item == i);
+        }
+
+        CHECK(!queue.tryPop(item));
+        CHECK(queue.sizeApprox() == 0);
+    }
+
+    SUBCASE("Failed push leaves the item") {
+        appfw::MPSCQueue<std::string> queue(2);
+        std::string a = "a", b = "b", c = "c";
+        CHECK(queue.tryPush(std::move(a)));
+        CHECK(queue.tryPush(std::move(b)));
+        CHECK(!queue.tryPush(std::move(c)));
+        CHECK(c == "c");
+    }
+
+    SUBCASE("Multiple producers") {
+        constexpr int THREAD_COUNT = 4;
+        constexpr int ITEM_COUNT = 100'000;
+
+        appfw::MPSCQueue<std::pair<int, int>> queue(64);
+        std::vector<std::thread> threads;
+
+        for (int t = 0; t < THREAD_COUNT; t++) {
+            threads.emplace_back([&queue, t]() {
+                for (int i = 0; i < ITEM_COUNT; i++) {
+                    std::pair<int, int> item(t, i);
+
+                    while (!queue.tryPush(std::move(item))) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        // Items of each producer arrive in order
+        std::vector<int> next(THREAD_COUNT, 0);
+        int received = 0;
+        bool isOrdered = true;
+
+        while (received != THREAD_COUNT * ITEM_COUNT) {
+            std::pair<int, int> item;
+
+            if (queue.tryPop(item)) {
+                isOrdered = isOrdered && item.second == next[item.first];
+                next[item.first]++;
+                received++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+
+        CHECK(isOrdered);
+        CHECK(queue.sizeApprox() == 0);
+    }
+}
@@ -0,0 +1,128 @@
+#include <cstring>
+#include <appfw/network/datagram_parser.h>
+#include <doctest/doctest.h>
+
+namespace {
+
+constexpr char MAGIC[] = "TEST";
+constexpr uint16_t MAGIC_SIZE = 4;
+
+void appendPacket(std::vector<uint8_t> &buf, std::string_view payload) {
+    uint32_t size = appfw::littleEndianSwap((uint32_t)payload.size());
+    buf.insert(buf.end(), MAGIC, MAGIC + MAGIC_SIZE);
+    buf.insert(buf.end(), (uint8_t *)&size, (uint8_t *)&size + sizeof(size));
+    buf.insert(buf.end(), payload.begin(), payload.end());
+}
+
+struct ParserTest {
+    appfw::DatagramParser parser;
+    std::vector<std::string> payloads;
+    std::vector<const uint8_t *> payloadPtrs;
+
+    ParserTest() {
+        parser.setMagic(MAGIC, MAGIC_SIZE);
+        parser.setMaxPayloadSize(64);
+        parser.reset();
+        parser.setPayloadCallback([this](appfw::BinaryInputStream &, const uint8_t *payload,
+                                         size_t size) {
+            payloads.emplace_back((const char *)payload, size);
+            payloadPtrs.push_back(payload);
+        });
+    }
+
+    bool parse(const uint8_t *data, size_t size) {
+        uint32_t bytesRead = 0;
+        appfw::DatagramParser::Error error;
+        bool result = parser.parseData(data, (uint32_t)size, bytesRead, error);
+        return result && bytesRead == size;
+    }
+};
+
+} // namespace
+
+TEST_CASE("appfw::DatagramParser") {
+    std::vector<uint8_t> data;
+    appendPacket(data, "first");
+    appendPacket(data, "");
+    appendPacket(data, "third");
+
+    SUBCASE("Whole packets are parsed in place") {
+        ParserTest t;
+        REQUIRE(t.parse(data.data(), data.size()));
+        REQUIRE(t.payloads.size() == 3);
+        CHECK(t.payloads[0] == "first");
+        CHECK(t.payloads[1] == "");
+        CHECK(t.payloads[2] == "third");
+        CHECK(t.payloadPtrs[0] == data.data() + MAGIC_SIZE + sizeof(uint32_t));
+    }
+
+    SUBCASE("Split packets are reassembled") {
+        ParserTest t;
+
+        for (size_t i = 0; i < data.size(); i++) {
+            REQUIRE(t.parse(data.data() + i, 1));
+        }
+
+        REQUIRE(t.payloads.size() == 3);
+        CHECK(t.payloads[0] == "first");
+        CHECK(t.payloads[1] == "");
+        CHECK(t.payloads[2] == "third");
+    }
+
+    SUBCASE("Packet split after a whole one") {
+        ParserTest t;
+        size_t splitPos = data.size() - 3;
+        REQUIRE(t.parse(data.data(), splitPos));
+        CHECK(t.payloads.size() == 2);
+        REQUIRE(t.parse(data.data() + splitPos, data.size() - splitPos));
+        REQUIRE(t.payloads.size() == 3);
+        CHECK(t.payloads[2] == "third");
+    }
+
+    SUBCASE("Invalid magic") {
+        ParserTest t;
+        data[0] = 'X';
+        CHECK(!t.parse(data.data(), data.size()));
+        CHECK(t.payloads.empty());
+    }
+
+    SUBCASE("Payload too large") {
+        ParserTest t;
+        std::vector<uint8_t> large;
+        appendPacket(large, std::string(65, 'x'));
+        CHECK(!t.parse(large.data(), large.size()));
+        CHECK(t.payloads.empty());
+    }
+}
+
+TEST_CASE("appfw::DatagramParser buffer pool") {
+    auto pool = std::make_shared<appfw::DatagramBufferPool>(1, 32);
+    std::vector<uint8_t> first;
+    appendPacket(first, "first");
+    std::vector<uint8_t> large;
+    appendPacket(large, std::string(48, 'x'));
+    std::vector<uint8_t> small;
+    appendPacket(small, "small");
+
+    ParserTest t;
+    t.parser.setBufferPool(pool);
+
+    // Packet parsed in place doesn't need a buffer
+    REQUIRE(t.parse(first.data(), first.size()));
+    CHECK(pool->getFreeBufferCount() == 0);
+
+    // Buffer is larger than pool's max size so it's freed after the packet
+    REQUIRE(t.parse(large.data(), 3));
+    REQUIRE(t.parse(large.data() + 3, large.size() - 4));
+    REQUIRE(t.parse(large.data() + large.size() - 1, 1));
+    REQUIRE(t.payloads.size() == 2);
+    CHECK(t.payloads[1] == std::string(48, 'x'));
+    CHECK(pool->getFreeBufferCount() == 0);
+
+    // Small buffer is returned into the pool
+    REQUIRE(t.parse(small.data(), 3));
+    REQUIRE(t.parse(small.data() + 3, small.size() - 3));
+    REQUIRE(t.payloads.size() == 3);
+    CHECK(t.payloads[2] == "small");
+    CHECK(pool->getFreeBufferCount() == 1);
+}
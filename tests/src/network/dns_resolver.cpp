@@ -0,0 +1,47 @@
+#include <appfw/network/dns_resolver.h>
+#include <doctest/doctest.h>
+
+TEST_CASE("appfw::DnsResolver") {
+    appfw::DnsResolver resolver;
+
+    SUBCASE("Future") {
+        auto result = resolver.resolve("127.0.0.1", "27015", appfw::SockType::TCP);
+        REQUIRE(result.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+
+        const appfw::DnsResolver::AddrList &list = result.get();
+        REQUIRE(list.size() == 1);
+        CHECK(list.front().toString() == "127.0.0.1:27015");
+
+        // Second lookup is cached
+        CHECK(resolver.getCacheSize() == 1);
+        auto cached = resolver.resolve("127.0.0.1", "27015", appfw::SockType::TCP);
+        CHECK(appfw::isFutureReady(cached));
+        CHECK(resolver.getCacheSize() == 1);
+
+        resolver.clearCache();
+        CHECK(resolver.getCacheSize() == 0);
+    }
+
+    SUBCASE("Callback") {
+        bool isCalled = false;
+
+        resolver.resolve("::1", "80", appfw::SockType::TCP, appfw::AddressFamily::IPv6,
+                         [&](const appfw::DnsResolver::ResultFuture &result) {
+                             isCalled = true;
+                             REQUIRE(result.get().size() == 1);
+                             CHECK(result.get().front().toString() == "[::1]:80");
+                         });
+
+        for (int i = 0; i < 500 && !isCalled; i++) {
+            resolver.tick();
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        CHECK(isCalled);
+    }
+
+    SUBCASE("Failure") {
+        auto result = resolver.resolve("127.0.0.1", "invalid service name", appfw::SockType::TCP);
+        CHECK_THROWS(result.get());
+    }
+}
@@ -0,0 +1,155 @@
+#include <map>
+#include <string>
+#include <vector>
+#include <appfw/network/framed_tcp_server.h>
+#include <appfw/network/tcp_client.h>
+#include <doctest/doctest.h>
+
+namespace {
+
+constexpr uint16_t PORT = 27944;
+constexpr char MAGIC[] = "TEST";
+constexpr uint16_t MAGIC_SIZE = 4;
+constexpr uint32_t MAX_PAYLOAD_SIZE = 1024;
+
+std::vector<uint8_t> makeFrame(std::string_view payload, std::string_view magic = MAGIC) {
+    std::vector<uint8_t> frame(magic.begin(), magic.end());
+    uint32_t size = (uint32_t)payload.size();
+
+    for (int i = 0; i < 4; i++) {
+        frame.push_back((uint8_t)(size >> (8 * i)));
+    }
+
+    frame.insert(frame.end(), payload.begin(), payload.end());
+    return frame;
+}
+
+void connectClient(appfw::TcpClient &client, appfw::FramedTcpServer &server) {
+    client.connect(appfw::SockAddr(appfw::ADDR4_LOOPBACK, PORT));
+
+    for (int i = 0; i < 100 && client.getStatus() == appfw::NetClientStatus::Connecting; i++) {
+        server.poll(0);
+        client.updateStatus(10);
+    }
+
+    REQUIRE(client.getStatus() == appfw::NetClientStatus::Connected);
+}
+
+void sendPart(appfw::TcpClient &client, appfw::FramedTcpServer &server,
+              const std::vector<uint8_t> &data, size_t offset, size_t size) {
+    client.writeAll(appfw::span<const uint8_t>(data).subspan(offset, size));
+
+    // Let the server read it before the next part
+    for (int i = 0; i < 5; i++) {
+        server.poll(5);
+    }
+}
+
+void sendAll(appfw::TcpClient &client, appfw::FramedTcpServer &server,
+             const std::vector<uint8_t> &data) {
+    sendPart(client, server, data, 0, data.size());
+}
+
+} // namespace
+
+TEST_CASE("appfw::FramedTcpServer") {
+    appfw::FramedTcpServer server;
+    std::map<appfw::TcpClientSocket *, std::vector<std::string>> payloads;
+    std::map<appfw::TcpClientSocket *, appfw::SocketCloseReason> closeReasons;
+
+    server.setMagic(MAGIC, MAGIC_SIZE);
+    server.setMaxPayloadSize(MAX_PAYLOAD_SIZE);
+    server.setConnClosedCallback(
+        [&](size_t, appfw::TcpClientSocketPtr socket, appfw::SocketCloseReason reason) {
+            closeReasons[socket.get()] = reason;
+        });
+    server.setPayloadCallback([&](size_t, const appfw::TcpClientSocketPtr &socket,
+                                  appfw::BinaryInputStream &, appfw::span<const uint8_t> payload) {
+        payloads[socket.get()].emplace_back(payload.begin(), payload.end());
+    });
+    server.startListening(appfw::ADDR4_LOOPBACK, PORT);
+
+    appfw::TcpClient clientA, clientB;
+    connectClient(clientA, server);
+    connectClient(clientB, server);
+    REQUIRE(server.getServer().getConnectedClients() == 2);
+
+    // Frames split across several writes, interleaved between clients
+    std::vector<uint8_t> frameA1 = makeFrame("A1 " + std::string(300, 'a'));
+    std::vector<uint8_t> frameB1 = makeFrame("B1 " + std::string(200, 'b'));
+    sendPart(clientA, server, frameA1, 0, 2);
+    sendPart(clientB, server, frameB1, 0, 6);
+    sendPart(clientA, server, frameA1, 2, 100);
+    sendPart(clientB, server, frameB1, 6, frameB1.size() - 6);
+    sendPart(clientA, server, frameA1, 102, frameA1.size() - 102);
+
+    // Several frames coalesced in one write
+    std::vector<uint8_t> coalesced;
+
+    for (const char *payload : {"A2", "A3", "A4"}) {
+        std::vector<uint8_t> frame = makeFrame(payload);
+        coalesced.insert(coalesced.end(), frame.begin(), frame.end());
+    }
+
+    // End of the last frame arrives with the next write
+    std::vector<uint8_t> frameA5 = makeFrame("A5");
+    coalesced.insert(coalesced.end(), frameA5.begin(), frameA5.begin() + 3);
+    sendAll(clientA, server, coalesced);
+    sendPart(clientA, server, frameA5, 3, frameA5.size() - 3);
+
+    REQUIRE(payloads.size() == 2);
+
+    for (auto &[pSocket, list] : payloads) {
+        REQUIRE(!list.empty());
+
+        if (list[0][0] == 'A') {
+            CHECK(list == std::vector<std::string>{"A1 " + std::string(300, 'a'), "A2", "A3",
+                                                   "A4", "A5"});
+        } else {
+            CHECK(list == std::vector<std::string>{"B1 " + std::string(200, 'b')});
+        }
+    }
+
+    // Invalid frames close only their connection
+    appfw::TcpClient badMagicClient, oversizeClient;
+    connectClient(badMagicClient, server);
+    connectClient(oversizeClient, server);
+    REQUIRE(server.getServer().getConnectedClients() == 4);
+
+    sendAll(badMagicClient, server, makeFrame("payload", "BAD!"));
+    sendAll(oversizeClient, server, makeFrame(std::string(MAX_PAYLOAD_SIZE + 1, 'x')));
+
+    for (int i = 0; i < 100 && closeReasons.size() < 2; i++) {
+        server.poll(10);
+    }
+
+    REQUIRE(closeReasons.size() == 2);
+
+    for (auto &[pSocket, reason] : closeReasons) {
+        CHECK(reason == appfw::SocketCloseReason::InvalidData);
+        CHECK(payloads.find(pSocket) == payloads.end());
+    }
+
+    CHECK(server.getServer().getConnectedClients() == 2);
+
+    // Other clients still work
+    size_t payloadCount = payloads.size();
+    sendAll(clientB, server, makeFrame("B2"));
+    CHECK(payloads.size() == payloadCount);
+
+    bool isB2Received = false;
+
+    for (auto &[pSocket, list] : payloads) {
+        isB2Received = isB2Received || list.back() == "B2";
+    }
+
+    CHECK(isB2Received);
+
+    for (appfw::TcpClient *pClient : {&clientA, &clientB, &badMagicClient, &oversizeClient}) {
+        pClient->close();
+    }
+
+    for (int i = 0; i < 100 && server.getServer().getConnectedClients() != 0; i++) {
+        server.poll(10);
+    }
+}
@@ -0,0 +1,64 @@
+#include <cstring>
+#include <appfw/network/recv_ring_buffer.h>
+#include <doctest/doctest.h>
+
+namespace {
+
+void writeBytes(appfw::RecvRingBuffer &buf, const uint8_t *data, size_t size) {
+    appfw::RecvRingBuffer::WriteView view = buf.writable();
+    REQUIRE(view.size() >= size);
+    size_t firstSize = std::min(size, view.first.size());
+    std::memcpy(view.first.data(), data, firstSize);
+    std::memcpy(view.second.data(), data + firstSize, size - firstSize);
+    buf.commit(size);
+}
+
+} // namespace
+
+TEST_CASE("appfw::RecvRingBuffer") {
+    constexpr size_t CAPACITY = 8;
+    appfw::RecvRingBuffer buf(CAPACITY);
+
+    CHECK(buf.empty());
+    CHECK(buf.capacity() == CAPACITY);
+    CHECK(buf.freeSpace() == CAPACITY);
+    CHECK(buf.readable().empty());
+
+    // Empty buffer is fully contiguous
+    appfw::RecvRingBuffer::WriteView wview = buf.writable();
+    CHECK(wview.first.size() == CAPACITY);
+    CHECK(wview.second.empty());
+
+    constexpr uint8_t DATA[] = {1, 2, 3, 4, 5, 6, 7, 8};
+    writeBytes(buf, DATA, 6);
+    CHECK(buf.size() == 6);
+
+    uint8_t out[CAPACITY] = {};
+    CHECK(buf.read(appfw::span(out, 4)) == 4);
+    CHECK(std::memcmp(out, DATA, 4) == 0);
+    CHECK(buf.size() == 2);
+
+    // Write wraps around the end
+    wview = buf.writable();
+    CHECK(wview.first.size() == 2);
+    CHECK(wview.second.size() == 4);
+    writeBytes(buf, DATA, 5);
+    CHECK(buf.size() == 7);
+
+    appfw::RecvRingBuffer::ReadView rview = buf.readable();
+    REQUIRE(rview.first.size() == 4);
+    REQUIRE(rview.second.size() == 3);
+    CHECK(rview.first[0] == 5);
+    CHECK(rview.first[1] == 6);
+    CHECK(rview.first[2] == 1);
+    CHECK(rview.second[0] == 3);
+
+    // Consuming everything makes the buffer contiguous again
+    buf.consume(buf.size());
+    CHECK(buf.empty());
+    CHECK(buf.writable().first.size() == CAPACITY);
+
+    writeBytes(buf, DATA, CAPACITY);
+    CHECK(buf.full());
+    CHECK(buf.writable().empty());
+}
@@ -0,0 +1,74 @@
+#include <appfw/network/sock_addr.h>
+#include <doctest/doctest.h>
+
+TEST_CASE("appfw::SockAddr") {
+    SUBCASE("Unspec") {
+        appfw::SockAddr addr;
+        CHECK(addr.getFamily() == appfw::AddressFamily::Unspec);
+        CHECK(addr.getSockAddrSize() == 0);
+        CHECK(addr.getPort() == 0);
+    }
+
+    SUBCASE("IPv4") {
+        appfw::SockAddr addr(appfw::ADDR4_LOOPBACK, 27015);
+        CHECK(addr.isIPv4());
+        CHECK(addr.getPort() == 27015);
+        CHECK(addr.toSockAddr4().ip.addr == appfw::ADDR4_LOOPBACK.addr);
+        CHECK(addr.toString() == "127.0.0.1:27015");
+
+        appfw::SockAddr copy =
+            appfw::SockAddr::fromSockAddrStruct(addr.getSockAddrStruct(), addr.getSockAddrSize());
+        CHECK(copy.isIPv4());
+        CHECK(copy.toString() == addr.toString());
+    }
+
+    SUBCASE("IPv6") {
+        appfw::SockAddr addr(appfw::ADDR6_LOOPBACK, 27015);
+        CHECK(addr.isIPv6());
+        CHECK(addr.getPort() == 27015);
+        CHECK(addr.getIPAddress6().addr == appfw::ADDR6_LOOPBACK.addr);
+        CHECK(addr.toString() == "[::1]:27015");
+        CHECK(addr.unmapped().isIPv6());
+
+        appfw::SockAddr copy =
+            appfw::SockAddr::fromSockAddrStruct(addr.getSockAddrStruct(), addr.getSockAddrSize());
+        CHECK(copy.isIPv6());
+        CHECK(copy.toString() == addr.toString());
+    }
+
+    SUBCASE("IPv4-mapped IPv6") {
+        appfw::IPAddress6 ip = appfw::IPAddress6::fromV4Mapped(0xC0A8'0001);
+        CHECK(ip.isV4Mapped());
+        CHECK(ip.toV4Mapped().addr == 0xC0A8'0001);
+        CHECK(!appfw::ADDR6_LOOPBACK.isV4Mapped());
+
+        appfw::SockAddr addr(ip, 80);
+        CHECK(addr.toString() == "[::ffff:192.168.0.1]:80");
+
+        appfw::SockAddr unmapped = addr.unmapped();
+        CHECK(unmapped.isIPv4());
+        CHECK(unmapped.toString() == "192.168.0.1:80");
+    }
+
+#if PLATFORM_UNIX
+    SUBCASE("Unix") {
+        appfw::SockAddr addr = appfw::SockAddr::fromUnixPath("/tmp/test.sock");
+        CHECK(addr.isUnix());
+        CHECK(addr.getPort() == 0);
+        CHECK(addr.getUnixPath() == "/tmp/test.sock");
+        CHECK(addr.toString() == "unix:/tmp/test.sock");
+
+        appfw::SockAddr copy =
+            appfw::SockAddr::fromSockAddrStruct(addr.getSockAddrStruct(), addr.getSockAddrSize());
+        CHECK(copy.isUnix());
+        CHECK(copy.getUnixPath() == "/tmp/test.sock");
+
+        appfw::SockAddr abstract = appfw::SockAddr::fromUnixPath(std::string_view("\0name", 5));
+        CHECK(abstract.getUnixPath().size() == 5);
+        CHECK(abstract.toString() == "unix:@name");
+
+        CHECK_THROWS(appfw::SockAddr::fromUnixPath(""));
+        CHECK_THROWS(appfw::SockAddr::fromUnixPath(std::string(200, 'a')));
+    }
+#endif
+}
@@ -0,0 +1,84 @@
+#include <appfw/network/tcp_client_pool.h>
+#include <appfw/network/tcp_server.h>
+#include <doctest/doctest.h>
+
+TEST_CASE("appfw::TcpClientPool") {
+    constexpr uint16_t PORT = 27940;
+    constexpr size_t COUNT = 16;
+
+    appfw::TcpServer server;
+    server.setConnAcceptedCallback([](size_t, appfw::TcpClientSocketPtr) {});
+    server.setConnClosedCallback([](size_t, appfw::TcpClientSocketPtr, appfw::SocketCloseReason) {});
+    server.setReadyReadCallback([](size_t, appfw::TcpClientSocketPtr socket) {
+        // Echo
+        socket->receive();
+        appfw::RecvRingBuffer &buf = socket->getRecvBuffer();
+
+        while (!buf.empty()) {
+            auto data = buf.readable().first;
+            socket->writeAll(data);
+            buf.consume(data.size());
+        }
+    });
+    server.startListening(appfw::ADDR4_LOOPBACK, PORT);
+
+    appfw::TcpClientPool pool;
+    size_t connected = 0;
+    size_t echoed = 0;
+    std::vector<appfw::SocketCloseReason> closeReasons;
+
+    pool.setConnectedCallback([&](size_t, appfw::TcpClientPtr client) {
+        connected++;
+        uint8_t data = 42;
+        client->writeAll(appfw::span<const uint8_t>(&data, 1));
+    });
+    pool.setReadyReadCallback([&](size_t, appfw::TcpClientPtr client) {
+        client->receive();
+        uint8_t data = 0;
+
+        if (client->getRecvBuffer().read(appfw::span<uint8_t>(&data, 1)) == 1) {
+            CHECK(data == 42);
+            echoed++;
+            client->close();
+        }
+    });
+    pool.setClosedCallback([&](size_t, appfw::TcpClientPtr, appfw::SocketCloseReason reason) {
+        closeReasons.push_back(reason);
+    });
+
+    for (size_t i = 0; i < COUNT; i++) {
+        pool.connect(appfw::SockAddr(appfw::ADDR4_LOOPBACK, PORT));
+    }
+
+    CHECK(pool.getClientCount() == COUNT);
+
+    for (int i = 0; i < 1000 && pool.getClientCount() != 0; i++) {
+        server.poll(0);
+        pool.poll(1);
+    }
+
+    CHECK(connected == COUNT);
+    CHECK(echoed == COUNT);
+    CHECK(pool.getClientCount() == 0);
+    REQUIRE(closeReasons.size() == COUNT);
+    CHECK(closeReasons[0] == appfw::SocketCloseReason::User);
+
+    SUBCASE("Connection refused") {
+        server.stopListening();
+        closeReasons.clear();
+
+        try {
+            pool.connect(appfw::SockAddr(appfw::ADDR4_LOOPBACK, PORT));
+        } catch (const appfw::SocketErrorException &) {
+            // May fail right away
+            closeReasons.push_back(appfw::SocketCloseReason::Failure);
+        }
+
+        for (int i = 0; i < 100 && pool.getClientCount() != 0; i++) {
+            pool.poll(10);
+        }
+
+        REQUIRE(closeReasons.size() == 1);
+        CHECK(closeReasons[0] == appfw::SocketCloseReason::Failure);
+    }
+}
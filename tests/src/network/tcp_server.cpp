@@ -0,0 +1,625 @@
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <appfw/platform.h>
+#include <appfw/network/tcp_client.h>
+#include <appfw/network/tcp_server.h>
+#include <doctest/doctest.h>
+
+#if PLATFORM_UNIX
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+void testEcho(appfw::NetBackend backend) {
+    constexpr uint16_t PORT = 27941;
+    constexpr size_t DATA_SIZE = 100'000;
+
+    appfw::TcpServer server;
+    std::vector<appfw::SocketCloseReason> closeReasons;
+
+    server.setBackend(backend);
+    server.setConnAcceptedCallback([](size_t, appfw::TcpClientSocketPtr) {});
+    server.setConnClosedCallback([&](size_t, appfw::TcpClientSocketPtr, appfw::SocketCloseReason reason) {
+        closeReasons.push_back(reason);
+    });
+    server.setReadyReadCallback([](size_t, appfw::TcpClientSocketPtr socket) {
+        socket->receive();
+        appfw::RecvRingBuffer &buf = socket->getRecvBuffer();
+        appfw::RecvRingBuffer::ReadView view = buf.readable();
+        socket->writeAll(view.first);
+        socket->writeAll(view.second);
+        buf.consume(view.size());
+    });
+    server.startListening(appfw::ADDR4_LOOPBACK, PORT);
+    CHECK(server.getBackend() == backend);
+
+    std::vector<uint8_t> data(DATA_SIZE);
+
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = (uint8_t)(i * 7);
+    }
+
+    appfw::TcpClient client;
+    client.connect(appfw::SockAddr(appfw::ADDR4_LOOPBACK, PORT));
+
+    std::vector<uint8_t> received;
+    size_t sent = 0;
+
+    for (int i = 0; i < 5000 && received.size() != DATA_SIZE; i++) {
+        server.poll(0);
+
+        if (client.getStatus() == appfw::NetClientStatus::Connecting) {
+            client.updateStatus(1);
+            continue;
+        }
+
+        if (sent != DATA_SIZE) {
+            sent += client.write(appfw::span<const uint8_t>(data).subspan(sent));
+        }
+
+        if (client.updateStatus(1)) {
+            client.receive();
+            appfw::RecvRingBuffer &buf = client.getRecvBuffer();
+            appfw::RecvRingBuffer::ReadView view = buf.readable();
+            received.insert(received.end(), view.first.begin(), view.first.end());
+            received.insert(received.end(), view.second.begin(), view.second.end());
+            buf.consume(view.size());
+        }
+    }
+
+    CHECK(received == data);
+    CHECK(server.getConnectedClients() == 1);
+
+    client.close();
+
+    for (int i = 0; i < 100 && closeReasons.empty(); i++) {
+        server.poll(10);
+    }
+
+    REQUIRE(closeReasons.size() == 1);
+    CHECK(closeReasons[0] == appfw::SocketCloseReason::ConnAborted);
+    CHECK(server.getConnectedClients() == 0);
+
+    appfw::ServerMetrics::Snapshot metrics = server.getMetrics().getSnapshot();
+    CHECK(metrics.uAccepts == 1);
+    CHECK(metrics.uCloses[(size_t)appfw::SocketCloseReason::ConnAborted] == 1);
+    CHECK(metrics.uConnections == 0);
+    CHECK(metrics.traffic.uBytesIn == DATA_SIZE);
+    CHECK(metrics.traffic.uBytesOut == DATA_SIZE);
+    CHECK(metrics.traffic.uRecvCalls > 0);
+    CHECK(metrics.uPolls > 0);
+    CHECK(metrics.uPollEvents > 0);
+}
+
+void testSendFile(appfw::NetBackend backend) {
+    constexpr uint16_t PORT = 27942;
+    constexpr size_t FILE_SIZE = 3'000'000;
+    constexpr size_t FILE_OFFSET = 1000;
+
+    // Create the file
+    std::vector<uint8_t> fileData(FILE_SIZE);
+
+    for (size_t i = 0; i < fileData.size(); i++) {
+        fileData[i] = (uint8_t)(i * 13 + i / 256);
+    }
+
+    fs::path filePath = fs::temp_directory_path() / "appfw_test_send_file.bin";
+
+    {
+        std::ofstream file(filePath, std::ios::binary);
+        file.write(reinterpret_cast<const char *>(fileData.data()), (std::streamsize)fileData.size());
+    }
+
+    const std::string header = "header";
+    const std::string footer = "footer";
+
+    std::vector<uint8_t> expected(header.begin(), header.end());
+    expected.insert(expected.end(), fileData.begin() + FILE_OFFSET, fileData.end());
+    expected.insert(expected.end(), footer.begin(), footer.end());
+
+    appfw::TcpServer server;
+    appfw::TcpClientSocketPtr serverSocket;
+
+    server.setBackend(backend);
+    server.setConnAcceptedCallback([&](size_t, appfw::TcpClientSocketPtr socket) {
+        serverSocket = socket;
+        socket->queueWrite(appfw::span(reinterpret_cast<const uint8_t *>(header.data()), header.size()));
+        socket->sendFile(filePath, FILE_OFFSET);
+        socket->queueWrite(appfw::span(reinterpret_cast<const uint8_t *>(footer.data()), footer.size()));
+    });
+    server.setConnClosedCallback([](size_t, appfw::TcpClientSocketPtr, appfw::SocketCloseReason) {});
+    server.setReadyReadCallback([](size_t, appfw::TcpClientSocketPtr) {});
+    server.startListening(appfw::ADDR4_LOOPBACK, PORT);
+
+    appfw::TcpClient client;
+    client.connect(appfw::SockAddr(appfw::ADDR4_LOOPBACK, PORT));
+
+    std::vector<uint8_t> received;
+
+    for (int i = 0; i < 20000 && received.size() < expected.size(); i++) {
+        server.poll(0);
+
+        if (client.updateStatus(1)) {
+            client.receive();
+            appfw::RecvRingBuffer &buf = client.getRecvBuffer();
+            appfw::RecvRingBuffer::ReadView view = buf.readable();
+            received.insert(received.end(), view.first.begin(), view.first.end());
+            received.insert(received.end(), view.second.begin(), view.second.end());
+            buf.consume(view.size());
+        }
+    }
+
+    CHECK(received == expected);
+    REQUIRE(serverSocket);
+    CHECK(serverSocket->getSendQueueSize() == 0);
+    CHECK(serverSocket->isOpen());
+
+    CHECK_THROWS(serverSocket->sendFile(filePath, FILE_SIZE + 1));
+    CHECK_THROWS(serverSocket->sendFile(filePath.string() + ".missing"));
+    CHECK(serverSocket->isOpen());
+
+    // Client closes first so the port is not left in TIME_WAIT
+    client.close();
+
+    for (int i = 0; i < 100 && server.getConnectedClients() != 0; i++) {
+        server.poll(10);
+    }
+
+    server.stopListening();
+    fs::remove(filePath);
+}
+
+} // namespace
+
+TEST_CASE("appfw::TcpServer echo") {
+    SUBCASE("Poll") {
+        testEcho(appfw::NetBackend::Poll);
+    }
+
+    if (appfw::isNetBackendSupported(appfw::NetBackend::IoUring)) {
+        SUBCASE("io_uring") {
+            testEcho(appfw::NetBackend::IoUring);
+        }
+    }
+}
+
+TEST_CASE("appfw::TcpServer sendFile") {
+    SUBCASE("Poll") {
+        testSendFile(appfw::NetBackend::Poll);
+    }
+
+    if (appfw::isNetBackendSupported(appfw::NetBackend::IoUring)) {
+        SUBCASE("io_uring") {
+            testSendFile(appfw::NetBackend::IoUring);
+        }
+    }
+}
+
+TEST_CASE("appfw::TcpServer admission control") {
+    constexpr uint16_t PORT = 27943;
+    const std::string rejectMsg = "server is full";
+
+    appfw::TcpServer server;
+    size_t acceptCount = 0;
+
+    server.setAcceptBudget(1);
+    server.setMaxClients(2);
+    server.setRejectMessage(appfw::span(reinterpret_cast<const uint8_t *>(rejectMsg.data()), rejectMsg.size()));
+    server.setConnAcceptedCallback([&](size_t, appfw::TcpClientSocketPtr) { acceptCount++; });
+    server.setConnClosedCallback([](size_t, appfw::TcpClientSocketPtr, appfw::SocketCloseReason) {});
+    server.setReadyReadCallback([](size_t, appfw::TcpClientSocketPtr socket) { socket->receive(); });
+    server.startListening(appfw::ADDR4_LOOPBACK, PORT);
+
+    appfw::TcpClient clients[3];
+
+    for (appfw::TcpClient &client : clients) {
+        client.connect(appfw::SockAddr(appfw::ADDR4_LOOPBACK, PORT));
+
+        // Connect in order
+        for (int i = 0; i < 100 && client.getStatus() == appfw::NetClientStatus::Connecting; i++) {
+            client.updateStatus(10);
+        }
+
+        REQUIRE(client.getStatus() == appfw::NetClientStatus::Connected);
+    }
+
+    // Only one connection is accepted per poll
+    server.poll(0);
+    CHECK(acceptCount == 1);
+    server.poll(0);
+    CHECK(acceptCount == 2);
+    server.poll(0);
+    CHECK(acceptCount == 2);
+    CHECK(server.getConnectedClients() == 2);
+    CHECK(server.getMetrics().getSnapshot().uRejects == 1);
+
+    // Last client receives the message and EOF
+    std::string received;
+    appfw::TcpClient &rejected = clients[2];
+
+    for (int i = 0; i < 100 && rejected.getStatus() == appfw::NetClientStatus::Connected; i++) {
+        if (rejected.updateStatus(10)) {
+            rejected.receive();
+            appfw::RecvRingBuffer &buf = rejected.getRecvBuffer();
+            appfw::RecvRingBuffer::ReadView view = buf.readable();
+            received.append(view.first.begin(), view.first.end());
+            received.append(view.second.begin(), view.second.end());
+            buf.consume(view.size());
+        }
+    }
+
+    CHECK(received == rejectMsg);
+    CHECK(rejected.getStatus() == appfw::NetClientStatus::Closed);
+
+    for (appfw::TcpClient &client : clients) {
+        client.close();
+    }
+
+    for (int i = 0; i < 100 && server.getConnectedClients() != 0; i++) {
+        server.poll(10);
+    }
+}
+
+TEST_CASE("appfw::TcpServer max clients ignores closing sockets") {
+    constexpr uint16_t PORT = 27947;
+
+    appfw::TcpServer server;
+    std::vector<appfw::TcpClientSocketPtr> serverSockets;
+
+    server.setMaxClients(1);
+    server.setConnAcceptedCallback([&](size_t, appfw::TcpClientSocketPtr socket) { serverSockets.push_back(socket); });
+    server.setConnClosedCallback([](size_t, appfw::TcpClientSocketPtr, appfw::SocketCloseReason) {});
+    server.setReadyReadCallback([](size_t, appfw::TcpClientSocketPtr socket) { socket->receive(); });
+    server.startListening(appfw::ADDR4_LOOPBACK, PORT);
+
+    appfw::TcpClient first;
+    first.connect(appfw::SockAddr(appfw::ADDR4_LOOPBACK, PORT));
+
+    for (int i = 0; i < 100 && serverSockets.empty(); i++) {
+        server.poll(10);
+    }
+
+    REQUIRE(serverSockets.size() == 1);
+
+    // Closed socket is removed at the end of the poll that accepts the next one
+    serverSockets[0]->close();
+
+    appfw::TcpClient second;
+    second.connect(appfw::SockAddr(appfw::ADDR4_LOOPBACK, PORT));
+
+    for (int i = 0; i < 100 && second.getStatus() == appfw::NetClientStatus::Connecting; i++) {
+        second.updateStatus(10);
+    }
+
+    REQUIRE(second.getStatus() == appfw::NetClientStatus::Connected);
+    server.poll(100);
+
+    CHECK(serverSockets.size() == 2);
+    CHECK(server.getConnectedClients() == 1);
+    CHECK(server.getMetrics().getSnapshot().uRejects == 0);
+
+    first.close();
+    second.close();
+
+    for (int i = 0; i < 100 && server.getConnectedClients() != 0; i++) {
+        server.poll(10);
+    }
+}
+
+#if PLATFORM_UNIX
+TEST_CASE("appfw::TcpServer socket options") {
+    constexpr uint16_t PORT = 27945;
+    constexpr int BUFFER_SIZE = 96 * 1024;
+
+    auto getIntOpt = [](appfw::SocketFile fd, int level, int name) {
+        int value = 0;
+        socklen_t size = sizeof(value);
+        REQUIRE(::getsockopt(fd, level, name, &value, &size) == 0);
+        return value;
+    };
+
+    auto checkOptions = [&](appfw::SocketFile fd) {
+        REQUIRE(fd > 0);
+        CHECK(getIntOpt(fd, IPPROTO_TCP, TCP_NODELAY) != 0);
+        CHECK(getIntOpt(fd, SOL_SOCKET, SO_KEEPALIVE) != 0);
+
+        // Linux doubles the value for bookkeeping
+        CHECK(getIntOpt(fd, SOL_SOCKET, SO_SNDBUF) >= BUFFER_SIZE);
+        CHECK(getIntOpt(fd, SOL_SOCKET, SO_RCVBUF) >= BUFFER_SIZE);
+
+#ifdef TCP_KEEPIDLE
+        CHECK(getIntOpt(fd, IPPROTO_TCP, TCP_KEEPIDLE) == 42);
+#endif
+    };
+
+    appfw::SocketOptions opts;
+    opts.setNoDelay(true)
+        .setKeepAlive(true)
+        .setKeepAliveIdle(42)
+        .setSendBufferSize(BUFFER_SIZE)
+        .setRecvBufferSize(BUFFER_SIZE);
+
+    appfw::TcpServer server;
+    appfw::TcpClientSocketPtr serverSocket;
+
+    server.setSocketOptions(opts);
+    server.setConnAcceptedCallback([&](size_t, appfw::TcpClientSocketPtr socket) { serverSocket = socket; });
+    server.setConnClosedCallback([](size_t, appfw::TcpClientSocketPtr, appfw::SocketCloseReason) {});
+    server.setReadyReadCallback([](size_t, appfw::TcpClientSocketPtr socket) { socket->receive(); });
+    server.startListening(appfw::ADDR4_LOOPBACK, PORT);
+
+    appfw::TcpClient client;
+    client.setSocketOptions(opts);
+    client.connect(appfw::SockAddr(appfw::ADDR4_LOOPBACK, PORT));
+
+    for (int i = 0; i < 100 && !serverSocket; i++) {
+        server.poll(10);
+        client.updateStatus(0);
+    }
+
+    REQUIRE(serverSocket);
+
+    SUBCASE("Accepted socket") {
+        checkOptions(serverSocket->getNativeSocket());
+    }
+
+    SUBCASE("Connecting socket") {
+        checkOptions(client.getNativeSocket());
+    }
+
+    // Defaults are left alone
+    appfw::TcpClient defaultClient;
+    defaultClient.connect(appfw::SockAddr(appfw::ADDR4_LOOPBACK, PORT));
+    CHECK(getIntOpt(defaultClient.getNativeSocket(), IPPROTO_TCP, TCP_NODELAY) == 0);
+    CHECK(getIntOpt(defaultClient.getNativeSocket(), SOL_SOCKET, SO_KEEPALIVE) == 0);
+    defaultClient.close();
+
+    client.close();
+
+    for (int i = 0; i < 100 && server.getConnectedClients() != 0; i++) {
+        server.poll(10);
+    }
+}
+
+TEST_CASE("appfw::TcpServer Unix socket file") {
+    namespace fs = std::filesystem;
+    fs::path path = fs::temp_directory_path() / "appfw_test_tcp_server.sock";
+    appfw::SockAddr addr = appfw::SockAddr::fromUnixPath(path.string());
+    fs::remove(path);
+
+    // Leave a file of a socket that nothing listens on
+    {
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        REQUIRE(fd >= 0);
+        REQUIRE(::bind(fd, addr.getSockAddrStruct(), addr.getSockAddrSize()) == 0);
+        ::close(fd);
+        REQUIRE(fs::exists(path));
+    }
+
+    auto setCallbacks = [](appfw::TcpServer &server) {
+        server.setConnAcceptedCallback([](size_t, appfw::TcpClientSocketPtr) {});
+        server.setConnClosedCallback([](size_t, appfw::TcpClientSocketPtr, appfw::SocketCloseReason) {});
+        server.setReadyReadCallback([](size_t, appfw::TcpClientSocketPtr socket) { socket->receive(); });
+    };
+
+    // Stale file is replaced
+    appfw::TcpServer server;
+    setCallbacks(server);
+    server.startListening(addr);
+
+    // Path of a live server is not taken over
+    {
+        appfw::TcpServer other;
+        setCallbacks(other);
+        CHECK_THROWS(other.startListening(addr));
+    }
+
+    REQUIRE(fs::exists(path));
+
+    appfw::TcpClient client;
+    client.connect(addr);
+
+    // The probe of the other server is accepted and closed too
+    for (int i = 0; i < 100 && (server.getConnectedClients() != 1 ||
+                                client.getStatus() != appfw::NetClientStatus::Connected); i++) {
+        server.poll(10);
+        client.updateStatus(0);
+    }
+
+    CHECK(server.getConnectedClients() == 1);
+    client.close();
+
+    server.stopListening();
+    CHECK(!fs::exists(path));
+}
+
+TEST_CASE("appfw::TcpServer Unix socket fd passing") {
+#if PLATFORM_LINUX
+    // Abstract address, no file is created
+    appfw::SockAddr addr = appfw::SockAddr::fromUnixPath(std::string_view("\0appfw_test_fd_passing", 23));
+#else
+    // Abstract namespace is Linux-only
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "appfw_test_fd_passing.sock";
+    std::filesystem::remove(path);
+    appfw::SockAddr addr = appfw::SockAddr::fromUnixPath(path.string());
+#endif
+
+    auto isCloseOnExec = [](int fd) { return (::fcntl(fd, F_GETFD) & FD_CLOEXEC) != 0; };
+
+    auto readFd = [](int fd, size_t size) {
+        std::string str(size, '\0');
+        REQUIRE(::read(fd, str.data(), size) == (ssize_t)size);
+        return str;
+    };
+
+    appfw::TcpServer server;
+    appfw::TcpClientSocketPtr serverSocket;
+    std::vector<int> serverFds;
+
+    server.setConnAcceptedCallback([&](size_t, appfw::TcpClientSocketPtr socket) { serverSocket = socket; });
+    server.setConnClosedCallback([](size_t, appfw::TcpClientSocketPtr, appfw::SocketCloseReason) {});
+    server.setReadyReadCallback([&](size_t, appfw::TcpClientSocketPtr socket) {
+        socket->receiveWithFds(serverFds);
+    });
+    server.startListening(addr);
+
+    appfw::TcpClient client;
+    client.connect(addr);
+
+    for (int i = 0; i < 100 && (!serverSocket || client.getStatus() != appfw::NetClientStatus::Connected); i++) {
+        server.poll(10);
+        client.updateStatus(0);
+    }
+
+    REQUIRE(serverSocket);
+    REQUIRE(client.getStatus() == appfw::NetClientStatus::Connected);
+
+    int pipeFds[2];
+    REQUIRE(::pipe(pipeFds) == 0);
+    REQUIRE(::write(pipeFds[1], "hello world", 11) == 11);
+
+    const std::vector<uint8_t> data = { 'f', 'd' };
+
+    // Client to server
+    REQUIRE(client.writeWithFds(data, appfw::span<const int>(&pipeFds[0], 1)) == (int)data.size());
+    ::close(pipeFds[0]);
+
+    for (int i = 0; i < 100 && serverFds.empty(); i++) {
+        server.poll(10);
+    }
+
+    REQUIRE(serverFds.size() == 1);
+    CHECK(serverSocket->getRecvBuffer().size() == data.size());
+    CHECK(isCloseOnExec(serverFds[0]));
+    CHECK(readFd(serverFds[0], 5) == "hello");
+
+    // Server to client
+    REQUIRE(serverSocket->writeWithFds(data, appfw::span<const int>(&serverFds[0], 1)) == (int)data.size());
+    ::close(serverFds[0]);
+
+    std::vector<int> clientFds;
+
+    for (int i = 0; i < 100 && clientFds.empty(); i++) {
+        if (client.updateStatus(10)) {
+            client.receiveWithFds(clientFds);
+        }
+    }
+
+    REQUIRE(clientFds.size() == 1);
+    CHECK(client.getRecvBuffer().size() == data.size());
+    CHECK(isCloseOnExec(clientFds[0]));
+    CHECK(readFd(clientFds[0], 6) == " world");
+    ::close(clientFds[0]);
+    ::close(pipeFds[1]);
+
+    client.close();
+
+    for (int i = 0; i < 100 && server.getConnectedClients() != 0; i++) {
+        server.poll(10);
+    }
+}
+
+TEST_CASE("appfw::TcpServer out of file descriptors") {
+    constexpr uint16_t PORT = 27946;
+
+    auto test = [](appfw::NetBackend backend) {
+        appfw::TcpServer server;
+        size_t acceptCount = 0;
+
+        server.setBackend(backend);
+        server.setConnAcceptedCallback([&](size_t, appfw::TcpClientSocketPtr) { acceptCount++; });
+        server.setConnClosedCallback([](size_t, appfw::TcpClientSocketPtr, appfw::SocketCloseReason) {});
+        server.setReadyReadCallback([](size_t, appfw::TcpClientSocketPtr socket) { socket->receive(); });
+        server.startListening(appfw::ADDR4_LOOPBACK, PORT);
+
+        // Socket is created before the limit is reached, connection is made by the kernel
+        appfw::TcpClient client;
+        client.connect(appfw::SockAddr(appfw::ADDR4_LOOPBACK, PORT));
+
+        // Take all descriptors under a lowered limit
+        struct FdLimit {
+            rlimit oldLimit;
+            std::vector<int> fds;
+
+            FdLimit() {
+                REQUIRE(::getrlimit(RLIMIT_NOFILE, &oldLimit) == 0);
+                rlimit limit = oldLimit;
+                limit.rlim_cur = std::min<rlim_t>(oldLimit.rlim_cur, 256);
+                REQUIRE(::setrlimit(RLIMIT_NOFILE, &limit) == 0);
+
+                for (int fd = ::open("/dev/null", O_RDONLY); fd >= 0; fd = ::open("/dev/null", O_RDONLY)) {
+                    fds.push_back(fd);
+                }
+
+                REQUIRE(errno == EMFILE);
+            }
+
+            ~FdLimit() {
+                for (int fd : fds) {
+                    ::close(fd);
+                }
+
+                ::setrlimit(RLIMIT_NOFILE, &oldLimit);
+            }
+        };
+
+        {
+            FdLimit fdLimit;
+
+            for (int i = 0; i < 100 && client.getStatus() != appfw::NetClientStatus::Closed; i++) {
+                server.poll(10);
+
+                if (client.updateStatus(0)) {
+                    client.receive();
+                }
+            }
+
+            // Pending connection is dropped instead of keeping the listen socket readable
+            CHECK(client.getStatus() == appfw::NetClientStatus::Closed);
+            CHECK(acceptCount == 0);
+            CHECK(server.getMetrics().getSnapshot().uRejects == 1);
+
+            uint64_t pollEvents = server.getMetrics().getSnapshot().uPollEvents;
+
+            for (int i = 0; i < 5; i++) {
+                server.poll(10);
+            }
+
+            CHECK(server.getMetrics().getSnapshot().uPollEvents == pollEvents);
+        }
+
+        // Accepting works again once descriptors are available
+        appfw::TcpClient other;
+        other.connect(appfw::SockAddr(appfw::ADDR4_LOOPBACK, PORT));
+
+        for (int i = 0; i < 100 && acceptCount == 0; i++) {
+            server.poll(10);
+        }
+
+        CHECK(acceptCount == 1);
+        other.close();
+
+        for (int i = 0; i < 100 && server.getConnectedClients() != 0; i++) {
+            server.poll(10);
+        }
+    };
+
+    SUBCASE("Poll") {
+        test(appfw::NetBackend::Poll);
+    }
+
+    if (appfw::isNetBackendSupported(appfw::NetBackend::IoUring)) {
+        SUBCASE("io_uring") {
+            test(appfw::NetBackend::IoUring);
+        }
+    }
+}
+#endif
@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <appfw/network/udp_socket4.h>
+#include <doctest/doctest.h>
+
+TEST_CASE("appfw::UdpBatch4") {
+    appfw::UdpBatch4 batch(2, 4);
+    appfw::SockAddr4 addr = {appfw::ADDR4_LOOPBACK, 1234};
+    const uint8_t data[] = {1, 2, 3, 4, 5};
+
+    CHECK(batch.empty());
+    CHECK(batch.capacity() == 2);
+    CHECK(batch.bufferSize() == 4);
+
+    // Too large for a slot
+    CHECK(!batch.push(addr, appfw::span<const uint8_t>(data, 5)));
+    CHECK(batch.empty());
+
+    CHECK(batch.push(addr, appfw::span<const uint8_t>(data, 4)));
+    CHECK(batch.push(addr, appfw::span<const uint8_t>(data + 1, 2), 1));
+    CHECK(batch.full());
+    CHECK(!batch.push(addr, appfw::span<const uint8_t>(data, 1)));
+
+    CHECK(batch.getMessage(1).addr.port == 1234);
+    CHECK(batch.getMessage(1).segmentSize == 1);
+    CHECK(batch.getData(1).size() == 2);
+    CHECK(batch.getData(1)[0] == 2);
+
+    // Slots are contiguous
+    CHECK(batch.getBuffer(1).data() == batch.getBuffer(0).data() + 4);
+
+    batch.clear();
+    CHECK(batch.empty());
+}
+
+TEST_CASE("appfw::UdpSocket4 batch loopback") {
+    constexpr size_t COUNT = 8;
+    appfw::UdpSocket4 receiver, sender;
+    receiver.open(appfw::SockAddr4{appfw::ADDR4_LOOPBACK, 0});
+    sender.open(appfw::SockAddr4{appfw::ADDR4_LOOPBACK, 0});
+    REQUIRE(receiver.getLocalAddress().port != 0);
+
+    appfw::UdpBatch4 sendBatch(COUNT);
+
+    for (size_t i = 0; i < COUNT; i++) {
+        uint8_t data[16];
+        std::memset(data, (int)i, sizeof(data));
+        REQUIRE(sendBatch.push(receiver.getLocalAddress(),
+                               appfw::span<const uint8_t>(data, i + 1)));
+    }
+
+    size_t sent = 0;
+    while (sent != COUNT) {
+        sent += sender.sendBatch(sendBatch, sent);
+    }
+
+    appfw::UdpBatch4 recvBatch(COUNT);
+    size_t received = 0;
+
+    while (received != COUNT && receiver.poll(1000)) {
+        size_t count = receiver.receiveBatch(recvBatch);
+
+        for (size_t i = 0; i < count; i++) {
+            const appfw::UdpMessage4 &msg = recvBatch.getMessage(i);
+            CHECK(msg.addr.port == sender.getLocalAddress().port);
+            CHECK(msg.size == received + 1);
+            CHECK(recvBatch.getData(i)[0] == received);
+            received++;
+        }
+    }
+
+    CHECK(received == COUNT);
+
+    // Nothing left
+    size_t size = 0;
+    appfw::SockAddr4 addr;
+    uint8_t buf[16];
+    CHECK(!receiver.receiveFrom(appfw::span<uint8_t>(buf, sizeof(buf)), size, addr));
+    CHECK(receiver.receiveBatch(recvBatch) == 0);
+}
+
+TEST_CASE("appfw::UdpSocket4 segmented send") {
+    auto test = [](bool gro, size_t segmentSize, size_t size) {
+        appfw::UdpSocket4 receiver, sender;
+        receiver.open(appfw::SockAddr4{appfw::ADDR4_LOOPBACK, 0});
+        sender.open(appfw::SockAddr4{appfw::ADDR4_LOOPBACK, 0});
+
+        if (!receiver.setGroEnabled(gro) && gro) {
+            // Not supported
+            return;
+        }
+
+        std::vector<uint8_t> data(size);
+
+        for (size_t i = 0; i < size; i++) {
+            data[i] = (uint8_t)(i / segmentSize);
+        }
+
+        appfw::UdpBatch4 sendBatch(1, size);
+        REQUIRE(sendBatch.push(receiver.getLocalAddress(), data, (uint16_t)segmentSize));
+        REQUIRE(sender.sendBatch(sendBatch) == 1);
+
+        // Coalesced messages are split back into datagrams
+        size_t expectedCount = (size + segmentSize - 1) / segmentSize;
+        std::vector<size_t> sizes;
+        appfw::UdpBatch4 recvBatch(8, appfw::UdpSocket4::MAX_DATAGRAM_SIZE);
+
+        while (sizes.size() < expectedCount && receiver.poll(1000)) {
+            size_t count = receiver.receiveBatch(recvBatch);
+
+            for (size_t i = 0; i < count; i++) {
+                const appfw::UdpMessage4 &msg = recvBatch.getMessage(i);
+                appfw::span<const uint8_t> buf = recvBatch.getData(i);
+                size_t step = msg.segmentSize != 0 ? msg.segmentSize : msg.size;
+
+                for (size_t pos = 0; pos < buf.size(); pos += step) {
+                    size_t segSize = std::min(step, buf.size() - pos);
+                    CHECK(buf[pos] == sizes.size());
+                    sizes.push_back(segSize);
+                }
+            }
+        }
+
+        REQUIRE(sizes.size() == expectedCount);
+
+        for (size_t i = 0; i < expectedCount; i++) {
+            CHECK(sizes[i] == std::min(segmentSize, size - i * segmentSize));
+        }
+    };
+
+    SUBCASE("GSO, GRO off") {
+        test(false, 100, 350);
+    }
+
+    SUBCASE("GSO, GRO on") {
+        test(true, 100, 350);
+    }
+
+    // Split in software
+    SUBCASE("Too many segments, GRO off") {
+        test(false, 10, 705);
+    }
+
+    SUBCASE("Too many segments, GRO on") {
+        test(true, 10, 705);
+    }
+}
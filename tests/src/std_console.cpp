@@ -0,0 +1,133 @@
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <appfw/console/std_console.h>
+#include <appfw/platform.h>
+#include <doctest/doctest.h>
+
+#if PLATFORM_UNIX
+#include <unistd.h>
+
+namespace {
+
+//! Redirects stdout into a temporary file for the lifetime of the object
+class StdoutCapture {
+public:
+    StdoutCapture() {
+        std::cout.flush();
+        std::fflush(stdout);
+        m_pFile = std::tmpfile();
+        REQUIRE(m_pFile);
+        m_iOldStdout = ::dup(STDOUT_FILENO);
+        REQUIRE(m_iOldStdout >= 0);
+        REQUIRE(::dup2(::fileno(m_pFile), STDOUT_FILENO) >= 0);
+    }
+
+    ~StdoutCapture() {
+        ::dup2(m_iOldStdout, STDOUT_FILENO);
+        ::close(m_iOldStdout);
+        std::fclose(m_pFile);
+    }
+
+    //! @returns everything written since the last call
+    std::string read() {
+        std::string data;
+        char buf[4096];
+        ssize_t size;
+
+        while ((size = ::pread(::fileno(m_pFile), buf, sizeof(buf), m_uReadPos)) > 0) {
+            data.append(buf, (size_t)size);
+            m_uReadPos += (size_t)size;
+        }
+
+        return data;
+    }
+
+private:
+    FILE *m_pFile = nullptr;
+    int m_iOldStdout = -1;
+    size_t m_uReadPos = 0;
+};
+
+} // namespace
+
+TEST_CASE("appfw::StdConsole") {
+    StdoutCapture capture;
+    std::string output;
+
+    {
+        appfw::StdConsole con(appfw::TermInputMethod::Disable);
+        con.setColorsEnabled(false);
+        appfw::ConMsgInfo info;
+
+        SUBCASE("Batching") {
+            // Written immediately until the main loop starts flushing
+            con.print(info, "first");
+            CHECK(capture.read() == "first\n");
+
+            con.flush();
+            con.print(info, "second");
+            con.print(info, "third");
+            CHECK(capture.read().empty());
+
+            con.flush();
+            CHECK(capture.read() == "second\nthird\n");
+
+            // Errors are written immediately with the buffered messages
+            con.print(info, "fourth");
+            con.print(appfw::ConMsgInfo().setType(appfw::ConMsgType::Error), "error");
+            CHECK(capture.read() == "fourth\nerror\n");
+        }
+
+        SUBCASE("Large messages") {
+            con.flush();
+            con.print(info, "small");
+
+            std::string large(200'000, 'x');
+
+            for (size_t i = 0; i < large.size(); i += 1000) {
+                large[i] = (char)('a' + i / 1000 % 26);
+            }
+
+            // Larger than the buffer, written right away
+            con.print(info, large);
+            CHECK(capture.read() == "small\n" + large + "\n");
+        }
+
+        SUBCASE("Colors") {
+            using appfw::ConMsgColor;
+            con.setColorsEnabled(true);
+            con.flush();
+
+            const std::pair<ConMsgColor, const char *> colors[] = {
+                {ConMsgColor::Blue, "34"},         {ConMsgColor::Green, "32"},
+                {ConMsgColor::Cyan, "36"},         {ConMsgColor::Red, "31"},
+                {ConMsgColor::Purple, "35"},       {ConMsgColor::Yellow, "33"},
+                {ConMsgColor::Grey, "37"},         {ConMsgColor::Black, "90"},
+                {ConMsgColor::BrightBlue, "94"},   {ConMsgColor::BrightGreen, "92"},
+                {ConMsgColor::BrightCyan, "96"},   {ConMsgColor::BrightRed, "91"},
+                {ConMsgColor::BrightPurple, "95"}, {ConMsgColor::BrightYellow, "93"},
+                {ConMsgColor::White, "97"},
+            };
+
+            for (auto [color, code] : colors) {
+                CAPTURE(code);
+                con.print(appfw::ConMsgInfo().setColor(color), "msg");
+                con.flush();
+                CHECK(capture.read() == std::string("\x1b[") + code + "mmsg\x1b[0m\n");
+            }
+
+            // Type color is used by default
+            con.print(appfw::ConMsgInfo().setType(appfw::ConMsgType::Error), "error");
+            CHECK(capture.read() == "\x1b[91merror\x1b[0m\n");
+
+            // Disabled colors
+            con.setColorsEnabled(false);
+            con.print(appfw::ConMsgInfo().setColor(ConMsgColor::Red), "plain");
+            con.flush();
+            CHECK(capture.read() == "plain\n");
+        }
+    }
+}
+#endif
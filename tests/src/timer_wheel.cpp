@@ -0,0 +1,118 @@
+#include <vector>
+#include <appfw/timer_wheel.h>
+#include <doctest/doctest.h>
+
+TEST_CASE("appfw::TimerWheel") {
+    appfw::TimerWheel wheel;
+    std::vector<int> fired;
+
+    auto addTimer = [&](int64_t delay, int value) {
+        return wheel.add(delay, [&fired, value]() { fired.push_back(value); });
+    };
+
+    SUBCASE("Empty") {
+        CHECK(wheel.size() == 0);
+        CHECK(wheel.getTimeout(-1) == -1);
+        CHECK(wheel.getTimeout(100) == 100);
+        wheel.advance(1'000'000);
+        CHECK(wheel.getTime() == 1'000'000);
+    }
+
+    SUBCASE("Order of expiration") {
+        addTimer(300, 3);
+        addTimer(5, 1);
+        addTimer(100'000, 4);
+        addTimer(70, 2);
+        CHECK(wheel.size() == 4);
+
+        wheel.advance(4);
+        CHECK(fired.empty());
+
+        wheel.advance(5);
+        CHECK(fired == std::vector<int>{1});
+
+        wheel.advance(99'999);
+        CHECK(fired == std::vector<int>{1, 2, 3});
+
+        wheel.advance(100'000);
+        CHECK(fired == std::vector<int>{1, 2, 3, 4});
+        CHECK(wheel.size() == 0);
+    }
+
+    SUBCASE("Exact expiration after cascading") {
+        // Every delay ends up in a different level
+        std::vector<int64_t> delays = {1, 63, 64, 65, 4095, 4096, 4097, 300'000, 20'000'000};
+
+        for (size_t i = 0; i < delays.size(); i++) {
+            addTimer(delays[i], (int)i);
+        }
+
+        for (size_t i = 0; i < delays.size(); i++) {
+            wheel.advance(delays[i] - 1);
+            CHECK(fired.size() == i);
+            wheel.advance(delays[i]);
+            CHECK(fired.size() == i + 1);
+        }
+    }
+
+    SUBCASE("Timeout") {
+        addTimer(10, 1);
+        CHECK(wheel.getTimeout(-1) == 10);
+        CHECK(wheel.getTimeout(5) == 5);
+
+        // Far timers may wake up earlier to be moved to a lower level
+        wheel.advance(10);
+        addTimer(1000, 2);
+        int timeout = wheel.getTimeout(-1);
+        CHECK(timeout > 0);
+        CHECK(timeout <= 1000);
+
+        while (fired.size() != 2) {
+            wheel.advance(wheel.getTime() + wheel.getTimeout(-1));
+        }
+
+        CHECK(wheel.getTime() == 1010);
+    }
+
+    SUBCASE("Cancel and reschedule") {
+        auto id1 = addTimer(10, 1);
+        auto id2 = addTimer(20, 2);
+        CHECK(wheel.isActive(id1));
+
+        CHECK(wheel.cancel(id1));
+        CHECK(!wheel.isActive(id1));
+        CHECK(!wheel.cancel(id1));
+        CHECK(!wheel.reschedule(id1, 10));
+
+        // Reused entry doesn't match the old id
+        auto id3 = addTimer(30, 3);
+        CHECK(id3 != id1);
+        CHECK(!wheel.isActive(id1));
+
+        wheel.advance(15);
+        CHECK(wheel.reschedule(id2, 100));
+        wheel.advance(50);
+        CHECK(fired == std::vector<int>{3});
+        wheel.advance(115);
+        CHECK(fired == std::vector<int>{3, 2});
+        CHECK(!wheel.isActive(id2));
+        CHECK(!wheel.cancel(appfw::TimerWheel::NULL_TIMER));
+    }
+
+    SUBCASE("Callbacks can modify the wheel") {
+        appfw::TimerWheel::TimerId id2 = appfw::TimerWheel::NULL_TIMER;
+
+        // Timers in the same slot, first cancels the second and adds a new one
+        wheel.add(10, [&]() {
+            fired.push_back(1);
+            wheel.cancel(id2);
+            addTimer(0, 3);
+        });
+        id2 = addTimer(10, 2);
+
+        wheel.advance(10);
+        CHECK(fired == std::vector<int>{1});
+        wheel.advance(11);
+        CHECK(fired == std::vector<int>{1, 3});
+    }
+}
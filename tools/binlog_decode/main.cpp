@@ -0,0 +1,53 @@
+// Prints binary log files in text form: "date time [type] [tag] text"
+#include <cstdio>
+#include <exception>
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+#include <appfw/console/binary_log.h>
+
+static const char *getTypeName(appfw::ConMsgType type) {
+    constexpr const char *names[] = {"wtf", "fatal", "error", "warn",
+                                     "notice", "info", "debug", "input"};
+
+    if ((size_t)type < std::size(names)) {
+        return names[(size_t)type];
+    }
+
+    return "unknown";
+}
+
+static void decodeFile(const char *path) {
+    appfw::BinaryLogReader reader(fs::u8path(path));
+    appfw::BinaryLogReader::Record record;
+
+    while (reader.readRecord(record)) {
+        fmt::print("{:%Y-%m-%d %H:%M:%S} [{}] ", fmt::localtime(record.time),
+                   getTypeName(record.type));
+
+        if (!record.tag.empty()) {
+            fmt::print("[{}] ", record.tag);
+        }
+
+        fmt::print("{}\n", record.text);
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fmt::print(stderr, "Usage: {} <file.blog>...\n", argv[0]);
+        return 1;
+    }
+
+    int result = 0;
+
+    for (int i = 1; i < argc; i++) {
+        try {
+            decodeFile(argv[i]);
+        } catch (const std::exception &e) {
+            fmt::print(stderr, "{}\n", e.what());
+            result = 1;
+        }
+    }
+
+    return result;
+}